@@ -0,0 +1,73 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Fixed-size worker pool with a FIFO task queue
+ *
+ * Replaces detaching a new thread per unit of work: the workers are created
+ * once and shutdown() runs every queued task before joining them, so no task
+ * outlives the object that owns the executor.
+ */
+class Executor {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Constructor, starts the workers
+     * @param workers Number of worker threads (at least 1)
+     * @param name Name used in log messages
+     */
+    explicit Executor(size_t workers, const std::string& name = "executor");
+
+    /**
+     * @brief Destructor, equivalent to shutdown()
+     */
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /**
+     * @brief Queue a task; exceptions it throws are logged and swallowed
+     * @param task Work to run on a worker thread
+     * @return false if the executor is shutting down and the task was not queued
+     */
+    bool submit(Task task);
+
+    /**
+     * @brief Stop accepting tasks, run the queued ones and join the workers
+     *
+     * Must be called by the owner; called from one of the executor's own tasks
+     * it logs an error and does nothing.
+     */
+    void shutdown();
+
+    size_t workerCount() const { return workers_.size(); }
+
+    /**
+     * @brief Number of tasks waiting for a worker
+     */
+    size_t pending() const;
+
+private:
+    std::string name_;
+    std::vector<std::thread> workers_;
+    std::deque<Task> tasks_;
+    mutable std::mutex mutex_;
+    std::condition_variable task_ready_;
+    bool accepting_ = true;
+
+    void workerLoop();
+};
+
+} // namespace thermal
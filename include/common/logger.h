@@ -1,8 +1,17 @@
 #pragma once
 
+#include "common/bounded_queue.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <iosfwd>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 namespace thermal {
 
@@ -17,104 +26,268 @@ enum class LogLevel {
 };
 
 /**
- * @brief Simple logging interface
+ * @brief Asynchronous logging interface
+ *
+ * Callers only check an atomic level and push the message into a lock-free
+ * ring buffer; a background writer thread adds the timestamp, batch-writes
+ * to the console and/or file and rotates the file. Messages that find the
+ * buffer full are dropped and reported as a count by the writer.
  */
 class Logger {
 public:
+    // Ring buffer size in messages
+    static constexpr size_t QUEUE_CAPACITY = 4096;
+
+    // File rotation defaults
+    static constexpr size_t DEFAULT_MAX_FILE_BYTES = 10 * 1024 * 1024;
+    static constexpr size_t DEFAULT_MAX_FILES = 3;
+
     /**
      * @brief Initialize the logger with configuration
      * @param level Minimum log level to output
      * @param output Output destination ("console", "file", "both")
      * @param log_file File path for file output (ignored if output != "file" or "both")
+     * @param max_file_bytes Rotate the file once it would exceed this size (0 = never)
+     * @param max_files Rotated files kept as log_file.1 ... log_file.N
      */
-    static void initialize(LogLevel level, const std::string& output, const std::string& log_file = "");
-    
+    static void initialize(LogLevel level, const std::string& output, const std::string& log_file = "",
+                           size_t max_file_bytes = DEFAULT_MAX_FILE_BYTES,
+                           size_t max_files = DEFAULT_MAX_FILES);
+
     /**
      * @brief Get the singleton logger instance
+     *
+     * Never destroyed, so logging stays valid during static destruction;
+     * the writer thread is stopped at exit and later messages are written inline.
      * @return Logger instance
      */
     static Logger& instance();
-    
+
+    /**
+     * @brief Parse a configuration level name ("debug", "info", "warn", "error")
+     * @throws std::invalid_argument if the name is unknown
+     */
+    static LogLevel level_from_string(const std::string& level);
+
     /**
      * @brief Log a debug message
      * @param message The message to log
      */
-    void debug(const std::string& message);
-    
+    void debug(std::string message);
+
     /**
      * @brief Log an info message
      * @param message The message to log
      */
-    void info(const std::string& message);
-    
+    void info(std::string message);
+
     /**
      * @brief Log a warning message
      * @param message The message to log
      */
-    void warn(const std::string& message);
-    
+    void warn(std::string message);
+
     /**
      * @brief Log an error message
      * @param message The message to log
      */
-    void error(const std::string& message);
-    
+    void error(std::string message);
+
+    /**
+     * @brief Log a message at the given level
+     * @param level Severity of the message
+     * @param message The message to log
+     */
+    void log(LogLevel level, std::string message);
+
     /**
      * @brief Check if a log level is enabled
      * @param level The log level to check
      * @return true if the level is enabled
      */
-    bool is_enabled(LogLevel level) const;
-    
+    bool is_enabled(LogLevel level) const {
+        return static_cast<int>(level) >= min_level_.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Set the minimum log level
      * @param level New minimum log level
      */
     void set_level(LogLevel level);
 
+    /**
+     * @brief Wait until every message logged so far has been written
+     */
+    void flush();
+
+    /**
+     * @brief Write what is queued and stop the writer thread
+     */
+    void shutdown();
+
+    /**
+     * @brief Number of messages dropped because the buffer was full
+     */
+    std::uint64_t get_dropped_count() const { return dropped_; }
+
 private:
-    Logger() = default;
-    
-    void log(LogLevel level, const std::string& message);
-    std::string format_message(LogLevel level, const std::string& message) const;
+    struct Record {
+        LogLevel level = LogLevel::INFO;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+    };
+
+    Logger();
+
+    void run();
+    void write_record(const Record& record);
+    void write_line(LogLevel level, const std::string& line);
+    void flush_sinks();
+    void rotate_file();
+    void format_timestamp(std::chrono::system_clock::time_point time, std::string& out);
     std::string level_to_string(LogLevel level) const;
-    std::string get_timestamp() const;
-    
-    LogLevel min_level_ = LogLevel::INFO;
+
+    std::atomic<int> min_level_{static_cast<int>(LogLevel::INFO)};
+    BoundedQueue<Record> queue_;
+    std::atomic<std::uint64_t> pushed_{0};
+    std::atomic<std::uint64_t> processed_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::uint64_t reported_dropped_ = 0;
+
+    // Sinks; written by the writer thread, or inline once it has stopped
+    std::mutex sink_mutex_;
     std::string output_mode_ = "console";
     std::string log_file_path_;
-    std::shared_ptr<std::ofstream> file_stream_;
+    size_t max_file_bytes_ = DEFAULT_MAX_FILE_BYTES;
+    size_t max_files_ = DEFAULT_MAX_FILES;
+    std::unique_ptr<std::ofstream> file_stream_;
+    size_t file_bytes_ = 0;
+    std::string line_;
+
+    // Timestamp text is reused while the second does not change
+    std::time_t cached_second_ = -1;
+    std::string cached_timestamp_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable data_ready_;
+    std::condition_variable drained_;
+    std::atomic<bool> writer_idle_{false};
+    std::atomic<bool> running_{true};
+    std::thread writer_;
+};
+
+/**
+ * @brief Per-call-site state of the rate-limited logging macros
+ *
+ * One static instance lives at each LOG_*_EVERY_N, LOG_*_EVERY_MS and
+ * LOG_*_FIRST_N call site. Each check is a few relaxed atomic operations.
+ * A message that passes reports how many were suppressed since the last one.
+ */
+class LogRateLimit {
+public:
+    // After the first N, one summary line is let through at most this often
+    static constexpr std::int64_t FIRST_N_SUMMARY_INTERVAL_MS = 60000;
+
+    /**
+     * @brief Pass the 1st, (n+1)th, (2n+1)th ... occurrence
+     * @param n Period in occurrences
+     * @param suppressed Set to the occurrences skipped since the last pass
+     */
+    bool every_n(std::uint64_t n, std::uint64_t& suppressed);
+
+    /**
+     * @brief Pass at most one occurrence per interval
+     * @param interval_ms Minimum time between passes
+     * @param suppressed Set to the occurrences skipped since the last pass
+     */
+    bool every_ms(std::int64_t interval_ms, std::uint64_t& suppressed);
+
+    /**
+     * @brief Pass the first n occurrences, then one summary per FIRST_N_SUMMARY_INTERVAL_MS
+     * @param n Occurrences passed before suppression starts
+     * @param suppressed Set to the occurrences skipped since the last pass
+     */
+    bool first_n(std::uint64_t n, std::uint64_t& suppressed);
+
+private:
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> suppressed_{0};
+    std::atomic<std::int64_t> next_pass_ms_{0};
+
+    bool pass(std::uint64_t& suppressed);
 };
 
 /**
  * @brief Convenient logging macros
  */
 #define LOG_DEBUG(msg) do { \
-    if (::thermal::Logger::instance().is_enabled(::thermal::LogLevel::DEBUG)) { \
-        std::stringstream ss; ss << msg; \
-        ::thermal::Logger::instance().debug(ss.str()); \
+    ::thermal::Logger& thermal_logger_ = ::thermal::Logger::instance(); \
+    if (thermal_logger_.is_enabled(::thermal::LogLevel::DEBUG)) { \
+        std::ostringstream ss; ss << msg; \
+        thermal_logger_.debug(ss.str()); \
     } \
 } while(0)
 
 #define LOG_INFO(msg) do { \
-    if (::thermal::Logger::instance().is_enabled(::thermal::LogLevel::INFO)) { \
-        std::stringstream ss; ss << msg; \
-        ::thermal::Logger::instance().info(ss.str()); \
+    ::thermal::Logger& thermal_logger_ = ::thermal::Logger::instance(); \
+    if (thermal_logger_.is_enabled(::thermal::LogLevel::INFO)) { \
+        std::ostringstream ss; ss << msg; \
+        thermal_logger_.info(ss.str()); \
     } \
 } while(0)
 
 #define LOG_WARN(msg) do { \
-    if (::thermal::Logger::instance().is_enabled(::thermal::LogLevel::WARN)) { \
-        std::stringstream ss; ss << msg; \
-        ::thermal::Logger::instance().warn(ss.str()); \
+    ::thermal::Logger& thermal_logger_ = ::thermal::Logger::instance(); \
+    if (thermal_logger_.is_enabled(::thermal::LogLevel::WARN)) { \
+        std::ostringstream ss; ss << msg; \
+        thermal_logger_.warn(ss.str()); \
     } \
 } while(0)
 
 #define LOG_ERROR(msg) do { \
-    if (::thermal::Logger::instance().is_enabled(::thermal::LogLevel::ERROR)) { \
-        std::stringstream ss; ss << msg; \
-        ::thermal::Logger::instance().error(ss.str()); \
+    ::thermal::Logger& thermal_logger_ = ::thermal::Logger::instance(); \
+    if (thermal_logger_.is_enabled(::thermal::LogLevel::ERROR)) { \
+        std::ostringstream ss; ss << msg; \
+        thermal_logger_.error(ss.str()); \
+    } \
+} while(0)
+
+// Shared body of the rate-limited macros; the suppressed count is appended to the message
+#define THERMAL_LOG_RATE_LIMITED(level, check, limit, msg) do { \
+    static ::thermal::LogRateLimit thermal_log_site_; \
+    ::thermal::Logger& thermal_logger_ = ::thermal::Logger::instance(); \
+    std::uint64_t thermal_log_suppressed_ = 0; \
+    if (thermal_logger_.is_enabled(level) && thermal_log_site_.check(limit, thermal_log_suppressed_)) { \
+        std::ostringstream ss; ss << msg; \
+        if (thermal_log_suppressed_ > 0) { \
+            ss << " [" << thermal_log_suppressed_ << " similar messages suppressed]"; \
+        } \
+        thermal_logger_.log(level, ss.str()); \
     } \
 } while(0)
 
-} // namespace thermal
\ No newline at end of file
+/**
+ * @brief Log every n-th occurrence of this call site
+ */
+#define LOG_DEBUG_EVERY_N(n, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::DEBUG, every_n, n, msg)
+#define LOG_INFO_EVERY_N(n, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::INFO, every_n, n, msg)
+#define LOG_WARN_EVERY_N(n, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::WARN, every_n, n, msg)
+#define LOG_ERROR_EVERY_N(n, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::ERROR, every_n, n, msg)
+
+/**
+ * @brief Log this call site at most once per interval_ms
+ */
+#define LOG_DEBUG_EVERY_MS(interval_ms, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::DEBUG, every_ms, interval_ms, msg)
+#define LOG_INFO_EVERY_MS(interval_ms, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::INFO, every_ms, interval_ms, msg)
+#define LOG_WARN_EVERY_MS(interval_ms, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::WARN, every_ms, interval_ms, msg)
+#define LOG_ERROR_EVERY_MS(interval_ms, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::ERROR, every_ms, interval_ms, msg)
+
+/**
+ * @brief Log the first n occurrences of this call site, then periodic summaries
+ */
+#define LOG_DEBUG_FIRST_N(n, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::DEBUG, first_n, n, msg)
+#define LOG_INFO_FIRST_N(n, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::INFO, first_n, n, msg)
+#define LOG_WARN_FIRST_N(n, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::WARN, first_n, n, msg)
+#define LOG_ERROR_FIRST_N(n, msg) THERMAL_LOG_RATE_LIMITED(::thermal::LogLevel::ERROR, first_n, n, msg)
+
+} // namespace thermal
@@ -0,0 +1,238 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Metric labels, e.g. {{"method", "moveSpotMeasurement"}}
+ */
+using MetricLabels = std::map<std::string, std::string>;
+
+/**
+ * @brief Monotonic event counter
+ */
+class Counter {
+public:
+    void increment(std::uint64_t amount = 1) { value_.fetch_add(amount, std::memory_order_relaxed); }
+    std::uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+    void reset() { value_.store(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> value_{0};
+};
+
+/**
+ * @brief Instantaneous value such as a queue depth
+ */
+class Gauge {
+public:
+    void set(std::int64_t value) { value_.store(value, std::memory_order_relaxed); }
+    void add(std::int64_t amount) { value_.fetch_add(amount, std::memory_order_relaxed); }
+    std::int64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::int64_t> value_{0};
+};
+
+/**
+ * @brief Point-in-time copy of a histogram
+ */
+struct HistogramSnapshot {
+    struct Bucket {
+        std::uint64_t upper_bound;  // Largest value counted in the bucket
+        std::uint64_t count;
+    };
+
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t min = 0;
+    std::uint64_t max = 0;
+    std::vector<Bucket> buckets;  // Non-empty buckets in ascending order
+
+    /**
+     * @brief Estimate a quantile (within the histogram's relative precision)
+     * @param quantile Quantile from 0.0 to 1.0
+     * @return Upper bound of the bucket holding the quantile, or 0 if empty
+     */
+    std::uint64_t percentile(double quantile) const;
+
+    double mean() const { return count > 0 ? static_cast<double>(sum) / count : 0.0; }
+};
+
+/**
+ * @brief Log-linear (HDR-style) histogram of non-negative integer values
+ *
+ * Each power of two is split into SUB_BUCKETS linear buckets, so every
+ * recorded value is kept with a relative error below 1 / SUB_BUCKETS over
+ * the whole range, in a fixed array of atomic counters. Recording is lock-free.
+ * Values at or above 2^MAX_EXPONENT are counted in the last bucket.
+ */
+class Histogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 4;
+    static constexpr std::uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;
+    static constexpr unsigned MAX_EXPONENT = 40;
+    static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    /**
+     * @brief Record one value
+     */
+    void record(std::uint64_t value);
+
+    /**
+     * @brief Record a duration in microseconds
+     */
+    template <typename Rep, typename Period>
+    void recordDuration(std::chrono::duration<Rep, Period> duration) {
+        auto us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        record(us > 0 ? static_cast<std::uint64_t>(us) : 0);
+    }
+
+    HistogramSnapshot snapshot() const;
+    void reset();
+
+    /**
+     * @brief Bucket index of a value
+     */
+    static size_t bucketIndex(std::uint64_t value);
+
+    /**
+     * @brief Largest value that falls into a bucket
+     */
+    static std::uint64_t bucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> min_{UINT64_MAX};
+    std::atomic<std::uint64_t> max_{0};
+};
+
+/**
+ * @brief Kind of a registered metric
+ */
+enum class MetricType {
+    COUNTER,
+    GAUGE,
+    HISTOGRAM
+};
+
+/**
+ * @brief Point-in-time copy of one metric
+ */
+struct MetricSnapshot {
+    std::string name;
+    MetricLabels labels;
+    std::string help;
+    MetricType type = MetricType::COUNTER;
+    std::int64_t value = 0;       // Counter or gauge value
+    HistogramSnapshot histogram;  // Histogram contents
+};
+
+/**
+ * @brief Snapshot of a counter or gauge kept outside the registry
+ */
+MetricSnapshot makeMetricSnapshot(MetricType type, const std::string& name, const std::string& help,
+                                  std::int64_t value, const MetricLabels& labels = {});
+
+/**
+ * @brief Process-wide registry of named metrics
+ *
+ * Lookups take a lock, so instrumented code looks its metrics up once and
+ * keeps the returned reference; references stay valid for the life of the
+ * process. Updating a metric is a relaxed atomic operation.
+ * Durations are recorded in microseconds and named "..._microseconds".
+ */
+class MetricsRegistry {
+public:
+    /**
+     * @brief Get the process-wide registry
+     */
+    static MetricsRegistry& instance();
+
+    /**
+     * @brief Get or create a counter
+     * @param name Metric name
+     * @param help One-line description (the first non-empty one is kept)
+     * @param labels Labels distinguishing this series
+     * @throws std::invalid_argument if the name is registered with another type
+     */
+    Counter& counter(const std::string& name, const std::string& help = "", const MetricLabels& labels = {});
+
+    /**
+     * @brief Get or create a gauge
+     */
+    Gauge& gauge(const std::string& name, const std::string& help = "", const MetricLabels& labels = {});
+
+    /**
+     * @brief Get or create a histogram
+     */
+    Histogram& histogram(const std::string& name, const std::string& help = "", const MetricLabels& labels = {});
+
+    /**
+     * @brief Copy every metric, ordered by name and labels
+     */
+    std::vector<MetricSnapshot> snapshot() const;
+
+    /**
+     * @brief Log count, median, tail and worst case of every histogram with samples
+     */
+    void logSummary() const;
+
+    /**
+     * @brief Zero counters and histograms; gauges keep their current value
+     */
+    void reset();
+
+private:
+    // Type and help are shared by every series of a name
+    struct Family {
+        MetricType type;
+        std::string help;
+    };
+
+    struct Entry {
+        std::string name;
+        MetricLabels labels;
+        MetricType type;
+        std::unique_ptr<Counter> counter;
+        std::unique_ptr<Gauge> gauge;
+        std::unique_ptr<Histogram> histogram;
+    };
+
+    Entry& getOrCreate(const std::string& name, const std::string& help, const MetricLabels& labels,
+                       MetricType type);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;  // Keyed by name
+    std::map<std::string, Entry> entries_;    // Keyed by name and serialized labels
+};
+
+/**
+ * @brief Records the time from construction to destruction into a histogram
+ */
+class ScopedLatency {
+public:
+    explicit ScopedLatency(Histogram& histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedLatency() { histogram_.recordDuration(std::chrono::steady_clock::now() - start_); }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace thermal
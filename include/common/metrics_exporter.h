@@ -0,0 +1,108 @@
+#pragma once
+
+#include "common/metrics.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Render metrics in the Prometheus text exposition format (0.0.4)
+ *
+ * Series are grouped by name with one HELP and TYPE line each. Histograms
+ * get cumulative buckets at the power-of-two boundaries le="2^k-1", which
+ * the log-linear buckets count exactly, up to the first boundary above max.
+ * @param metrics Metrics in any order
+ */
+std::string formatPrometheusText(std::vector<MetricSnapshot> metrics);
+
+/**
+ * @brief Exposes the metrics registry to a local Prometheus scraper
+ *
+ * Either serves GET /metrics over a minimal HTTP/1.0 listener or rewrites
+ * a node_exporter textfile-collector file (write to a temporary file, then
+ * rename) at a fixed interval. Both run on one background thread.
+ */
+class MetricsExporter {
+public:
+    /**
+     * @brief Adds metrics kept outside the registry; runs on the exporter thread
+     */
+    using Collector = std::function<void(std::vector<MetricSnapshot>& metrics)>;
+
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{200};
+    static constexpr std::chrono::milliseconds REQUEST_TIMEOUT{2000};
+    static constexpr size_t MAX_REQUEST_BYTES = 8192;
+
+    /**
+     * @brief Constructor
+     * @param collector Called for every scrape or write (optional)
+     */
+    explicit MetricsExporter(Collector collector = nullptr);
+
+    /**
+     * @brief Destructor, equivalent to stop()
+     */
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    /**
+     * @brief Serve GET /metrics on a background thread
+     * @param address IPv4 address to listen on, normally 127.0.0.1
+     * @param port TCP port (0 picks a free one, see port())
+     * @throws std::runtime_error if already started or the socket cannot be bound
+     */
+    void serveHttp(const std::string& address, int port);
+
+    /**
+     * @brief Rewrite a textfile-collector file on a background thread
+     * @param path Output file; node_exporter only reads names ending in .prom
+     * @param interval Time between writes
+     * @throws std::runtime_error if already started
+     */
+    void writeTextfile(const std::string& path, std::chrono::milliseconds interval);
+
+    /**
+     * @brief Stop the background thread (the textfile is written a last time)
+     */
+    void stop();
+
+    /**
+     * @brief Current registry and collector metrics in text format
+     */
+    std::string render() const;
+
+    /**
+     * @brief Atomically replace a file with the current metrics
+     * @return true if the file was written
+     */
+    bool writeTextfileOnce(const std::string& path) const;
+
+    /**
+     * @brief Port the HTTP listener is bound to (0 if not serving)
+     */
+    int port() const { return port_; }
+
+private:
+    Collector collector_;
+    int listen_fd_ = -1;
+    int port_ = 0;
+    std::mutex mutex_;
+    std::condition_variable stop_requested_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+
+    void serveLoop();
+    void handleConnection(int fd);
+    void textfileLoop(std::string path, std::chrono::milliseconds interval);
+};
+
+} // namespace thermal
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define THERMAL_SIMD_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define THERMAL_SIMD_NEON 1
+#endif
+
+namespace thermal {
+namespace simd {
+
+/**
+ * @brief Minimal 4-lane float vector used by the thermal analytics kernels
+ * 
+ * Maps to SSE2 on x86-64 and NEON on AArch64; other targets get a portable
+ * scalar fallback with identical results.
+ */
+struct f32x4 {
+#if defined(THERMAL_SIMD_SSE2)
+    __m128 v;
+#elif defined(THERMAL_SIMD_NEON)
+    float32x4_t v;
+#else
+    float v[4];
+#endif
+};
+
+constexpr int LANES = 4;
+
+#if defined(THERMAL_SIMD_SSE2)
+
+inline f32x4 load(const float* p) { return {_mm_loadu_ps(p)}; }
+inline void store(float* p, f32x4 a) { _mm_storeu_ps(p, a.v); }
+inline f32x4 set1(float s) { return {_mm_set1_ps(s)}; }
+inline f32x4 add(f32x4 a, f32x4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline f32x4 sub(f32x4 a, f32x4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline f32x4 mul(f32x4 a, f32x4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline f32x4 min(f32x4 a, f32x4 b) { return {_mm_min_ps(a.v, b.v)}; }
+inline f32x4 max(f32x4 a, f32x4 b) { return {_mm_max_ps(a.v, b.v)}; }
+inline f32x4 sqrt(f32x4 a) { return {_mm_sqrt_ps(a.v)}; }
+
+#elif defined(THERMAL_SIMD_NEON)
+
+inline f32x4 load(const float* p) { return {vld1q_f32(p)}; }
+inline void store(float* p, f32x4 a) { vst1q_f32(p, a.v); }
+inline f32x4 set1(float s) { return {vdupq_n_f32(s)}; }
+inline f32x4 add(f32x4 a, f32x4 b) { return {vaddq_f32(a.v, b.v)}; }
+inline f32x4 sub(f32x4 a, f32x4 b) { return {vsubq_f32(a.v, b.v)}; }
+inline f32x4 mul(f32x4 a, f32x4 b) { return {vmulq_f32(a.v, b.v)}; }
+inline f32x4 min(f32x4 a, f32x4 b) { return {vminq_f32(a.v, b.v)}; }
+inline f32x4 max(f32x4 a, f32x4 b) { return {vmaxq_f32(a.v, b.v)}; }
+inline f32x4 sqrt(f32x4 a) { return {vsqrtq_f32(a.v)}; }
+
+#else
+
+inline f32x4 load(const float* p) { return {{p[0], p[1], p[2], p[3]}}; }
+inline void store(float* p, f32x4 a) { for (int i = 0; i < LANES; ++i) p[i] = a.v[i]; }
+inline f32x4 set1(float s) { return {{s, s, s, s}}; }
+inline f32x4 add(f32x4 a, f32x4 b) { for (int i = 0; i < LANES; ++i) a.v[i] += b.v[i]; return a; }
+inline f32x4 sub(f32x4 a, f32x4 b) { for (int i = 0; i < LANES; ++i) a.v[i] -= b.v[i]; return a; }
+inline f32x4 mul(f32x4 a, f32x4 b) { for (int i = 0; i < LANES; ++i) a.v[i] *= b.v[i]; return a; }
+inline f32x4 min(f32x4 a, f32x4 b) { for (int i = 0; i < LANES; ++i) a.v[i] = std::min(a.v[i], b.v[i]); return a; }
+inline f32x4 max(f32x4 a, f32x4 b) { for (int i = 0; i < LANES; ++i) a.v[i] = std::max(a.v[i], b.v[i]); return a; }
+inline f32x4 sqrt(f32x4 a) { for (int i = 0; i < LANES; ++i) a.v[i] = std::sqrt(a.v[i]); return a; }
+
+#endif
+
+/**
+ * @brief Horizontal minimum of all lanes
+ */
+inline float reduceMin(f32x4 a) {
+    float lanes[LANES];
+    store(lanes, a);
+    return std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+}
+
+/**
+ * @brief Horizontal maximum of all lanes
+ */
+inline float reduceMax(f32x4 a) {
+    float lanes[LANES];
+    store(lanes, a);
+    return std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+}
+
+/**
+ * @brief Minimum and maximum of a contiguous run of floats
+ * @param p First element
+ * @param n Number of elements (must be at least 1)
+ * @param out_min Receives the minimum
+ * @param out_max Receives the maximum
+ */
+inline void minMax(const float* p, size_t n, float& out_min, float& out_max) {
+    size_t i = 0;
+    float lo = p[0];
+    float hi = p[0];
+
+    if (n >= static_cast<size_t>(LANES)) {
+        f32x4 vmin = load(p);
+        f32x4 vmax = vmin;
+        for (i = LANES; i + LANES <= n; i += LANES) {
+            f32x4 v = load(p + i);
+            vmin = min(vmin, v);
+            vmax = max(vmax, v);
+        }
+        lo = reduceMin(vmin);
+        hi = reduceMax(vmax);
+    }
+
+    for (; i < n; ++i) {
+        lo = std::min(lo, p[i]);
+        hi = std::max(hi, p[i]);
+    }
+
+    out_min = lo;
+    out_max = hi;
+}
+
+} // namespace simd
+} // namespace thermal
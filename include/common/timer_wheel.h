@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Hashed timer wheel for many short deadlines
+ *
+ * Scheduling and expiry are O(1) per timer regardless of how many are armed.
+ * Deadlines are rounded up to the next tick, so a timer never fires early.
+ * There is no cancel: owners ignore expiries of timers that no longer matter.
+ * Not thread-safe; the caller serializes access.
+ */
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Constructor
+     * @param tick Wheel resolution (at least 1 ms)
+     * @param slots Number of slots; deadlines further than tick * slots take extra rounds
+     * @param start Time of tick zero
+     */
+    TimerWheel(std::chrono::milliseconds tick, size_t slots, Clock::time_point start = Clock::now());
+
+    /**
+     * @brief Arm a timer
+     * @param id Caller's identifier, returned on expiry
+     * @param deadline Time at or after which the timer expires
+     */
+    void schedule(std::uint64_t id, Clock::time_point deadline);
+
+    /**
+     * @brief Advance the wheel and collect expired timers
+     * @param now Current time
+     * @param expired Appended with the IDs of expired timers
+     * @return Number of timers that expired
+     */
+    size_t advance(Clock::time_point now, std::vector<std::uint64_t>& expired);
+
+    /**
+     * @brief Number of armed timers
+     */
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    std::chrono::milliseconds tick() const { return tick_; }
+
+private:
+    struct Timer {
+        std::uint64_t id;
+        std::uint64_t rounds;  // Full turns left before the timer is due
+    };
+
+    std::chrono::milliseconds tick_;
+    Clock::time_point start_;
+    std::vector<std::vector<Timer>> slots_;
+    std::uint64_t current_tick_ = 0;  // Last tick processed
+    size_t size_ = 0;
+};
+
+} // namespace thermal
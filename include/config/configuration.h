@@ -7,8 +7,9 @@
 
 namespace thermal {
 
-// Forward declaration for MeasurementSpot
+// Forward declarations for MeasurementSpot and MeasurementArea
 struct MeasurementSpot;
+struct MeasurementArea;
 
 /**
  * @brief ThingsBoard-specific connection and authentication parameters
@@ -21,6 +22,11 @@ struct ThingsBoardConfig {
     bool use_ssl = false;
     int keep_alive_seconds = 60;
     int qos_level = 1;
+    size_t rpc_max_queue_depth = 64;         // RPC commands waiting for a worker before CAMERA_BUSY
+    size_t rpc_max_pending_per_method = 16;  // Queued or running commands per RPC method
+    double rpc_rate_limit_per_second = 20.0; // Sustained RPC admission rate (0 = unlimited)
+    double rpc_rate_burst = 40.0;            // RPC commands admitted at once after idling
+    std::string payload_format = "json";     // Telemetry and RPC responses: json or protobuf
 
     bool validate() const;
     void from_json(const nlohmann::json& json_data);
@@ -33,9 +39,21 @@ struct ThingsBoardConfig {
 struct TelemetryConfig {
     int interval_seconds = 15;
     std::vector<MeasurementSpot> measurement_spots;
-    bool batch_transmission = false;  // Send individual messages per clarification
+    std::vector<MeasurementArea> measurement_areas;  // Box/polygon regions reported as a whole
+    bool batch_transmission = false;  // Send all spots of a sampling instant in one message
     int retry_attempts = 3;
     int retry_delay_ms = 1000;
+    int sample_interval_ms = 0;       // Sampling period in windowed mode (0 = interval_seconds)
+    int upload_window_seconds = 0;    // Accumulate samples and upload once per window (0 = off)
+    size_t max_upload_bytes = 65536;  // Largest JSON array sent in one windowed upload
+    double deadband_celsius = 0.0;    // Publish only on changes above this (°C, 0 = off)
+    double deadband_percent = 0.0;    // Publish only on changes above this (% of last sent, 0 = off)
+    int heartbeat_seconds = 0;        // Republish unchanged readings after this long (0 = never)
+    std::string journal_directory;    // Store-and-forward journal location (empty = off)
+    size_t journal_max_bytes = 64 * 1024 * 1024;  // Disk budget of the journal
+    double backfill_messages_per_second = 5.0;    // Journal replay rate after reconnect
+    size_t publish_queue_capacity = 0;            // Publisher thread queue size (0 = publish inline)
+    std::string publish_overflow_policy = "drop_oldest";  // drop_oldest, drop_newest, block
 
     bool validate() const;
     void from_json(const nlohmann::json& json_data);
@@ -49,6 +67,37 @@ struct LoggingConfig {
     std::string level = "info";  // debug, info, warn, error
     std::string output = "console";  // console, file, both
     std::string log_file = "thermal-mqtt.log";
+    size_t max_file_bytes = 10 * 1024 * 1024;  // Rotate the log file beyond this size (0 = never)
+    size_t max_files = 3;                      // Rotated log files kept
+
+    bool validate() const;
+    void from_json(const nlohmann::json& json_data);
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Prometheus metrics export
+ */
+struct MetricsConfig {
+    std::string mode = "off";                 // off, http, textfile
+    std::string listen_address = "127.0.0.1"; // HTTP listener address
+    int port = 9464;                          // HTTP listener port
+    std::string textfile_path;                // node_exporter textfile, must end in .prom
+    int interval_seconds = 15;                // Textfile rewrite period
+
+    bool validate() const;
+    void from_json(const nlohmann::json& json_data);
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Temperature source selection
+ */
+struct SourceConfig {
+    std::string type = "frame_based";  // coordinate_based, frame_based, file_replay
+    std::string replay_file;           // Raw frame recording replayed by file_replay
+    double replay_fps = 0.0;           // Replay frames per second (0 = one frame per capture)
+    bool replay_loop = true;           // Restart the recording after its last frame
 
     bool validate() const;
     void from_json(const nlohmann::json& json_data);
@@ -62,6 +111,8 @@ struct Configuration {
     ThingsBoardConfig thingsboard_config;
     TelemetryConfig telemetry_config;
     LoggingConfig logging_config;
+    MetricsConfig metrics_config;
+    SourceConfig source_config;
 
     /**
      * @brief Load configuration from JSON file
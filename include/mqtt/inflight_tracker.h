@@ -0,0 +1,132 @@
+#pragma once
+
+#include "common/metrics.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace thermal {
+
+/**
+ * @brief Final outcome of a QoS > 0 publish
+ */
+enum class DeliveryResult {
+    DELIVERED,        // Acknowledged by the broker
+    FAILED,           // Paho reported the publish as failed
+    CONNECTION_LOST   // Connection closed before the acknowledgement
+};
+
+/**
+ * @brief Completion callback of a publish; runs on a Paho thread
+ */
+using DeliveryCallback = std::function<void(DeliveryResult result)>;
+
+/**
+ * @brief Counters and backlog of the in-flight tracker
+ */
+struct InFlightStats {
+    size_t in_flight = 0;                      // Handed to Paho, not yet acknowledged
+    std::chrono::microseconds oldest_age{0};   // Age of the oldest unacknowledged publish
+    std::uint64_t delivered = 0;
+    std::uint64_t failed = 0;
+    std::uint64_t connection_lost = 0;
+};
+
+/**
+ * @brief Tracks QoS > 0 publishes by Paho token until the broker acknowledges them
+ *
+ * Records delivery latency per topic class and runs the publisher's
+ * completion callback once with the outcome. Paho can report a delivery
+ * before MQTTAsync_sendMessage has returned the token to us, so outcomes
+ * for unknown tokens are parked until track() claims them.
+ */
+class InFlightTracker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t DEFAULT_MAX_TRACKED = 4096;
+
+    /**
+     * @brief Constructor
+     * @param max_tracked Publishes tracked at once; further ones go untracked
+     */
+    explicit InFlightTracker(size_t max_tracked = DEFAULT_MAX_TRACKED);
+
+    /**
+     * @brief Start tracking a publish Paho accepted
+     * @param token Token Paho assigned to the message
+     * @param topic Topic it was published to
+     * @param sent_at Time the publish was handed to Paho
+     * @param on_complete Called once with the outcome (optional)
+     * @return false if the tracker is full; the callback is then never called
+     */
+    bool track(int token, const std::string& topic, Clock::time_point sent_at,
+               DeliveryCallback on_complete = nullptr);
+
+    /**
+     * @brief Record the outcome Paho reported for a token
+     */
+    void complete(int token, DeliveryResult result);
+
+    /**
+     * @brief Complete every tracked publish with CONNECTION_LOST
+     */
+    void failAll();
+
+    /**
+     * @brief Forget every tracked publish without calling the callbacks
+     *
+     * Waits for callbacks complete() or failAll() are already running, so
+     * none of them runs after clear() returns.
+     */
+    void clear();
+
+    InFlightStats getStats() const;
+
+    /**
+     * @brief Coarse ThingsBoard topic class used as the latency label
+     * @return "telemetry", "attributes", "rpc_response" or "other"
+     */
+    static std::string topicClass(const std::string& topic);
+
+private:
+    struct Entry {
+        Clock::time_point sent_at;
+        Histogram* latency;
+        DeliveryCallback on_complete;
+    };
+
+    struct EarlyOutcome {
+        Clock::time_point at;
+        DeliveryResult result;
+    };
+
+    size_t max_tracked_;
+    std::mutex completion_mutex_;  // Held while complete()/failAll() run callbacks; taken before mutex_
+    mutable std::mutex mutex_;
+    std::unordered_map<int, Entry> pending_;
+    std::unordered_map<int, EarlyOutcome> early_;
+    std::map<std::string, Histogram*> latency_;  // Per topic class
+
+    std::uint64_t delivered_ = 0;
+    std::uint64_t failed_ = 0;
+    std::uint64_t connection_lost_ = 0;
+
+    // Metrics, owned by MetricsRegistry
+    Gauge& in_flight_gauge_;
+    Counter& delivered_total_;
+    Counter& failed_total_;
+    Counter& connection_lost_total_;
+
+    /**
+     * @brief Account for one outcome; caller holds mutex_
+     */
+    void finishLocked(const Entry& entry, DeliveryResult result, Clock::time_point at);
+    Histogram& latencyLocked(const std::string& topic_class);
+};
+
+} // namespace thermal
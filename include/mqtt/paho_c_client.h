@@ -1,10 +1,16 @@
 #pragma once
 
+#include "common/metrics.h"
+#include "mqtt/inflight_tracker.h"
 #include <MQTTAsync.h>
+#include <atomic>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <mutex>
 
 namespace thermal {
 
@@ -21,21 +27,23 @@ enum class MQTTConnectionState {
 
 /**
  * @brief MQTT client statistics
+ *
+ * State, counters and times are written from Paho callback and publishing
+ * threads and read by monitoring (e.g. the metrics exporter), so they are
+ * atomic. Error details are logged rather than kept here.
  */
 struct MQTTClientStats {
-    MQTTConnectionState state = MQTTConnectionState::DISCONNECTED;
-    std::chrono::time_point<std::chrono::steady_clock> last_connect_time;
-    std::chrono::time_point<std::chrono::steady_clock> last_message_time;
-    int connection_attempts = 0;
-    int messages_sent = 0;
-    int connection_failures = 0;
-    std::string last_error;
+    std::atomic<MQTTConnectionState> state{MQTTConnectionState::DISCONNECTED};
+    std::atomic<std::int64_t> last_connect_us{0};  // steady_clock time since epoch; 0 = never
+    std::atomic<std::int64_t> last_message_us{0};  // steady_clock time since epoch; 0 = never
+    std::atomic<int> connection_attempts{0};
+    std::atomic<int> messages_sent{0};
+    std::atomic<int> connection_failures{0};
     
     void reset() {
-        connection_attempts = 0;
-        messages_sent = 0;
-        connection_failures = 0;
-        last_error.clear();
+        connection_attempts.store(0, std::memory_order_relaxed);
+        messages_sent.store(0, std::memory_order_relaxed);
+        connection_failures.store(0, std::memory_order_relaxed);
     }
 };
 
@@ -58,6 +66,18 @@ public:
      * @param payload Message payload
      */
     virtual void on_message_received(const std::string& topic, const std::string& payload) = 0;
+    
+    /**
+     * @brief Called when a message is received, lending Paho's buffers
+     *
+     * The views are only valid until this returns; copy what must outlive it.
+     * The default copies both and calls on_message_received().
+     * @param topic Topic the message was received on
+     * @param payload Message payload
+     */
+    virtual void on_message_view(std::string_view topic, std::string_view payload) {
+        on_message_received(std::string(topic), std::string(payload));
+    }
 };
 
 /**
@@ -71,8 +91,21 @@ private:
     MQTTAsync client_;
     MQTTClientStats stats_;
     MQTTEventCallback* event_callback_;
+    std::mutex callback_mutex_;  // Held while event_callback_ is called or replaced
     std::string server_uri_;
     std::string client_id_;
+
+    // Metrics, owned by MetricsRegistry
+    Counter& messages_sent_total_;
+    Counter& publish_failures_total_;
+    Histogram& publish_call_latency_;
+    Histogram& reconnect_duration_;
+
+    // QoS > 0 publishes awaiting their acknowledgement
+    InFlightTracker inflight_;
+
+    // Start of the current outage in steady-clock microseconds (0 = connected)
+    std::atomic<std::int64_t> disconnected_since_us_{0};
     
 public:
     /**
@@ -122,12 +155,15 @@ public:
      * @param payload Message payload
      * @param qos Quality of Service level (0, 1, or 2)
      * @param retained Whether message should be retained
+     * @param on_complete Called once the broker acknowledges the message or it
+     *                    is lost (QoS > 0 only, not called when this returns false)
      * @return true if publish was initiated successfully
      */
     bool publish(const std::string& topic,
                 const std::string& payload,
                 int qos = 1,
-                bool retained = false);
+                bool retained = false,
+                DeliveryCallback on_complete = nullptr);
     
     /**
      * @brief Subscribe to topic
@@ -150,8 +186,24 @@ public:
      */
     const MQTTClientStats& get_stats() const;
     
+    /**
+     * @brief Get acknowledgement counters and the unacknowledged backlog
+     */
+    InFlightStats get_inflight_stats() const;
+    
+    /**
+     * @brief Forget in-flight publishes without running their callbacks
+     *
+     * For owners whose callbacks must not run anymore, e.g. while being destroyed.
+     * Waits for completion callbacks already running on a Paho thread.
+     */
+    void drop_inflight();
+    
     /**
      * @brief Set event callback handler
+     *
+     * Waits for a callback already running on a Paho thread, so the old
+     * handler is never called once this returns.
      * @param callback Event callback (can be nullptr)
      */
     void set_event_callback(MQTTEventCallback* callback);
@@ -164,6 +216,7 @@ public:
     static void on_disconnect_wrapper(void* context, MQTTAsync_successData* response);
     static void on_subscribe_success_wrapper(void* context, MQTTAsync_successData* response);
     static void on_subscribe_failure_wrapper(void* context, MQTTAsync_failureData* response);
+    static void on_publish_failure_wrapper(void* context, MQTTAsync_failureData* response);
     static int on_message_arrived_wrapper(void* context, char* topic_name, int topic_len, MQTTAsync_message* message);
     
 private:
@@ -171,6 +224,13 @@ private:
     void handle_connection_success();
     void handle_connection_failure(const std::string& error);
     void handle_message_delivered(int token);
+    void mark_disconnected();
+    
+    /**
+     * @brief Call the event handler, if any, under callback_mutex_
+     */
+    template <typename Event>
+    void notify(Event&& event);
 };
 
 } // namespace thermal
\ No newline at end of file
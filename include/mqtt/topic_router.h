@@ -0,0 +1,48 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Dispatches inbound messages by topic prefix without allocating
+ *
+ * Routes are tried in the order they were added; the first whose prefix
+ * starts the topic gets the message. Handlers see the rest of the topic
+ * after the prefix (e.g. the RPC request ID) and the payload as views into
+ * the client's buffers, valid only until the handler returns.
+ */
+class TopicRouter {
+public:
+    /**
+     * @param suffix Topic text after the matched prefix
+     * @param payload Message payload
+     */
+    using Handler = std::function<void(std::string_view suffix, std::string_view payload)>;
+
+    /**
+     * @brief Add a route; an empty prefix matches every topic
+     */
+    void add(std::string prefix, Handler handler);
+
+    /**
+     * @brief Hand a message to the first matching route
+     * @return false if no route matched
+     */
+    bool dispatch(std::string_view topic, std::string_view payload) const;
+
+    size_t size() const { return routes_.size(); }
+
+private:
+    struct Route {
+        std::string prefix;
+        Handler handler;
+    };
+
+    std::vector<Route> routes_;
+};
+
+} // namespace thermal
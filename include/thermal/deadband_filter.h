@@ -0,0 +1,105 @@
+#pragma once
+
+#include "thermal/measurement_spot.h"
+#include "thermal/temperature_reading.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Report-by-exception thresholds for one spot
+ */
+struct DeadbandSettings {
+    double deadband_celsius = 0.0;  // Absolute change that triggers a publish (°C, 0 = off)
+    double deadband_percent = 0.0;  // Relative change in % of the last sent value (0 = off)
+    int heartbeat_seconds = 0;      // Longest silence before republishing (0 = never forced)
+
+    /**
+     * @brief Check if any deadband is set; without one every reading is published
+     */
+    bool active() const { return deadband_celsius > 0.0 || deadband_percent > 0.0; }
+
+    /**
+     * @brief Apply the overrides a spot carries on top of these settings
+     * @param spot Spot with optional deadband/heartbeat overrides
+     * @return Effective settings for the spot
+     */
+    DeadbandSettings withOverrides(const MeasurementSpot& spot) const;
+};
+
+/**
+ * @brief Drops readings that did not move beyond their spot's deadband
+ *
+ * Sits between ThermalSpotManager::sampleSpots() and the device: a reading
+ * passes when it is the first of its spot, when it differs from the last
+ * passed value by more than the absolute or relative deadband, or when the
+ * heartbeat interval has expired since that value. Time is taken from the
+ * reading timestamps. Per-spot state lives in flat tables indexed by spot ID.
+ */
+class DeadbandFilter {
+public:
+    /**
+     * @brief Constructor
+     * @param defaults Settings for spots without their own
+     * @param capacity Highest spot ID tracked
+     */
+    explicit DeadbandFilter(const DeadbandSettings& defaults = DeadbandSettings(),
+                            size_t capacity = MAX_MEASUREMENT_SPOTS);
+
+    /**
+     * @brief Replace the settings used by spots without their own
+     */
+    void setDefaults(const DeadbandSettings& defaults) { defaults_ = defaults; }
+
+    const DeadbandSettings& getDefaults() const { return defaults_; }
+
+    /**
+     * @brief Give a spot its own settings
+     * @param spot_id Spot ID (ignored if out of range)
+     * @param settings Settings for this spot
+     */
+    void setSpotSettings(int spot_id, const DeadbandSettings& settings);
+
+    /**
+     * @brief Forget a spot's settings and last sent value (e.g. after deletion)
+     * @param spot_id Spot ID
+     */
+    void resetSpot(int spot_id);
+
+    /**
+     * @brief Decide whether a reading is published, recording it if so
+     * @param reading Sampled reading
+     * @return true if the reading should be sent
+     */
+    bool shouldPublish(const TemperatureReading& reading);
+
+    /**
+     * @brief Filter readings in place
+     * @param readings Readings of one sampling instant; kept readings are moved to the front
+     * @param count Number of readings
+     * @return Number of readings kept
+     */
+    size_t filter(TemperatureReading* readings, size_t count);
+
+    std::uint64_t getPublishedCount() const { return published_; }
+    std::uint64_t getSuppressedCount() const { return suppressed_; }
+
+private:
+    struct SpotTrack {
+        bool has_settings = false;
+        bool has_sent = false;
+        DeadbandSettings settings;
+        double last_value = 0.0;
+        std::chrono::time_point<std::chrono::system_clock> last_sent_at;
+    };
+
+    DeadbandSettings defaults_;
+    std::vector<SpotTrack> tracks_;  // Indexed by spot ID, entry 0 unused
+    std::uint64_t published_ = 0;
+    std::uint64_t suppressed_ = 0;
+};
+
+} // namespace thermal
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "thermal/frame/thermal_frame.h"
+#include "thermal/temperature_source/temperature_data_source.h"
+#include <chrono>
+#include <cstdint>
+
+namespace thermal {
+
+/**
+ * @brief Hottest and coldest pixel of one frame
+ */
+struct FrameExtremes {
+    bool valid = false;         // false if no frame has been analyzed
+    std::uint64_t sequence = 0; // Sequence number of the analyzed frame
+    std::chrono::time_point<std::chrono::system_clock> captured_at;  // Capture time of the analyzed frame
+    float max_temp = 0.0f;      // Hottest pixel (°C)
+    Point max_location;         // Location of the hottest pixel
+    float min_temp = 0.0f;      // Coldest pixel (°C)
+    Point min_location;         // Location of the coldest pixel
+};
+
+/**
+ * @brief Frame-wide hotspot and coldspot detection
+ *
+ * Each row is reduced with a SIMD min/max scan; only the rows that hold the
+ * winning values are rescanned to locate the pixels, so a frame costs one
+ * vectorized pass plus two row scans.
+ */
+class HotspotFinder {
+public:
+    /**
+     * @brief Find the extremes of a frame
+     * @param frame Captured frame
+     * @return Extremes, valid == false if the frame holds no data
+     */
+    static FrameExtremes find(const ThermalFrame& frame);
+};
+
+} // namespace thermal
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "thermal/frame/thermal_frame.h"
+#include <cstdint>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Summed-area table over a thermal frame
+ *
+ * Built once per frame in a single pass; afterwards the sum (and therefore
+ * the mean) of any axis-aligned rectangle costs four lookups regardless of
+ * its size. Sums are kept in double so large areas don't lose precision.
+ */
+class IntegralImage {
+public:
+    /**
+     * @brief Rebuild the table from a frame, reusing existing storage
+     * @param frame Source frame
+     */
+    void build(const ThermalFrame& frame);
+
+    /**
+     * @brief Sum of the pixels in a rectangle (no bounds checking)
+     * @param x Left edge
+     * @param y Top edge
+     * @param w Width in pixels
+     * @param h Height in pixels
+     * @return Sum of temperatures in the rectangle
+     */
+    double sum(int x, int y, int w, int h) const {
+        const size_t stride = static_cast<size_t>(width_) + 1;
+        const size_t top = static_cast<size_t>(y) * stride;
+        const size_t bottom = static_cast<size_t>(y + h) * stride;
+        return table_[bottom + x + w] - table_[bottom + x] - table_[top + x + w] + table_[top + x];
+    }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    /**
+     * @brief Sequence number of the frame the table was built from (0 = never built)
+     */
+    std::uint64_t sequence() const { return sequence_; }
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    std::uint64_t sequence_ = 0;
+
+    // (width + 1) x (height + 1) table; row 0 and column 0 are zero
+    std::vector<double> table_;
+};
+
+} // namespace thermal
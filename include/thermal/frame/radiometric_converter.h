@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Sensor calibration used to turn raw counts into temperature
+ *
+ * When planck_r is set the FLIR Planck model is used:
+ *     T[K] = B / ln(R / (counts - O) + F)
+ * otherwise counts are linear in Kelvin (TLinear output).
+ */
+struct RadiometricCalibration {
+    double planck_r = 0.0;          // Planck R (0 = linear mode)
+    double planck_b = 1428.0;       // Planck B
+    double planck_f = 1.0;          // Planck F
+    double planck_o = 0.0;          // Planck O (count offset)
+    double kelvin_per_count = 0.01; // Linear mode scale (TLinear high resolution)
+
+    bool usesPlanck() const { return planck_r > 0.0; }
+};
+
+/**
+ * @brief Converts raw 16-bit sensor counts to Celsius through a lookup table
+ *
+ * The calibration is evaluated once for every possible count when the
+ * converter is built, so converting a frame is one table load per pixel
+ * regardless of how expensive the calibration math is.
+ */
+class RadiometricConverter {
+public:
+    static constexpr size_t LUT_SIZE = 65536;
+
+    /**
+     * @brief Constructor
+     * @param calibration Sensor calibration
+     */
+    explicit RadiometricConverter(const RadiometricCalibration& calibration = RadiometricCalibration());
+
+    /**
+     * @brief Rebuild the lookup table for a new calibration
+     * @param calibration Sensor calibration
+     */
+    void setCalibration(const RadiometricCalibration& calibration);
+
+    const RadiometricCalibration& getCalibration() const { return calibration_; }
+
+    /**
+     * @brief Convert a single count
+     */
+    float toCelsius(std::uint16_t count) const { return lut_[count]; }
+
+    /**
+     * @brief Convert a run of counts
+     * @param counts Raw sensor counts
+     * @param count Number of samples
+     * @param celsius Output buffer receiving one value per sample
+     */
+    void convert(const std::uint16_t* counts, size_t count, float* celsius) const;
+
+    /**
+     * @brief Affine correction that compensates emissivity and reflected temperature
+     *
+     * Linearizes T_obj = (T_meas - (1 - e) * T_refl) / e in Kelvin into
+     * T_obj[°C] = gain * T_meas[°C] + offset.
+     * @param emissivity Object emissivity (0 < e <= 1)
+     * @param reflected_temp Reflected apparent temperature in Celsius
+     * @param gain Output gain
+     * @param offset Output offset in Celsius
+     */
+    static void compensationCoefficients(double emissivity, double reflected_temp,
+                                         float& gain, float& offset);
+
+    /**
+     * @brief Apply per-element affine corrections: out[i] = gain[i] * in[i] + offset[i]
+     * @param in Measured temperatures
+     * @param gain Per-element gains
+     * @param offset Per-element offsets
+     * @param count Number of elements
+     * @param out Output buffer (may alias in)
+     */
+    static void applyCompensation(const float* in, const float* gain, const float* offset,
+                                  size_t count, float* out);
+
+private:
+    RadiometricCalibration calibration_;
+    std::vector<float> lut_;  // LUT_SIZE entries, indexed by raw count
+};
+
+} // namespace thermal
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "thermal/frame/integral_image.h"
+#include "thermal/frame/thermal_frame.h"
+#include "thermal/measurement_area.h"
+#include <cstddef>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Statistics of a measurement area over one frame
+ */
+struct AreaStatistics {
+    bool valid = false;         // false if the area does not overlap the frame
+    float min_temp = 0.0f;      // Coldest pixel (°C)
+    float max_temp = 0.0f;      // Hottest pixel (°C)
+    double mean_temp = 0.0;     // Mean over all covered pixels (°C)
+    Point hottest;              // Location of the hottest pixel
+    size_t pixel_count = 0;     // Number of pixels covered
+};
+
+/**
+ * @brief Statistics of one configured area
+ */
+struct AreaReading {
+    int area_id = 0;
+    AreaStatistics statistics;
+};
+
+/**
+ * @brief Computes box and polygon statistics over the current frame
+ *
+ * update() builds the summed-area table once per captured frame, so box
+ * means cost four lookups. Polygons are rasterized into horizontal spans at
+ * pixel centers; each span contributes its sum through the same table. Min,
+ * max and hottest pixel come from SIMD scans over the contiguous span rows.
+ * Areas are clipped to the frame.
+ */
+class RegionAnalyzer {
+public:
+    /**
+     * @brief Attach the analyzer to a frame
+     *
+     * The integral image is only rebuilt when the frame sequence or size
+     * changes. The frame must outlive subsequent measure calls.
+     * @param frame Current frame
+     */
+    void update(const ThermalFrame& frame);
+
+    /**
+     * @brief Measure an area of either shape
+     * @param area Area configuration
+     * @return Statistics; valid == false if no frame is attached or the area misses the frame
+     */
+    AreaStatistics measure(const MeasurementArea& area) const;
+
+    /**
+     * @brief Measure an axis-aligned box
+     * @param x Left edge
+     * @param y Top edge
+     * @param width Width in pixels
+     * @param height Height in pixels
+     * @return Box statistics
+     */
+    AreaStatistics measureBox(int x, int y, int width, int height) const;
+
+    /**
+     * @brief Measure a polygon
+     * @param vertices Vertices in order (at least 3)
+     * @return Polygon statistics
+     */
+    AreaStatistics measurePolygon(const std::vector<Point>& vertices) const;
+
+    /**
+     * @brief Get the integral image of the attached frame
+     */
+    const IntegralImage& integralImage() const { return integral_; }
+
+private:
+    /**
+     * @brief Running accumulator over horizontal spans
+     */
+    struct SpanAccumulator {
+        double sum = 0.0;
+        size_t count = 0;
+        float min_temp = 0.0f;
+        float max_temp = 0.0f;
+        int hottest_row = -1;       // Row of the hottest span, located after the scan
+        int hottest_x0 = 0;
+        int hottest_x1 = 0;
+    };
+
+    /**
+     * @brief Add pixels [x0, x1) of row y to the accumulator
+     */
+    void addSpan(SpanAccumulator& acc, int y, int x0, int x1) const;
+
+    /**
+     * @brief Convert an accumulator into final statistics
+     */
+    AreaStatistics finish(const SpanAccumulator& acc) const;
+
+    const ThermalFrame* frame_ = nullptr;
+    IntegralImage integral_;
+};
+
+} // namespace thermal
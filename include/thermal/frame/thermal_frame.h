@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Full radiometric frame of temperatures captured at one instant
+ * 
+ * Pixels are stored row-major in a single contiguous buffer so analytics can
+ * walk whole rows without per-pixel virtual calls. Every spot sampled from the
+ * same frame shares the same sequence number and capture timestamp.
+ */
+struct ThermalFrame {
+    // Default simulated sensor resolution
+    static constexpr int DEFAULT_WIDTH = 320;
+    static constexpr int DEFAULT_HEIGHT = 240;
+    
+    int width = 0;                                      // Frame width in pixels
+    int height = 0;                                     // Frame height in pixels
+    std::uint64_t sequence = 0;                         // Monotonic frame counter (0 = never captured)
+    std::chrono::time_point<std::chrono::system_clock> captured_at;  // When the frame was captured
+    std::vector<float> pixels;                          // Row-major temperatures in Celsius
+    
+    /**
+     * @brief Default constructor (empty frame)
+     */
+    ThermalFrame() = default;
+    
+    /**
+     * @brief Construct frame with given resolution
+     * @param frame_width Width in pixels
+     * @param frame_height Height in pixels
+     * @throws std::invalid_argument if dimensions are not positive
+     */
+    ThermalFrame(int frame_width, int frame_height);
+    
+    /**
+     * @brief Resize the pixel buffer, reusing existing storage when possible
+     * @param frame_width Width in pixels
+     * @param frame_height Height in pixels
+     * @throws std::invalid_argument if dimensions are not positive
+     */
+    void resize(int frame_width, int frame_height);
+    
+    /**
+     * @brief Check if coordinates are inside the frame
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @return true if 0 <= x < width and 0 <= y < height
+     */
+    bool contains(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+    
+    /**
+     * @brief Get temperature at coordinates (no bounds checking)
+     */
+    float at(int x, int y) const { return pixels[static_cast<size_t>(y) * width + x]; }
+    float& at(int x, int y) { return pixels[static_cast<size_t>(y) * width + x]; }
+    
+    /**
+     * @brief Get pointer to the first pixel of a row (no bounds checking)
+     */
+    const float* row(int y) const { return pixels.data() + static_cast<size_t>(y) * width; }
+    float* row(int y) { return pixels.data() + static_cast<size_t>(y) * width; }
+    
+    /**
+     * @brief Get number of pixels in the frame
+     */
+    size_t pixelCount() const { return pixels.size(); }
+    
+    /**
+     * @brief Check if the frame holds captured data
+     * @return true if a capture has populated the buffer
+     */
+    bool isValid() const { return sequence > 0 && !pixels.empty(); }
+};
+
+} // namespace thermal
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "thermal/temperature_source/temperature_data_source.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace thermal {
+
+/**
+ * @brief Maximum number of measurement areas per camera (area IDs 1..N)
+ */
+constexpr size_t MAX_MEASUREMENT_AREAS = 64;
+
+/**
+ * @brief Shape of a measurement area
+ */
+enum class AreaShape {
+    BOX,        // Axis-aligned rectangle
+    POLYGON     // Closed polygon with pixel-corner vertices
+};
+
+/**
+ * @brief Region of interest measured as a whole (min, max, mean, hotspot)
+ *
+ * Coordinates follow the pixel-corner convention: a box at (x, y) with size
+ * width x height covers pixels x..x+width-1 and y..y+height-1, and a polygon
+ * covers every pixel whose center lies inside it. A polygon traced along the
+ * corners of a box therefore covers exactly the same pixels as the box.
+ */
+struct MeasurementArea {
+    // Configuration
+    int id = 0;
+    std::string name;
+    AreaShape shape = AreaShape::BOX;
+    int x = 0;                  // Box left edge (pixels)
+    int y = 0;                  // Box top edge (pixels)
+    int width = 0;              // Box width (pixels)
+    int height = 0;             // Box height (pixels)
+    std::vector<Point> vertices; // Polygon vertices in order (POLYGON only)
+    bool enabled = true;        // Whether this area is actively monitored
+
+    /**
+     * @brief Validate the measurement area configuration
+     * @return true if configuration is valid
+     * @throws std::invalid_argument if validation fails
+     */
+    bool validate() const;
+
+    /**
+     * @brief Load area configuration from JSON
+     * @param json_data The JSON object to parse
+     * @throws std::invalid_argument if JSON is invalid
+     */
+    void from_json(const nlohmann::json& json_data);
+
+    /**
+     * @brief Convert area configuration to JSON
+     * @return JSON representation of the area
+     */
+    nlohmann::json to_json() const;
+};
+
+/**
+ * @brief Convert area shape to its JSON name ("box" or "polygon")
+ */
+std::string areaShapeToString(AreaShape shape);
+
+/**
+ * @brief Parse area shape from its JSON name
+ * @throws std::invalid_argument if the name is unknown
+ */
+AreaShape areaShapeFromString(const std::string& name);
+
+} // namespace thermal
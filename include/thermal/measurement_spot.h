@@ -1,11 +1,24 @@
 #pragma once
 
 #include <string>
+#include <optional>
 #include <nlohmann/json.hpp>
 #include <set>
 
 namespace thermal {
 
+/**
+ * @brief Maximum number of measurement spots per camera (spot IDs 1..N)
+ */
+constexpr size_t MAX_MEASUREMENT_SPOTS = 4096;
+
+/**
+ * @brief Parse a spot ID string ("1" to MAX_MEASUREMENT_SPOTS)
+ * @param spot_id Plain decimal without sign or leading zeros
+ * @return Numeric ID, or 0 if spot_id is not valid
+ */
+int parse_spot_id(const std::string& spot_id);
+
 /**
  * @brief Measurement spot states
  */
@@ -28,8 +41,15 @@ struct MeasurementSpot {
     double min_temp = 20.0;     // Minimum expected temperature (°C)
     double max_temp = 100.0;    // Maximum expected temperature (°C)
     double noise_factor = 0.1;  // Temperature variation noise factor (0.0-1.0)
+    double emissivity = 1.0;    // Target emissivity used for compensation (0.0-1.0]
+    double reflected_temp = 20.0; // Reflected apparent temperature (°C)
     bool enabled = true;        // Whether this spot is actively monitored
     
+    // Report-by-exception overrides; unset fields fall back to TelemetryConfig
+    std::optional<double> deadband_celsius;  // Absolute change that triggers a publish (°C)
+    std::optional<double> deadband_percent;  // Relative change that triggers a publish (%)
+    std::optional<int> heartbeat_seconds;    // Longest silence before republishing
+    
     // RPC-specific metadata (optional)
     std::string created_at;     // ISO 8601 timestamp when spot was created via RPC
     std::string last_reading_at; // ISO 8601 timestamp of last temperature reading
@@ -17,6 +17,7 @@ namespace thermal {
  * - deleteSpotMeasurement: Remove thermal measurement spot
  * - listSpotMeasurements: Get all active thermal spots
  * - getSpotTemperature: Get current temperature reading for specific spot
+ * - applySpotBatch: Apply many creates, moves and deletes all-or-nothing
  */
 class ThermalRPCHandler {
 public:
@@ -56,54 +57,62 @@ public:
     
     /**
      * @brief Check if command is supported by this handler
-     * @param method RPC method name
+     * @param method Parsed RPC method
      * @return true if method is supported, false otherwise
      */
-    bool isSupported(const std::string& method) const;
+    bool isSupported(RPCMethod method) const;
 
 private:
     /**
      * @brief Handle createSpotMeasurement RPC command
      * @param request_id RPC request ID
-     * @param command RPC command with parameters
+     * @param args Validated command arguments
      */
-    void handleCreateSpotMeasurement(const std::string& request_id, const RPCCommand& command);
+    void handleCreateSpotMeasurement(const std::string& request_id, const CreateSpotArgs& args);
     
     /**
      * @brief Handle moveSpotMeasurement RPC command
      * @param request_id RPC request ID
-     * @param command RPC command with parameters
+     * @param args Validated command arguments
      */
-    void handleMoveSpotMeasurement(const std::string& request_id, const RPCCommand& command);
+    void handleMoveSpotMeasurement(const std::string& request_id, const MoveSpotArgs& args);
     
     /**
      * @brief Handle deleteSpotMeasurement RPC command
      * @param request_id RPC request ID
-     * @param command RPC command with parameters
+     * @param args Validated command arguments
      */
-    void handleDeleteSpotMeasurement(const std::string& request_id, const RPCCommand& command);
+    void handleDeleteSpotMeasurement(const std::string& request_id, const DeleteSpotArgs& args);
     
     /**
      * @brief Handle listSpotMeasurements RPC command
      * @param request_id RPC request ID
-     * @param command RPC command with parameters
      */
-    void handleListSpotMeasurements(const std::string& request_id, const RPCCommand& command);
+    void handleListSpotMeasurements(const std::string& request_id);
     
     /**
      * @brief Handle getSpotTemperature RPC command
      * @param request_id RPC request ID
-     * @param command RPC command with parameters
+     * @param args Validated command arguments
      */
-    void handleGetSpotTemperature(const std::string& request_id, const RPCCommand& command);
+    void handleGetSpotTemperature(const std::string& request_id, const GetSpotTemperatureArgs& args);
+    
+    /**
+     * @brief Handle applySpotBatch RPC command
+     * @param request_id RPC request ID
+     * @param args Validated command arguments
+     */
+    void handleApplySpotBatch(const std::string& request_id, const ApplySpotBatchArgs& args);
     
     /**
      * @brief Send error response back to ThingsBoard
      * @param request_id RPC request ID
      * @param error_code Error code string
      * @param error_message Error message description
+     * @param results Per-operation results to include in the error, if not null
      */
-    void sendErrorResponse(const std::string& request_id, const std::string& error_code, const std::string& error_message);
+    void sendErrorResponse(const std::string& request_id, const std::string& error_code, const std::string& error_message,
+                           const nlohmann::json& results = nullptr);
     
     /**
      * @brief Send success response back to ThingsBoard
@@ -112,34 +121,6 @@ private:
      */
     void sendSuccessResponse(const std::string& request_id, const nlohmann::json& data);
     
-    /**
-     * @brief Validate required parameters for createSpotMeasurement
-     * @param command RPC command to validate
-     * @return true if valid, false otherwise
-     */
-    bool validateCreateSpotParams(const RPCCommand& command);
-    
-    /**
-     * @brief Validate required parameters for moveSpotMeasurement
-     * @param command RPC command to validate
-     * @return true if valid, false otherwise
-     */
-    bool validateMoveSpotParams(const RPCCommand& command);
-    
-    /**
-     * @brief Validate required parameters for deleteSpotMeasurement
-     * @param command RPC command to validate
-     * @return true if valid, false otherwise
-     */
-    bool validateDeleteSpotParams(const RPCCommand& command);
-    
-    /**
-     * @brief Validate required parameters for getSpotTemperature
-     * @param command RPC command to validate
-     * @return true if valid, false otherwise
-     */
-    bool validateGetTempParams(const RPCCommand& command);
-    
     std::shared_ptr<ThermalSpotManager> spot_manager_;
     ResponseCallback response_callback_;
 };
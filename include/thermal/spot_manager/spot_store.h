@@ -0,0 +1,137 @@
+#pragma once
+
+#include "thermal/measurement_spot.h"
+#include "thermal/temperature_source/temperature_data_source.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Dense structure-of-arrays storage for measurement spots
+ * 
+ * Hot per-cycle data (positions, temperature ranges, enabled flags and the
+ * emissivity compensation gain/offset) lives in parallel vectors indexed by
+ * a dense slot, so sampling walks contiguous memory. Spot IDs map to slots through a flat index table; deletion swaps
+ * the last slot into the hole, keeping create/move/delete O(1). Released IDs
+ * go to a free list and are handed out again by allocateId().
+ */
+class SpotStore {
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of spots (IDs range from 1 to capacity)
+     */
+    explicit SpotStore(size_t capacity);
+    
+    /**
+     * @brief Insert a spot under its ID
+     * @param spot Spot to store (spot.id must be in range and unused)
+     * @return true if inserted
+     */
+    bool insert(const MeasurementSpot& spot);
+    
+    /**
+     * @brief Update position and expected temperature range of a spot
+     * @param id Spot ID
+     * @param x New X coordinate
+     * @param y New Y coordinate
+     * @param min_temp New minimum expected temperature
+     * @param max_temp New maximum expected temperature
+     * @return true if the spot exists
+     */
+    bool update(int id, int x, int y, double min_temp, double max_temp);
+    
+    /**
+     * @brief Remove a spot and release its ID
+     * @param id Spot ID
+     * @return true if the spot existed
+     */
+    bool erase(int id);
+    
+    /**
+     * @brief Remove all spots and reset the ID free list
+     */
+    void clear();
+    
+    /**
+     * @brief Find a free ID for the next insert
+     * 
+     * Prefers released IDs, most recently queued first, then the next
+     * never-used one.
+     * The ID is not reserved until insert() is called with it.
+     * @return Free spot ID, or 0 if the store is full
+     */
+    int allocateId();
+    
+    /**
+     * @brief Check if a spot with this ID is stored
+     */
+    bool contains(int id) const { return slotOf(id) >= 0; }
+    
+    /**
+     * @brief Get the dense slot for a spot ID
+     * @return Slot index, or -1 if the ID is not stored
+     */
+    int slotOf(int id) const {
+        return (id >= 1 && static_cast<size_t>(id) <= capacity_) ? slot_of_id_[id] : -1;
+    }
+    
+    /**
+     * @brief Materialize a spot from its columns
+     * @param slot Dense slot index (must be valid)
+     * @return Spot copy
+     */
+    MeasurementSpot toSpot(int slot) const;
+    
+    size_t size() const { return ids_.size(); }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return ids_.empty(); }
+    bool full() const { return ids_.size() >= capacity_; }
+    
+    // Column accessors, all indexed by dense slot
+    const std::vector<int>& ids() const { return ids_; }
+    const std::vector<Point>& positions() const { return positions_; }
+    const std::vector<double>& minTemps() const { return min_temps_; }
+    const std::vector<double>& maxTemps() const { return max_temps_; }
+    const std::vector<std::uint8_t>& enabled() const { return enabled_; }
+    const std::vector<float>& compensationGains() const { return compensation_gains_; }
+    const std::vector<float>& compensationOffsets() const { return compensation_offsets_; }
+    
+private:
+    size_t capacity_;
+    
+    // Hot columns
+    std::vector<int> ids_;
+    std::vector<Point> positions_;
+    std::vector<double> min_temps_;
+    std::vector<double> max_temps_;
+    std::vector<std::uint8_t> enabled_;
+    std::vector<float> compensation_gains_;
+    std::vector<float> compensation_offsets_;
+    
+    // Cold columns, only touched for listing and persistence
+    std::vector<std::string> names_;
+    std::vector<double> noise_factors_;
+    std::vector<double> emissivities_;
+    std::vector<double> reflected_temps_;
+    std::vector<std::optional<double>> deadbands_celsius_;
+    std::vector<std::optional<double>> deadbands_percent_;
+    std::vector<std::optional<int>> heartbeats_seconds_;
+    std::vector<std::string> created_at_;
+    std::vector<std::string> last_reading_at_;
+    
+    // ID -> slot index (index 0 unused), -1 when free
+    std::vector<int> slot_of_id_;
+    
+    // Released IDs (may hold stale entries re-taken by explicit inserts), a
+    // flag per ID that is on that list, and the high-water mark of IDs handed
+    // out so far
+    std::vector<int> free_ids_;
+    std::vector<std::uint8_t> id_queued_;
+    int next_unused_id_ = 1;
+};
+
+} // namespace thermal
@@ -1,29 +1,75 @@
 #pragma once
 
 #include "thermal/measurement_spot.h"
+#include "thermal/temperature_reading.h"
+#include "thermal/spot_manager/spot_store.h"
+#include "thermal/frame/hotspot_finder.h"
+#include "thermal/frame/region_analyzer.h"
+#include "thermal/measurement_area.h"
 #include "thermal/temperature_source/temperature_data_source.h"
 #include <memory>
-#include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 #include <chrono>
+#include <cstdint>
 
 namespace thermal {
 
+/**
+ * @brief One create, move or delete in a batch for ThermalSpotManager::applySpotChanges()
+ */
+struct SpotChange {
+    enum class Type { CREATE, MOVE, DELETE };
+    
+    Type type = Type::CREATE;
+    std::string spotId;  // Empty on CREATE to have a free ID assigned
+    int x = 0;
+    int y = 0;
+};
+
+/**
+ * @brief Outcome of one SpotChange
+ */
+enum class SpotChangeStatus {
+    APPLIED,              // Part of a batch that was committed
+    NOT_APPLIED,          // Valid, but another change in the batch failed
+    INVALID_SPOT_ID,
+    SPOT_EXISTS,
+    SPOT_NOT_FOUND,
+    INVALID_COORDINATES,
+    MAX_SPOTS_REACHED,
+    INVALID_SPOT          // Spot failed MeasurementSpot::validate()
+};
+
+/**
+ * @brief Per-change result of ThermalSpotManager::applySpotChanges()
+ */
+struct SpotChangeResult {
+    SpotChangeStatus status = SpotChangeStatus::NOT_APPLIED;
+    std::string spotId;  // Spot the change addressed, including IDs assigned on create
+};
+
 /**
  * @brief Central manager for thermal measurement spots with RPC control
  * 
  * Coordinates spot lifecycle (create, move, delete), integrates with temperature
  * data sources, and manages spot persistence. Extends existing MeasurementSpot
  * infrastructure with RPC capabilities.
+ * 
+ * Thread-safe: queries share a reader lock and run in parallel, mutations and
+ * sampleSpots() take it exclusively. The persistence file is written after the
+ * lock is released, in mutation order.
  */
 class ThermalSpotManager {
-private:
-    // Maximum spots per FR-014 requirement
-    static constexpr size_t MAX_SPOTS = 5;
+public:
+    // Maximum spots per camera; spot IDs range from "1" to this value
+    static constexpr size_t MAX_SPOTS = MAX_MEASUREMENT_SPOTS;
     
-    // Active spots indexed by spotId ("1" to "5")
-    std::map<std::string, std::unique_ptr<MeasurementSpot>> spots_;
+private:
+    // Active spots in dense structure-of-arrays storage indexed by spot ID
+    SpotStore spots_;
     
     // Temperature data source for coordinate-based calculation
     std::unique_ptr<TemperatureDataSource> temp_source_;
@@ -31,6 +77,31 @@ private:
     // Persistence manager for spot configuration
     std::string persistence_file_path_;
     
+    // Reusable buffer for batched per-cycle sampling
+    std::vector<float> sample_temperatures_;
+    
+    // Hottest/coldest pixel of the most recently sampled frame
+    FrameExtremes frame_extremes_;
+    
+    // Configured areas and their statistics over the most recently sampled frame
+    std::vector<MeasurementArea> areas_;
+    RegionAnalyzer region_analyzer_;
+    std::vector<AreaReading> area_readings_;
+    
+    // IDs created, moved, deleted or loaded since the last takeChangedSpots(),
+    // each listed once (flagged in spot_changed_)
+    std::vector<int> changed_spots_;
+    std::vector<std::uint8_t> spot_changed_;
+    
+    // Guards the spots and the sampling state
+    mutable std::shared_mutex mutex_;
+    
+    // Serializes source reads made under the shared lock (sources cache frames)
+    mutable std::mutex source_mutex_;
+    
+    // Orders persistence file writes
+    mutable std::mutex persist_mutex_;
+    
 public:
     /**
      * @brief Constructor with just config path
@@ -59,16 +130,34 @@ public:
     
     /**
      * @brief Create new measurement spot at specified coordinates
-     * @param spotId Spot identifier ("1" to "5")
+     * @param spotId Spot identifier ("1" to MAX_SPOTS)
      * @param x X coordinate (0-319)
      * @param y Y coordinate (0-239)
      * @return true if spot created successfully
      */
     bool createSpot(const std::string& spotId, int x, int y);
     
+    /**
+     * @brief Create new measurement spot with an ID taken from the free list
+     * @param x X coordinate (0-319)
+     * @param y Y coordinate (0-239)
+     * @return Assigned spot ID, or empty string if the spot could not be created
+     */
+    std::string createSpot(int x, int y);
+    
+    /**
+     * @brief Create a spot from its configuration
+     * 
+     * Like createSpot(spotId, x, y), but the spot also keeps the configured
+     * emissivity, reflected temperature and report-by-exception overrides.
+     * @param config Configured spot (id, x, y and measurement settings)
+     * @return true if spot created successfully
+     */
+    bool createSpot(const MeasurementSpot& config);
+    
     /**
      * @brief Move existing spot to new coordinates
-     * @param spotId Spot identifier ("1" to "5")
+     * @param spotId Spot identifier ("1" to MAX_SPOTS)
      * @param x New X coordinate (0-319)
      * @param y New Y coordinate (0-239)
      * @return true if spot moved successfully
@@ -77,24 +166,91 @@ public:
     
     /**
      * @brief Delete measurement spot
-     * @param spotId Spot identifier ("1" to "5")
+     * @param spotId Spot identifier ("1" to MAX_SPOTS)
      * @return true if spot deleted successfully
      */
     bool deleteSpot(const std::string& spotId);
     
+    /**
+     * @brief Apply a batch of creates, moves and deletes all-or-nothing
+     * 
+     * Changes run in order against a staged copy of the spots, so later
+     * changes see earlier ones (a spot created in the batch can be moved by
+     * it). If every change succeeds the copy replaces the live spots and the
+     * persistence file is written once; otherwise nothing changes. Every
+     * change is checked either way, so all failures are reported together.
+     * @param changes Changes in the order to apply them
+     * @param results Output, one result per change
+     * @return true if the batch was applied
+     */
+    bool applySpotChanges(const std::vector<SpotChange>& changes, std::vector<SpotChangeResult>& results);
+    
     /**
      * @brief Get list of all active spots
-     * @return Vector of spot copies for reading
+     * @return Vector of spot copies for reading, ordered by spot ID
      */
     std::vector<MeasurementSpot> listSpots() const;
     
+    /**
+     * @brief Get a copy of one spot
+     * @param id Numeric spot ID
+     * @param spot Output spot
+     * @return true if the spot exists
+     */
+    bool getSpot(int id, MeasurementSpot& spot) const;
+    
+    /**
+     * @brief Take the IDs of spots changed since the previous call
+     * 
+     * Covers creates, moves, deletes (including batches) and loads, so state
+     * kept per spot ID elsewhere (e.g. a DeadbandFilter) can be reset when an
+     * ID is reused or a spot points somewhere else. Call it after
+     * sampleSpots(), so readings of a spot changed before sampling are not
+     * judged against stale state.
+     * @return Changed spot IDs, each once
+     */
+    std::vector<int> takeChangedSpots();
+    
     /**
      * @brief Get current temperature reading for a spot (simple version)
-     * @param spotId Spot identifier ("1" to "5")
+     * @param spotId Spot identifier ("1" to MAX_SPOTS)
      * @return Temperature in Celsius, or NaN if spot doesn't exist
      */
     float getSpotTemperature(const std::string& spotId) const;
     
+    /**
+     * @brief Capture one frame and sample every active spot from it
+     * 
+     * All readings of a cycle share the frame's capture timestamp, so values
+     * published together are consistent in time. Frame-based sources also
+     * get their frame-wide extremes and area statistics updated (see
+     * getFrameExtremes() and getAreaReadings()).
+     * @return One reading per active spot (empty if the source is not ready)
+     */
+    std::vector<TemperatureReading> sampleSpots();
+    
+    /**
+     * @brief Get hottest and coldest pixel of the last sampled frame
+     * 
+     * Only valid on the thread that calls sampleSpots().
+     * @return Frame extremes (valid == false for sources without frames)
+     */
+    const FrameExtremes& getFrameExtremes() const { return frame_extremes_; }
+    
+    /**
+     * @brief Set the areas measured on every sampled frame
+     * @param areas Validated areas; disabled ones are skipped
+     */
+    void setAreas(const std::vector<MeasurementArea>& areas);
+    
+    /**
+     * @brief Get the statistics of each enabled area over the last sampled frame
+     * 
+     * Only valid on the thread that calls sampleSpots().
+     * @return One reading per enabled area (empty for sources without frames)
+     */
+    const std::vector<AreaReading>& getAreaReadings() const { return area_readings_; }
+    
     /**
      * @brief Check if spot exists and is active
      * @param spotId Spot identifier to check
@@ -104,23 +260,30 @@ public:
     
     /**
      * @brief Get number of currently active spots
-     * @return Count of active spots (0-5)
+     * @return Count of active spots (0-MAX_SPOTS)
      */
     size_t getActiveSpotCount() const;
     
     /**
      * @brief Check if maximum spot limit is reached
-     * @return true if 5 spots are already active
+     * @return true if MAX_SPOTS spots are already active
      */
     bool isMaxSpotsReached() const;
     
     /**
      * @brief Validate spot ID format
      * @param spotId Spot ID to validate
-     * @return true if spotId is "1", "2", "3", "4", or "5"
+     * @return true if spotId is a decimal integer from 1 to MAX_SPOTS
      */
     static bool validateSpotId(const std::string& spotId);
     
+    /**
+     * @brief Convert spot ID string to its numeric form
+     * @param spotId Spot ID to parse
+     * @return Numeric ID, or 0 if spotId is not valid
+     */
+    static int parseSpotId(const std::string& spotId);
+    
     /**
      * @brief Validate coordinates for thermal image
      * @param x X coordinate
@@ -143,12 +306,78 @@ public:
     
 private:
     /**
-     * @brief Configure MeasurementSpot with temperature source data
-     * @param spot MeasurementSpot to configure
+     * @brief Create spot with a validated numeric ID; caller holds the exclusive lock
+     * @param id Spot ID (1 to MAX_SPOTS)
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @param config Spot whose measurement settings to copy, if any
+     * @return true if spot created successfully
+     */
+    bool createSpotWithId(int id, int x, int y, const MeasurementSpot* config = nullptr);
+    
+    /**
+     * @brief Build a configured spot ready for insertion
+     * @param id Spot ID
+     * @param x X coordinate (already validated)
+     * @param y Y coordinate (already validated)
+     * @param spot Output spot
+     * @param config Spot whose measurement settings to copy, if any
+     * @return true if the spot passes MeasurementSpot::validate()
+     */
+    bool buildSpot(int id, int x, int y, MeasurementSpot& spot, const MeasurementSpot* config = nullptr) const;
+    
+    /**
+     * @brief Record a spot change for takeChangedSpots(); caller holds the exclusive lock
+     */
+    void markChanged(int id);
+    
+    /**
+     * @brief Apply one change of a batch to a staged store; caller holds the exclusive lock
+     * @param store Staged copy of the spots
+     * @param change Change to apply
+     * @param spotId Output spot ID the change addressed
+     * @return APPLIED, or why the change failed (store unchanged)
+     */
+    SpotChangeStatus stageChange(SpotStore& store, const SpotChange& change, std::string& spotId) const;
+    
+    /**
+     * @brief spotExists() for a numeric ID; caller holds the lock
+     */
+    bool spotExistsLocked(int id) const { return isActive(spots_, id); }
+    
+    /**
+     * @brief Check that a store holds an enabled spot with this ID
+     */
+    static bool isActive(const SpotStore& store, int id);
+    
+    /**
+     * @brief listSpots(); caller holds the lock
+     */
+    std::vector<MeasurementSpot> listSpotsLocked() const;
+    
+    /**
+     * @brief Snapshot the spots and write them once the lock is released
+     * @param lock Held lock on mutex_; released before the file is written
+     * @return true if saving was successful
+     */
+    template <typename Lock>
+    bool persistAndUnlock(Lock& lock) const;
+    
+    /**
+     * @brief Write spots to the persistence file; caller holds persist_mutex_
+     * @param spots Spots to save
+     * @return true if saving was successful
+     */
+    bool writeSpots(const std::vector<MeasurementSpot>& spots) const;
+    
+    /**
+     * @brief Derive expected temperature range from the temperature source
      * @param x X coordinate
      * @param y Y coordinate
+     * @param min_temp Output minimum expected temperature
+     * @param max_temp Output maximum expected temperature
      */
-    void configureSpotWithTemperatureSource(MeasurementSpot& spot, int x, int y);
+    void computeTemperatureRange(int x, int y, double& min_temp, double& max_temp) const;
     
     /**
      * @brief Generate spot name from ID
@@ -42,6 +42,17 @@ public:
      */
     float getTemperature(int x, int y) override;
     
+    /**
+     * @brief Calculate temperatures for many coordinates with a SIMD kernel
+     * 
+     * Evaluates the distance-from-center model four points at a time; random
+     * variation is still drawn per point as in getTemperature().
+     * @param points Coordinates to sample
+     * @param count Number of points
+     * @param temperatures Output buffer receiving one value per point
+     */
+    void getTemperatures(const Point* points, size_t count, float* temperatures) override;
+    
     /**
      * @brief Check if source is ready (always true for coordinate-based)
      * @return true
@@ -79,6 +90,14 @@ private:
      */
     float calculateDistanceFromCenter(int x, int y) const;
     
+    /**
+     * @brief Vectorized base temperature for four coordinates
+     * @param xs Four X coordinates
+     * @param ys Four Y coordinates
+     * @param base_temps Output for four base temperatures
+     */
+    void calculateBaseTemperatures4(const float* xs, const float* ys, float* base_temps) const;
+    
     /**
      * @brief Generate random temperature variation
      * @return Random value between -0.5 and +0.5
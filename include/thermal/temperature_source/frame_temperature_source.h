@@ -0,0 +1,116 @@
+#pragma once
+
+#include "thermal/temperature_source/temperature_data_source.h"
+#include "thermal/frame/thermal_frame.h"
+#include <cstdint>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Frame-based temperature source for thermal simulation
+ * 
+ * Captures one full frame per cycle and serves every coordinate read from that
+ * buffer, so all spots sampled in the same cycle come from the same image. The
+ * simulated frame reuses the coordinate-based distance-from-center model with
+ * ±0.5°C per-pixel variation drawn once per capture.
+ */
+class FrameTemperatureSource : public TemperatureDataSource {
+public:
+    /**
+     * @brief Constructor (320x240 simulated frame)
+     */
+    FrameTemperatureSource();
+    
+    /**
+     * @brief Get temperature from the current frame
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @return Temperature in Celsius (captures a first frame if none exists yet)
+     */
+    float getTemperature(int x, int y) override;
+    
+    /**
+     * @brief Gather temperatures for many coordinates from the current frame
+     * @param points Coordinates to sample
+     * @param count Number of points
+     * @param temperatures Output buffer receiving one value per point
+     */
+    void getTemperatures(const Point* points, size_t count, float* temperatures) override;
+    
+    /**
+     * @brief Check if source is ready
+     * @return true once the frame buffer is allocated
+     */
+    bool isReady() const override;
+    
+    /**
+     * @brief Get source name
+     * @return "FrameTemperatureSource"
+     */
+    std::string getSourceName() const override;
+    
+    /**
+     * @brief Validate coordinates against frame dimensions
+     * @param x X coordinate to validate
+     * @param y Y coordinate to validate
+     * @return true if coordinates are inside the frame
+     */
+    bool validateCoordinates(int x, int y) const override;
+    
+    /**
+     * @brief Get base temperature without per-frame variation
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @return Base temperature of the simulated scene
+     */
+    float getBaseTemperature(int x, int y) const override;
+    
+    /**
+     * @brief Capture a new frame into the internal buffer
+     * @return true if the frame was captured
+     */
+    bool captureFrame() override;
+    
+    /**
+     * @brief Get the most recently captured frame
+     * @return Pointer to current frame (nullptr before the first capture)
+     */
+    const ThermalFrame* getCurrentFrame() const override;
+    
+protected:
+    // Returned for out-of-frame reads and before the first capture
+    static constexpr float DEFAULT_TEMPERATURE = 20.0f;
+    
+    /**
+     * @brief Constructor for derived frame producers
+     * @param width Frame width in pixels
+     * @param height Frame height in pixels
+     */
+    FrameTemperatureSource(int width, int height);
+    
+    /**
+     * @brief Fill the frame buffer with a new image
+     * @param frame Pre-sized frame to populate (sequence/timestamp are set by caller)
+     * @return true if the frame was produced
+     */
+    virtual bool renderFrame(ThermalFrame& frame);
+    
+private:
+    ThermalFrame frame_;
+    std::uint64_t next_sequence_ = 1;
+    
+    // Simulated scene: static base temperatures plus per-capture noise
+    std::vector<float> base_temperatures_;
+    std::uint32_t noise_state_;
+    
+    static constexpr float VARIATION_RANGE = 0.5f; // ±0.5°C random variation
+    
+    /**
+     * @brief Generate next pseudo-random variation in [-0.5, +0.5)
+     * @return Random variation in Celsius
+     */
+    float nextVariation();
+};
+
+} // namespace thermal
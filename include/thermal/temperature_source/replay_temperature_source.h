@@ -0,0 +1,111 @@
+#pragma once
+
+#include "thermal/temperature_source/frame_temperature_source.h"
+#include "thermal/frame/radiometric_converter.h"
+#include "utils/mapped_file.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace thermal {
+
+/**
+ * @brief Settings for replaying a recorded raw frame file
+ */
+struct ReplayOptions {
+    std::string file_path;                      // Headerless sequence of raw frames
+    int width = ThermalFrame::DEFAULT_WIDTH;    // Frame width in pixels
+    int height = ThermalFrame::DEFAULT_HEIGHT;  // Frame height in pixels
+    double playback_fps = 0.0;                  // Frames per second, 0 = as fast as possible
+    bool loop = true;                           // Restart at the first frame after the last
+    RadiometricCalibration calibration;         // Count-to-temperature calibration
+
+    /**
+     * @brief Read options from THERMAL_REPLAY_FILE, THERMAL_REPLAY_WIDTH,
+     *        THERMAL_REPLAY_HEIGHT, THERMAL_REPLAY_FPS and THERMAL_REPLAY_LOOP
+     * @return Options with unset variables left at their defaults
+     */
+    static ReplayOptions fromEnvironment();
+};
+
+/**
+ * @brief Frame source that replays recorded raw 16-bit radiometric frames
+ *
+ * The recording is memory-mapped, so frames are never read through stream
+ * buffers: getCurrentRawFrame() points straight into the mapping and each
+ * capture converts the counts of one frame into the float frame buffer
+ * through the RadiometricConverter lookup table.
+ * Samples are little-endian uint16 counts, row-major, frames back to back.
+ *
+ * With playback_fps > 0 the frame shown is chosen from wall-clock time since
+ * the first capture (frames are skipped if captures are slower); with 0 every
+ * capture advances exactly one frame, which is what benchmarks want.
+ */
+class ReplayTemperatureSource : public FrameTemperatureSource {
+public:
+    /**
+     * @brief Constructor
+     * @param options Replay settings
+     * @throws std::invalid_argument if dimensions or rate are invalid
+     * @throws std::runtime_error if the file cannot be mapped or holds no whole frame
+     */
+    explicit ReplayTemperatureSource(const ReplayOptions& options);
+
+    /**
+     * @brief Get source name
+     * @return "ReplayTemperatureSource"
+     */
+    std::string getSourceName() const override;
+
+    /**
+     * @brief Get temperature of the current frame (recordings have no separate base scene)
+     * @param x X coordinate
+     * @param y Y coordinate
+     * @return Current temperature, or 20°C before the first capture
+     */
+    float getBaseTemperature(int x, int y) const override;
+
+    /**
+     * @brief Get raw counts of the current frame without copying
+     * @return Pointer into the mapped file (width * height samples), nullptr before the first capture
+     */
+    const std::uint16_t* getCurrentRawFrame() const;
+
+    /**
+     * @brief Get number of whole frames in the recording
+     */
+    size_t getFrameCount() const { return frame_count_; }
+
+    /**
+     * @brief Get index of the current frame within the recording
+     */
+    size_t getCurrentFrameIndex() const { return current_index_; }
+
+protected:
+    /**
+     * @brief Convert the next recorded frame into the frame buffer
+     * @param frame Pre-sized frame to populate
+     * @return false once a non-looping recording is exhausted
+     */
+    bool renderFrame(ThermalFrame& frame) override;
+
+private:
+    ReplayOptions options_;
+    utils::MappedFile file_;
+    RadiometricConverter converter_;
+    size_t frame_pixels_;
+    size_t frame_count_;
+
+    size_t current_index_ = 0;
+    std::uint64_t captures_ = 0;
+    std::chrono::steady_clock::time_point playback_start_;
+
+    /**
+     * @brief Pick the recording index for the next capture
+     * @param index Output frame index
+     * @return false if a non-looping recording has no frame left
+     */
+    bool nextFrameIndex(size_t& index);
+};
+
+} // namespace thermal
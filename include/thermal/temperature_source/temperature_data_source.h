@@ -1,9 +1,20 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 namespace thermal {
 
+struct ThermalFrame;
+
+/**
+ * @brief Pixel coordinate in the thermal image
+ */
+struct Point {
+    int x = 0;
+    int y = 0;
+};
+
 /**
  * @brief Abstract interface for temperature data sources
  * 
@@ -23,6 +34,17 @@ public:
      */
     virtual float getTemperature(int x, int y) = 0;
     
+    /**
+     * @brief Calculate temperatures for many coordinates in one call
+     * 
+     * The default implementation calls getTemperature() per point; sources
+     * that can vectorize the lookup override it.
+     * @param points Coordinates to sample
+     * @param count Number of points
+     * @param temperatures Output buffer receiving one value per point
+     */
+    virtual void getTemperatures(const Point* points, size_t count, float* temperatures);
+    
     /**
      * @brief Check if the data source is ready to provide temperatures
      * @return true if source can provide temperature data
@@ -50,6 +72,21 @@ public:
      * @return Base temperature for coordinate-based calculation
      */
     virtual float getBaseTemperature(int x, int y) const = 0;
+    
+    /**
+     * @brief Capture a new frame so subsequent reads share one instant
+     * 
+     * Frame-based sources refresh their buffer here; per-pixel sources have
+     * nothing to capture and keep the default no-op.
+     * @return true if the source is ready to serve the new cycle
+     */
+    virtual bool captureFrame();
+    
+    /**
+     * @brief Get the most recently captured frame
+     * @return Pointer to the current frame, or nullptr if the source is not frame-based
+     */
+    virtual const ThermalFrame* getCurrentFrame() const;
 };
 
 } // namespace thermal
\ No newline at end of file
@@ -6,6 +6,8 @@
 
 namespace thermal {
 
+struct ReplayOptions;
+
 /**
  * @brief Factory for creating temperature data source instances
  * 
@@ -19,6 +21,8 @@ public:
      */
     enum class SourceType {
         COORDINATE_BASED,  // Current coordinate-based simulation
+        FRAME_BASED,       // Full-frame simulation, one capture per cycle
+        FILE_REPLAY,       // Recorded raw frames, configured via THERMAL_REPLAY_* environment
         REMOTE_HTTP,       // Future: HTTP API integration
         REMOTE_MQTT        // Future: MQTT data stream integration
     };
@@ -37,6 +41,13 @@ public:
      */
     static std::unique_ptr<TemperatureDataSource> createSource(const std::string& type_str);
     
+    /**
+     * @brief Create a replay source for a recorded raw frame file
+     * @param options Replay settings
+     * @return Unique pointer to temperature data source
+     */
+    static std::unique_ptr<TemperatureDataSource> createReplaySource(const ReplayOptions& options);
+    
     /**
      * @brief Get default temperature source (coordinate-based)
      * @return Unique pointer to default temperature data source
@@ -1,11 +1,27 @@
 #pragma once
 
 #include "mqtt/paho_c_client.h"
+#include "mqtt/topic_router.h"
 #include "config/configuration.h"
 #include "thermal/rpc/thermal_rpc_handler.h"
+#include "thermal/frame/hotspot_finder.h"
+#include "thermal/frame/region_analyzer.h"
+#include "thermal/temperature_reading.h"
 #include "thingsboard/rpc/rpc_parser.h"
+#include "thingsboard/rpc/rpc_engine.h"
+#include "thingsboard/telemetry_window.h"
+#include "thingsboard/telemetry_encoder.h"
+#include "thingsboard/protobuf_encoder.h"
+#include "thingsboard/telemetry_journal.h"
+#include "thingsboard/telemetry_publisher.h"
+#include "common/executor.h"
+#include "common/metrics.h"
 #include <memory>
 #include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string_view>
+#include <vector>
 
 namespace thermal {
 
@@ -22,6 +38,38 @@ private:
     std::shared_ptr<thermal::ThermalRPCHandler> thermal_rpc_handler_;
     std::unique_ptr<thermal::RPCParser> rpc_parser_;
     
+    // Worker for RPC responses, subscriptions and journaling; a single thread
+    // runs the tasks in submission order
+    static constexpr size_t WORKER_THREADS = 1;
+    std::unique_ptr<Executor> executor_;
+    
+    // Runs parsed RPC commands concurrently and enforces their timeouts
+    static constexpr size_t RPC_WORKER_THREADS = 4;
+    std::unique_ptr<RPCEngine> rpc_engine_;
+    TelemetryWindow upload_window_;
+    
+    // Payload encoders reused across readings; the build_* helpers are const
+    bool protobuf_payloads_ = false;  // payload_format "protobuf"
+    mutable TelemetryEncoder encoder_;
+    mutable ProtobufTelemetryEncoder protobuf_encoder_;
+    mutable std::mutex encoder_mutex_;
+    
+    // Store-and-forward journal and the token bucket pacing its backfill
+    static constexpr size_t BACKFILL_MAX_RECORDS = 256;
+    std::unique_ptr<TelemetryJournal> journal_;
+    std::mutex journal_mutex_;  // Journal is shared with the publisher thread
+    double backfill_rate_ = 0.0;
+    size_t backfill_max_bytes_ = TelemetryWindow::DEFAULT_MAX_PAYLOAD_BYTES;
+    double backfill_tokens_ = 0.0;
+    std::chrono::steady_clock::time_point last_backfill_;
+    std::vector<JournalRecord> backfill_records_;
+    
+    // Publisher thread; telemetry is published inline when not started
+    std::unique_ptr<TelemetryPublisher> publisher_;
+    
+    // Inbound message routes, matched by topic prefix
+    TopicRouter topic_router_;
+    
 public:
     /**
      * @brief Construct ThingsBoard device
@@ -65,10 +113,129 @@ public:
      * @param spot_id Measurement spot identifier
      * @param temperature Temperature reading in Celsius
      * @param timestamp Timestamp for the reading
+     * @param extremes Optional frame hotspot/coldspot published in the same message
      * @return true if telemetry was sent successfully
      */
     bool send_telemetry(int spot_id, double temperature,
-                       std::chrono::time_point<std::chrono::system_clock> timestamp);
+                       std::chrono::time_point<std::chrono::system_clock> timestamp,
+                       const FrameExtremes* extremes = nullptr);
+    
+    /**
+     * @brief Send all readings of one sampling instant in a single message
+     * 
+     * Publishes one {"ts":..., "values":{...}} payload stamped with the first
+     * reading's timestamp. Readings outside the valid range are left out.
+     * @param readings Readings to send (typically from ThermalSpotManager::sampleSpots())
+     * @param count Number of readings
+     * @param extremes Optional frame hotspot/coldspot added to the same message
+     * @return true if the message was published
+     */
+    bool send_telemetry_batch(const TemperatureReading* readings, size_t count,
+                              const FrameExtremes* extremes = nullptr);
+    
+    /**
+     * @brief Send frame-wide hotspot/coldspot telemetry on its own
+     * @param extremes Frame extremes (ignored if not valid)
+     * @param timestamp Capture timestamp of the frame
+     * @return true if telemetry was sent successfully
+     */
+    bool send_frame_extremes(const FrameExtremes& extremes,
+                             std::chrono::time_point<std::chrono::system_clock> timestamp);
+    
+    /**
+     * @brief Send measurement area statistics of one frame in a single message
+     * 
+     * In windowed mode the message is added to the upload window instead.
+     * Areas without valid statistics are left out.
+     * @param areas Area readings (typically from ThermalSpotManager::getAreaReadings())
+     * @param count Number of areas
+     * @param timestamp Capture timestamp of the frame
+     * @return true if the message was published or queued
+     */
+    bool send_area_telemetry(const AreaReading* areas, size_t count,
+                             std::chrono::time_point<std::chrono::system_clock> timestamp);
+    
+    /**
+     * @brief Configure windowed uploads
+     * @param window Upload window length (0 = disabled)
+     * @param max_payload_bytes Largest JSON array published at once
+     */
+    void set_upload_window(std::chrono::milliseconds window, size_t max_payload_bytes);
+    
+    /**
+     * @brief Check if windowed uploads are enabled
+     */
+    bool upload_window_enabled() const { return upload_window_.enabled(); }
+    
+    /**
+     * @brief Add the readings of one sampling instant to the upload window
+     * 
+     * The readings are encoded as one {"ts":..., "values":{...}} entry, the
+     * same shape send_telemetry_batch() publishes. Once the window elapses or
+     * a payload reaches the byte limit, the accumulated entries are published
+     * as JSON arrays through flush_telemetry_window().
+     * @param readings Readings to queue
+     * @param count Number of readings
+     * @param extremes Optional frame hotspot/coldspot added to the entry
+     * @return false if nothing was queued or a triggered flush failed
+     */
+    bool queue_telemetry(const TemperatureReading* readings, size_t count,
+                         const FrameExtremes* extremes = nullptr);
+    
+    /**
+     * @brief Publish everything accumulated in the upload window
+     * @return true if every payload was published (or there was nothing to send)
+     */
+    bool flush_telemetry_window();
+    
+    /**
+     * @brief Journal telemetry that cannot be published and backfill it later
+     * 
+     * Once set, every telemetry payload that fails to publish (including while
+     * disconnected) is appended to the journal instead of being lost.
+     * @param journal Journal to write to
+     * @param backfill_messages_per_second Replay rate once connected again
+     * @param backfill_max_bytes Largest merged backfill message
+     */
+    void set_journal(std::unique_ptr<TelemetryJournal> journal,
+                     double backfill_messages_per_second, size_t backfill_max_bytes);
+    
+    /**
+     * @brief Replay journaled telemetry in append order within the backfill rate
+     * 
+     * Call periodically from the main loop. Journaled records are merged into
+     * JSON array messages of up to backfill_max_bytes. Unacknowledged publishes
+     * are journaled late, so messages are not in timestamp order; every reading
+     * carries its own ts.
+     * @return Number of journal records replayed by this call
+     */
+    size_t backfill_journal();
+    
+    /**
+     * @brief Get the journal, nullptr if journaling is disabled
+     */
+    const TelemetryJournal* get_journal() const { return journal_.get(); }
+    
+    /**
+     * @brief Move telemetry publishing onto a dedicated thread
+     * 
+     * Afterwards the send_* methods only encode and enqueue, returning true
+     * once the message is queued. Failed publishes are still journaled.
+     * disconnect() drains the queue and returns to inline publishing.
+     * @param capacity Queue capacity in messages
+     * @param policy Behaviour when the queue is full
+     */
+    void start_publisher(size_t capacity, OverflowPolicy policy);
+    
+    /**
+     * @brief Get publish queue counters (all zero when publishing inline)
+     */
+    PublisherStats get_publisher_stats() const;
+    
+    /**
+     * @brief Get RPC engine counters
+     */
+    RPCEngineStats get_rpc_stats() const;
     
     /**
      * @brief Get MQTT client statistics
@@ -76,6 +243,17 @@ public:
      */
     const MQTTClientStats& get_connection_stats() const;
     
+    /**
+     * @brief Get publish acknowledgement counters and the unacknowledged backlog
+     */
+    InFlightStats get_delivery_stats() const;
+    
+    /**
+     * @brief Append connection, publish queue and RPC counters for metrics export
+     * @param metrics Snapshots to append to
+     */
+    void collect_metrics(std::vector<MetricSnapshot>& metrics) const;
+    
     /**
      * @brief Enable/disable automatic reconnection
      * @param enable Whether to enable auto-reconnect
@@ -110,6 +288,13 @@ public:
      */
     void on_message_received(const std::string& topic, const std::string& payload) override;
     
+    /**
+     * @brief Route a received message by topic prefix without copying it
+     * @param topic Topic the message was received on
+     * @param payload Message payload, valid only during the call
+     */
+    void on_message_view(std::string_view topic, std::string_view payload) override;
+    
 private:
     std::string build_server_uri() const;
     std::string build_client_id() const;
@@ -118,24 +303,62 @@ private:
     std::string build_telemetry_payload(int spot_id, double temperature) const;
     std::string build_telemetry_payload_with_timestamp(
         int spot_id, double temperature,
+        std::chrono::time_point<std::chrono::system_clock> timestamp,
+        const FrameExtremes* extremes = nullptr) const;
+    std::string build_telemetry_batch_payload(
+        const TemperatureReading* readings, size_t count,
+        const FrameExtremes* extremes) const;
+    std::string build_frame_extremes_payload(
+        const FrameExtremes& extremes,
+        std::chrono::time_point<std::chrono::system_clock> timestamp) const;
+    std::string build_area_payload(
+        const AreaReading* areas, size_t count,
         std::chrono::time_point<std::chrono::system_clock> timestamp) const;
     bool validate_temperature(double temperature) const;
+    
+    /**
+     * @brief Encoder for the configured payload format; caller holds encoder_mutex_
+     */
+    TelemetryPayloadEncoder& payload_encoder() const;
+    
+    /**
+     * @brief Hand a telemetry payload to the publisher thread, or publish it inline
+     * @param payload Encoded telemetry payload
+     * @param timestamp_ms Timestamp recorded with the journaled payload
+     * @return true if the payload was queued or published
+     */
+    bool publish_telemetry(std::string payload, std::int64_t timestamp_ms);
+    
+    /**
+     * @brief Publish a telemetry payload now, journaling it if that fails
+     * @param payload Encoded telemetry payload
+     * @param timestamp_ms Timestamp recorded with the journaled payload
+     * @return true if the payload was published
+     */
+    bool publish_telemetry_now(const std::string& payload, std::int64_t timestamp_ms);
+    
+    /**
+     * @brief Completion callback journaling a payload the broker never acknowledged
+     * @return nullptr when journaling is disabled
+     */
+    DeliveryCallback journal_if_undelivered(const std::string& payload, std::int64_t timestamp_ms);
+    
     std::string format_timestamp(
         std::chrono::time_point<std::chrono::system_clock> timestamp) const;
         
     /**
-     * @brief Handle RPC command received via MQTT
-     * @param topic RPC topic that contained the command
+     * @brief Parse and validate an RPC command and hand it to the RPC engine
+     * @param request_id Request ID, the RPC topic after its prefix
      * @param payload RPC command JSON payload
      */
-    void handle_rpc_command(const std::string& topic, const std::string& payload);
+    void handle_rpc_command(std::string_view request_id, std::string_view payload);
     
     /**
-     * @brief Extract request ID from RPC topic
-     * @param rpc_topic Full RPC topic path
-     * @return Request ID or empty string if invalid
+     * @brief Send an RPC response from a worker (inline while shutting down)
+     * @param request_id Request ID from the RPC command
+     * @param response JSON response payload
      */
-    std::string extract_request_id(const std::string& rpc_topic) const;
+    void queue_rpc_response(const std::string& request_id, const std::string& response);
 };
 
 } // namespace thermal
\ No newline at end of file
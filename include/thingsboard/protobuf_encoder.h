@@ -0,0 +1,55 @@
+#pragma once
+
+#include "thingsboard/telemetry_encoder.h"
+#include <cstdint>
+#include <string>
+
+namespace thermal {
+
+/**
+ * @brief Writes telemetry in the Protobuf wire format of config/proto/telemetry.proto
+ *
+ * Hand-rolled encoder for ThingsBoard device profiles with the Protobuf
+ * payload type. Each payload is one TelemetryEntry: ts plus a Values
+ * message in which spot N is field N (fixed64 double), the frame
+ * extremes sit at FRAME_FIELD_BASE + 1..6 and area N at
+ * AREA_FIELD_BASE + (N - 1) * AREA_FIELD_STRIDE + 1..5. A repeated spot is written
+ * twice, and Protobuf parsers keep the last value, matching the JSON path.
+ * Non-finite temperatures are left out, as JSON null carries no value either.
+ */
+class ProtobufTelemetryEncoder : public TelemetryPayloadEncoder {
+public:
+    static constexpr int FRAME_FIELD_BASE = 10000;
+    static constexpr int AREA_FIELD_BASE = 20000;
+    static constexpr int AREA_FIELD_STRIDE = 10;
+
+    ProtobufTelemetryEncoder();
+
+    void begin(std::int64_t timestamp_ms) override;
+
+    /**
+     * @brief Add a spot value; IDs outside 1 to FRAME_FIELD_BASE - 1 are skipped
+     */
+    void addSpot(int spot_id, double temperature) override;
+    void addFrameExtremes(const FrameExtremes& extremes) override;
+
+    /**
+     * @brief Add an area's values; IDs outside 1 to MAX_MEASUREMENT_AREAS are skipped
+     */
+    void addArea(int area_id, const AreaStatistics& statistics) override;
+    const std::string& finish() override;
+
+    /**
+     * @brief Wrap a JSON RPC response in ThingsBoard's RpcResponseMsg
+     * @param response JSON response text, carried as the payload string
+     * @return Serialized RpcResponseMsg (config/proto/rpc_response.proto)
+     */
+    static std::string encodeRpcResponse(const std::string& response);
+
+private:
+    std::string buffer_;
+    std::string values_;  // Values message, length-prefixed into buffer_ by finish()
+    std::int64_t timestamp_ms_ = 0;
+};
+
+} // namespace thermal
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "thingsboard/rpc/rpc_command_queue.h"
+#include "thingsboard/rpc/rpc_types.h"
+#include "common/executor.h"
+#include "common/metrics.h"
+#include "common/timer_wheel.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Counters of the RPC engine
+ */
+struct RPCEngineStats {
+    size_t in_flight = 0;             // Commands accepted and not yet answered
+    std::uint64_t submitted = 0;      // Commands accepted
+    std::uint64_t completed = 0;      // Commands executed
+    std::uint64_t timed_out = 0;      // TIMEOUT responses sent
+    std::uint64_t skipped = 0;        // Commands not executed because they had timed out
+    std::uint64_t rejected_busy = 0;  // Commands refused by admission control
+};
+
+/**
+ * @brief Admission limits; a command over any of them is refused as busy
+ */
+struct RPCAdmissionLimits {
+    size_t max_queue_depth = 64;         // Commands waiting for a worker
+    size_t max_pending_per_method = 16;  // Commands of one method queued or running
+    double rate_per_second = 20.0;       // Token bucket refill rate (0 = unlimited)
+    double burst = 40.0;                 // Token bucket size
+};
+
+/**
+ * @brief Outcome of RPCEngine::submit()
+ */
+enum class RPCAdmission {
+    ACCEPTED,  // Queued; answered by the command or by TIMEOUT
+    BUSY,      // Over an admission limit; caller answers CAMERA_BUSY
+    REJECTED   // Shutting down or duplicate request ID; not answered
+};
+
+/**
+ * @brief Concurrent executor for parsed RPC commands with deadline enforcement
+ *
+ * Read-only methods (listSpotMeasurements, getSpotTemperature) run in parallel
+ * on the worker pool. Mutations are serialized per spot: each spot has a lane
+ * (an RPCCommandQueue) that runs one command at a time in arrival order, and
+ * creates without a spotId share a lane of their own. A spot batch may touch
+ * any spot, so it waits until every lane has drained and holds back mutations
+ * that arrive after it until it has finished.
+ *
+ * Every command's timeoutMs is armed on a timer wheel. When it expires first,
+ * the engine answers with the TIMEOUT error and the command's own response is
+ * dropped; a command still queued at that point is not executed at all.
+ * Responses pass through claimResponse(), which grants each request exactly
+ * one answer.
+ *
+ * Admission is bounded by a token bucket, a per-method limit on queued plus
+ * running commands and a maximum queue depth. Refused commands are not queued
+ * at all, so a burst of calls costs a fast CAMERA_BUSY instead of a backlog.
+ */
+class RPCEngine {
+public:
+    using ExecuteFunction = std::function<void(const RPCCommand& command)>;
+    using TimeoutFunction = std::function<void(const RPCResponse& response)>;
+
+    // Timer wheel resolution and size (covers the 30 s maximum timeout in one turn)
+    static constexpr std::chrono::milliseconds TIMER_TICK{10};
+    static constexpr size_t TIMER_SLOTS = 4096;
+
+    // Bounds of the retry-after hint given with BUSY
+    static constexpr int MIN_RETRY_AFTER_MS = 100;
+    static constexpr int MAX_RETRY_AFTER_MS = 30000;
+
+    /**
+     * @brief Constructor, starts the workers and the timer thread
+     * @param workers Number of worker threads
+     * @param execute Runs a command on a worker; responds through the caller's own path
+     * @param on_timeout Sends the TIMEOUT response, called on the timer thread
+     * @param limits Admission limits
+     */
+    RPCEngine(size_t workers, ExecuteFunction execute, TimeoutFunction on_timeout,
+              const RPCAdmissionLimits& limits = RPCAdmissionLimits());
+
+    /**
+     * @brief Destructor, equivalent to shutdown()
+     */
+    ~RPCEngine();
+
+    RPCEngine(const RPCEngine&) = delete;
+    RPCEngine& operator=(const RPCEngine&) = delete;
+
+    /**
+     * @brief Admit and queue a command; its deadline runs from now
+     * @param command Parsed and validated command
+     * @param retry_after_ms Set to a suggested client back-off when BUSY
+     * @return Whether the command was queued
+     */
+    RPCAdmission submit(RPCCommand command, int* retry_after_ms = nullptr);
+
+    /**
+     * @brief Take the right to answer a request
+     * @param request_id Request being answered
+     * @return true exactly once per in-flight request; false once it timed out or was answered
+     */
+    bool claimResponse(const std::string& request_id);
+
+    /**
+     * @brief Stop accepting commands, run the queued ones and stop the threads
+     *
+     * Waits for mutations held behind a spot batch before stopping the workers.
+     */
+    void shutdown();
+
+    /**
+     * @brief Snapshot of the counters
+     */
+    RPCEngineStats getStats() const;
+
+    /**
+     * @brief Check whether a method only reads spot state
+     */
+    static bool isReadOnly(RPCMethod method);
+
+    /**
+     * @brief Lane a mutation is serialized on ("" for creates without spotId)
+     */
+    static std::string laneKey(const RPCCommand& command);
+
+private:
+    struct InFlight {
+        std::uint64_t token;  // Timer wheel ID of the request's deadline
+        int timeout_ms;
+        RPCMethod method;
+        TimerWheel::Clock::time_point submitted_at;
+    };
+
+    ExecuteFunction execute_;
+    TimeoutFunction on_timeout_;
+    RPCAdmissionLimits limits_;
+    size_t workers_;
+
+    mutable std::mutex mutex_;
+    bool accepting_ = true;
+    std::uint64_t next_token_ = 1;
+    std::unordered_map<std::string, InFlight> in_flight_;
+    std::unordered_map<std::uint64_t, std::string> token_requests_;
+    std::unordered_map<std::string, RPCCommandQueue> lanes_;
+    std::deque<RPCCommand> held_;      // Mutations from a waiting spot batch on, in arrival order
+    bool batch_running_ = false;
+    std::condition_variable released_;  // Signalled when held_ drains and no batch runs
+
+    // Admission state
+    size_t queued_ = 0;                       // Accepted, not yet started
+    std::map<RPCMethod, size_t> pending_;     // Accepted, not yet finished, per method
+    double tokens_ = 0.0;
+    TimerWheel::Clock::time_point last_refill_;
+    double average_run_ms_ = 0.0;             // Moving average of execution time
+
+    TimerWheel wheel_;
+    std::condition_variable timer_wake_;
+    bool timer_running_ = true;
+    std::thread timer_thread_;
+
+    std::uint64_t submitted_ = 0;
+    std::uint64_t completed_ = 0;
+    std::uint64_t timed_out_ = 0;
+    std::uint64_t skipped_ = 0;
+    std::uint64_t rejected_busy_ = 0;
+
+    // Metrics, owned by MetricsRegistry
+    Gauge& queue_depth_;
+    std::map<RPCMethod, Histogram*> latency_;  // Submit-to-response time per method
+
+    // Declared last: workers must stop before the state above goes away
+    std::unique_ptr<Executor> executor_;
+
+    /**
+     * @brief Check the admission limits for one more command; caller holds mutex_
+     * @param method Method of the command
+     * @param retry_after_ms Set to the back-off hint when refused
+     * @return true if the command may be queued
+     */
+    bool admitLocked(RPCMethod method, int& retry_after_ms);
+
+    /**
+     * @brief End-to-end latency histogram of a method; caller holds mutex_
+     */
+    Histogram& latencyLocked(RPCMethod method);
+
+    /**
+     * @brief Start a mutation on its lane, or a batch on its own; caller holds mutex_
+     */
+    void startLocked(RPCCommand command);
+
+    /**
+     * @brief Start held mutations up to the next batch that still has to wait; caller holds mutex_
+     */
+    void releaseHeldLocked();
+
+    void run(const RPCCommand& command);
+    void runLane(const std::string& key, RPCCommand command);
+    void runBatch(const RPCCommand& command);
+    void timerLoop();
+};
+
+} // namespace thermal
@@ -2,6 +2,7 @@
 
 #include "thingsboard/rpc/rpc_types.h"
 #include <string>
+#include <string_view>
 #include <nlohmann/json.hpp>
 
 namespace thermal {
@@ -15,55 +16,88 @@ namespace thermal {
 class RPCParser {
 public:
     /**
-     * @brief Parse RPC command from JSON string
+     * @brief Error message for spot IDs outside the supported range
+     */
+    static const std::string INVALID_SPOT_ID_MESSAGE;
+    
+    /**
+     * @brief Most operations accepted in one applySpotBatch (enough to delete
+     * and recreate every spot)
+     */
+    static const size_t MAX_BATCH_OPERATIONS;
+    
+    /**
+     * @brief Parse an RPC command and validate it in a single pass
      * @param request_id Request ID from MQTT topic
      * @param json_payload JSON payload from MQTT message
-     * @return Parsed RPCCommand structure
+     * @return Command with typed arguments, or with status ERROR and error set
      */
-    static RPCCommand parseCommand(const std::string& request_id, const std::string& json_payload);
+    static RPCCommand parseCommand(std::string_view request_id, std::string_view json_payload);
     
     /**
-     * @brief Validate RPC command parameters
-     * @param command Command to validate
+     * @brief Validation result recorded by parseCommand
+     * @param command Command to check
      * @return Empty string if valid, error message if invalid
      */
     static std::string validateCommand(const RPCCommand& command);
     
+    /**
+     * @brief Extract and validate the parameters of a method
+     * @param method RPC method the parameters belong to
+     * @param params JSON parameters object
+     * @param arguments Output typed arguments (monostate for an unknown method)
+     * @return Empty string if valid, error message if invalid
+     */
+    static std::string parseArguments(RPCMethod method, const nlohmann::json& params, RPCArguments& arguments);
+    
     /**
      * @brief Parse createSpotMeasurement parameters
      * @param params JSON parameters object
-     * @param spotId Output parameter for spot ID
-     * @param x Output parameter for X coordinate
-     * @param y Output parameter for Y coordinate
+     * @param args Output arguments (spotId empty if omitted, to be auto-assigned)
      * @return Empty string if valid, error message if invalid
      */
-    static std::string parseCreateSpotParams(const nlohmann::json& params, 
-                                           std::string& spotId, int& x, int& y);
+    static std::string parseCreateSpotParams(const nlohmann::json& params, CreateSpotArgs& args);
     
     /**
      * @brief Parse moveSpotMeasurement parameters
      * @param params JSON parameters object
-     * @param spotId Output parameter for spot ID
-     * @param x Output parameter for new X coordinate
-     * @param y Output parameter for new Y coordinate
+     * @param args Output arguments
      * @return Empty string if valid, error message if invalid
      */
-    static std::string parseMoveSpotParams(const nlohmann::json& params,
-                                         std::string& spotId, int& x, int& y);
+    static std::string parseMoveSpotParams(const nlohmann::json& params, MoveSpotArgs& args);
     
     /**
      * @brief Parse deleteSpotMeasurement parameters
      * @param params JSON parameters object
-     * @param spotId Output parameter for spot ID
+     * @param args Output arguments
+     * @return Empty string if valid, error message if invalid
+     */
+    static std::string parseDeleteSpotParams(const nlohmann::json& params, DeleteSpotArgs& args);
+    
+    /**
+     * @brief Parse getSpotTemperature parameters
+     * @param params JSON parameters object
+     * @param args Output arguments
      * @return Empty string if valid, error message if invalid
      */
-    static std::string parseDeleteSpotParams(const nlohmann::json& params,
-                                           std::string& spotId);
+    static std::string parseGetTemperatureParams(const nlohmann::json& params, GetSpotTemperatureArgs& args);
+    
+    /**
+     * @brief Parse applySpotBatch parameters
+     * 
+     * Expects {"operations": [{"op": "create"|"move"|"delete", ...}, ...]} where
+     * each operation carries the parameters of the matching single-spot method.
+     * @param params JSON parameters object
+     * @param args Output arguments
+     * @return Empty string if every operation is valid, else the first error
+     *         prefixed with the operation's index
+     */
+    static std::string parseSpotBatchParams(const nlohmann::json& params, ApplySpotBatchArgs& args);
     
     /**
      * @brief Validate spot ID format
      * @param spotId Spot ID to validate
-     * @return true if spotId is "1", "2", "3", "4", or "5"
+     * @return true if spotId is a decimal integer from 1 to MAX_MEASUREMENT_SPOTS
      */
     static bool validateSpotId(const std::string& spotId);
     
@@ -89,7 +123,17 @@ private:
      * @param result Output JSON object
      * @return true if parsing succeeded
      */
-    static bool parseJsonSafely(const std::string& json_str, nlohmann::json& result);
+    static bool parseJsonSafely(std::string_view json_str, nlohmann::json& result);
+    
+    /**
+     * @brief Parse the required, valid spotId parameter
+     */
+    static std::string parseSpotId(const nlohmann::json& params, std::string& spotId);
+    
+    /**
+     * @brief Parse the required x and y parameters and check their bounds
+     */
+    static std::string parseCoordinates(const nlohmann::json& params, int& x, int& y);
     
     /**
      * @brief Extract required string parameter
@@ -98,7 +142,7 @@ private:
      * @param value Output string value
      * @return true if parameter exists and is a string
      */
-    static bool extractStringParam(const nlohmann::json& params, const std::string& key, std::string& value);
+    static bool extractStringParam(const nlohmann::json& params, const char* key, std::string& value);
     
     /**
      * @brief Extract required integer parameter
@@ -107,7 +151,7 @@ private:
      * @param value Output integer value
      * @return true if parameter exists and is an integer
      */
-    static bool extractIntParam(const nlohmann::json& params, const std::string& key, int& value);
+    static bool extractIntParam(const nlohmann::json& params, const char* key, int& value);
 };
 
 } // namespace thermal
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include <string>
 #include <chrono>
+#include <variant>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 namespace thermal {
@@ -26,16 +28,73 @@ enum class RPCMethod {
     DELETE_SPOT_MEASUREMENT,
     LIST_SPOT_MEASUREMENTS,
     GET_SPOT_TEMPERATURE,
+    APPLY_SPOT_BATCH,
     UNKNOWN
 };
 
+/**
+ * @brief Validated parameters of createSpotMeasurement
+ */
+struct CreateSpotArgs {
+    std::string spotId;  // Empty to have a free ID assigned
+    int x = 0;
+    int y = 0;
+};
+
+/**
+ * @brief Validated parameters of moveSpotMeasurement
+ */
+struct MoveSpotArgs {
+    std::string spotId;
+    int x = 0;
+    int y = 0;
+};
+
+/**
+ * @brief Validated parameters of deleteSpotMeasurement
+ */
+struct DeleteSpotArgs {
+    std::string spotId;
+};
+
+/**
+ * @brief listSpotMeasurements takes no parameters
+ */
+struct ListSpotsArgs {};
+
+/**
+ * @brief Validated parameters of getSpotTemperature
+ */
+struct GetSpotTemperatureArgs {
+    std::string spotId;
+};
+
+/**
+ * @brief One operation of applySpotBatch
+ */
+using SpotOperation = std::variant<CreateSpotArgs, MoveSpotArgs, DeleteSpotArgs>;
+
+/**
+ * @brief Validated parameters of applySpotBatch, in the order to apply them
+ */
+struct ApplySpotBatchArgs {
+    std::vector<SpotOperation> operations;
+};
+
+/**
+ * @brief Typed parameters of a parsed command; monostate until parsed successfully
+ */
+using RPCArguments = std::variant<std::monostate, CreateSpotArgs, MoveSpotArgs, DeleteSpotArgs,
+                                  ListSpotsArgs, GetSpotTemperatureArgs, ApplySpotBatchArgs>;
+
 /**
  * @brief RPC command structure for thermal spot operations
  */
 struct RPCCommand {
     std::string requestId;                    // Unique request identifier from MQTT topic
     RPCMethod method = RPCMethod::UNKNOWN;    // RPC method to execute
-    nlohmann::json parameters;                // Method-specific parameters
+    RPCArguments arguments;                   // Parameters of method, validated by RPCParser
+    std::string error;                        // Why parsing failed; empty for a valid command
     std::chrono::time_point<std::chrono::system_clock> receivedAt;  // When command was received
     std::chrono::time_point<std::chrono::system_clock> processedAt; // When processing completed
     int timeoutMs = 5000;                     // Command timeout in milliseconds
@@ -55,6 +114,12 @@ struct RPCCommand {
      */
     static std::string methodToString(RPCMethod method);
     
+    /**
+     * @brief Spot the command addresses
+     * @return spotId of the arguments, empty if none (auto-assigned or a batch)
+     */
+    const std::string& spotId() const;
+    
     /**
      * @brief Check if command has exceeded timeout
      * @return true if command should be considered timed out
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "thermal/frame/hotspot_finder.h"
+#include "thermal/frame/region_analyzer.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Builds one timestamped telemetry payload at a time into a reused buffer
+ *
+ * Payloads are built with begin(), add*() and finish(). The returned
+ * reference stays valid until the next call; encoders are not thread-safe.
+ */
+class TelemetryPayloadEncoder {
+public:
+    virtual ~TelemetryPayloadEncoder() = default;
+
+    /**
+     * @brief Start a payload, discarding any unfinished one
+     * @param timestamp_ms Milliseconds since the epoch
+     */
+    virtual void begin(std::int64_t timestamp_ms) = 0;
+
+    /**
+     * @brief Add a temperature_spot_N value to the current payload
+     */
+    virtual void addSpot(int spot_id, double temperature) = 0;
+
+    /**
+     * @brief Add the frame_max_* and frame_min_* values to the current payload
+     */
+    virtual void addFrameExtremes(const FrameExtremes& extremes) = 0;
+
+    /**
+     * @brief Add the area_N_* values (max, hottest pixel, mean, min) to the current payload
+     *
+     * Statistics that are not valid are skipped.
+     */
+    virtual void addArea(int area_id, const AreaStatistics& statistics) = 0;
+
+    /**
+     * @brief Write the current payload
+     * @return Encoded payload, valid until the next call
+     */
+    virtual const std::string& finish() = 0;
+};
+
+/**
+ * @brief Writes ThingsBoard telemetry JSON straight into a reusable buffer
+ *
+ * Produces the same bytes as building the payload with nlohmann::json and
+ * calling dump(): keys in lexicographic order, the last value of a repeated
+ * key wins, non-finite values become null and doubles use the same shortest
+ * round-trip formatting. No JSON tree is built and, once the buffer and the
+ * per-spot key cache are warm, encoding does not allocate.
+ */
+class TelemetryEncoder : public TelemetryPayloadEncoder {
+public:
+    static constexpr size_t DEFAULT_RESERVE_BYTES = 4096;
+
+    /**
+     * @brief Constructor
+     * @param reserve_bytes Initial buffer capacity
+     */
+    explicit TelemetryEncoder(size_t reserve_bytes = DEFAULT_RESERVE_BYTES);
+
+    /**
+     * @brief Encode {"temperature_spot_N":T} without a timestamp
+     */
+    const std::string& encodeReading(int spot_id, double temperature);
+
+    // {"ts":...,"values":{...}}
+    void begin(std::int64_t timestamp_ms) override;
+    void addSpot(int spot_id, double temperature) override;
+    void addFrameExtremes(const FrameExtremes& extremes) override;
+    void addArea(int area_id, const AreaStatistics& statistics) override;
+    const std::string& finish() override;
+
+private:
+    struct SpotValue {
+        const std::string* key;  // Cached "\"temperature_spot_N\":"
+        double value;
+        size_t index;            // Insertion order, so the last duplicate wins
+    };
+
+    struct AreaValue {
+        const std::string* prefix;  // Cached "\"area_N_"
+        AreaStatistics statistics;
+        size_t index;
+    };
+
+    std::string buffer_;
+    std::unordered_map<int, std::string> spot_keys_;
+    std::vector<SpotValue> spots_;
+    std::unordered_map<int, std::string> area_prefixes_;
+    std::vector<AreaValue> areas_;
+    std::int64_t timestamp_ms_ = 0;
+    FrameExtremes extremes_;
+    bool has_extremes_ = false;
+
+    const std::string& spotKey(int spot_id);
+    const std::string& areaPrefix(int area_id);
+    void appendArea(const AreaValue& area);
+    void appendDouble(double value);
+    void appendInteger(std::int64_t value);
+};
+
+} // namespace thermal
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Settings for the on-disk telemetry journal
+ */
+struct JournalOptions {
+    std::string directory;                          // Segment directory (created if missing)
+    size_t segment_bytes = 1024 * 1024;             // Roll to a new segment past this size
+    size_t max_bytes = 64 * 1024 * 1024;            // Oldest segments are dropped above this
+    size_t sync_every_records = 64;                 // fsync after this many appends...
+    std::chrono::milliseconds sync_interval{1000};  // ...or once this much time has passed
+};
+
+/**
+ * @brief One journaled telemetry message
+ */
+struct JournalRecord {
+    std::int64_t timestamp_ms = 0;  // Timestamp of the (first) reading in the payload
+    std::string payload;            // Encoded telemetry payload
+};
+
+/**
+ * @brief Append-only, segmented store-and-forward journal for telemetry
+ *
+ * Payloads that could not be published are appended to the newest segment
+ * file; replay reads them back in append order, not timestamp order. A publish
+ * that goes unacknowledged is journaled when its outcome arrives, possibly
+ * after newer readings from the same outage, so consumers must order by the
+ * payload timestamps (ThingsBoard does). Each record carries a length,
+ * timestamp and checksum, so a record torn by power loss is detected and cut
+ * off when the journal is reopened. Writes are fsynced in batches.
+ *
+ * Disk usage is bounded by max_bytes: once exceeded, whole segments are
+ * dropped from the old end. Fully replayed segments are deleted, and the
+ * replay position is persisted in a cursor file on every sync, so delivery
+ * is at-least-once across restarts (ThingsBoard overwrites duplicates that
+ * share a timestamp).
+ */
+class TelemetryJournal {
+public:
+    /**
+     * @brief Open or create a journal, recovering existing segments
+     * @param options Journal settings
+     * @throws std::invalid_argument if options are invalid
+     * @throws std::runtime_error if the directory or segments cannot be opened
+     */
+    explicit TelemetryJournal(const JournalOptions& options);
+
+    /**
+     * @brief Destructor, syncs outstanding writes
+     */
+    ~TelemetryJournal();
+
+    TelemetryJournal(const TelemetryJournal&) = delete;
+    TelemetryJournal& operator=(const TelemetryJournal&) = delete;
+
+    /**
+     * @brief Append a payload
+     * @param timestamp_ms Timestamp of the payload's readings
+     * @param payload Encoded telemetry payload
+     * @return true if the record was written
+     */
+    bool append(std::int64_t timestamp_ms, const std::string& payload);
+
+    /**
+     * @brief Flush appended records and the replay cursor to disk
+     */
+    void sync();
+
+    /**
+     * @brief Read the earliest appended unreplayed records without consuming them
+     * @param max_records Maximum number of records to return
+     * @param max_bytes Stop before the payloads exceed this many bytes (at least one record is returned)
+     * @param records Output, cleared first
+     * @return Number of records returned
+     */
+    size_t peek(size_t max_records, size_t max_bytes, std::vector<JournalRecord>& records);
+
+    /**
+     * @brief Mark the oldest records as replayed
+     * @param count Number of records, normally the count returned by peek()
+     */
+    void consume(size_t count);
+
+    bool empty() const { return pendingRecords() == 0; }
+    size_t pendingRecords() const;
+    size_t diskBytes() const { return disk_bytes_; }
+    std::uint64_t droppedRecords() const { return dropped_records_; }
+
+private:
+    struct Segment {
+        std::uint64_t sequence = 0;
+        std::string path;
+        size_t bytes = 0;
+        size_t records = 0;
+    };
+
+    JournalOptions options_;
+    std::deque<Segment> segments_;  // Oldest first; the back one is written to
+    int write_fd_ = -1;
+    size_t disk_bytes_ = 0;
+    std::uint64_t dropped_records_ = 0;
+
+    // Replay position inside segments_.front()
+    size_t read_offset_ = 0;
+    size_t read_records_ = 0;
+    bool cursor_dirty_ = false;
+
+    size_t unsynced_records_ = 0;
+    std::chrono::steady_clock::time_point last_sync_;
+
+    void recover();
+    void scanSegment(Segment& segment);
+    void loadCursor();
+    void saveCursor();
+    bool openNewSegment();
+    void dropOldestSegment();
+    void releaseReplayedSegments();
+    std::string segmentPath(std::uint64_t sequence) const;
+    std::string cursorPath() const;
+};
+
+} // namespace thermal
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "common/bounded_queue.h"
+#include "common/metrics.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace thermal {
+
+/**
+ * @brief What enqueue() does when the publish queue is full
+ */
+enum class OverflowPolicy {
+    DROP_OLDEST,  // Discard the oldest queued message to make room
+    DROP_NEWEST,  // Discard the message being enqueued
+    BLOCK         // Wait for the publisher thread to make room
+};
+
+/**
+ * @brief Convert overflow policy to its configuration string
+ */
+std::string overflowPolicyToString(OverflowPolicy policy);
+
+/**
+ * @brief Parse an overflow policy ("drop_oldest", "drop_newest" or "block")
+ * @throws std::invalid_argument if the string is unknown
+ */
+OverflowPolicy overflowPolicyFromString(const std::string& policy);
+
+/**
+ * @brief Counters of the publish pipeline
+ */
+struct PublisherStats {
+    size_t depth = 0;               // Messages currently queued
+    std::uint64_t enqueued = 0;     // Messages accepted into the queue
+    std::uint64_t published = 0;    // Messages the publish function accepted
+    std::uint64_t failed = 0;       // Messages the publish function rejected
+    std::uint64_t dropped_oldest = 0;
+    std::uint64_t dropped_newest = 0;
+};
+
+/**
+ * @brief Dedicated publisher thread fed by a bounded queue of encoded messages
+ *
+ * Producers (the sampling loop) only encode and enqueue, so a slow broker
+ * round trip never delays the next capture. The thread sleeps on a condition
+ * variable while the queue is empty; the queue itself is lock-free.
+ */
+class TelemetryPublisher {
+public:
+    struct Message {
+        std::string payload;
+        std::int64_t timestamp_ms = 0;
+    };
+
+    using PublishFunction = std::function<bool(const std::string& payload, std::int64_t timestamp_ms)>;
+
+    /**
+     * @brief Constructor, starts the publisher thread
+     * @param capacity Queue capacity in messages
+     * @param policy Behaviour when the queue is full
+     * @param publish Called on the publisher thread for every message
+     */
+    TelemetryPublisher(size_t capacity, OverflowPolicy policy, PublishFunction publish);
+
+    /**
+     * @brief Destructor, publishes what is still queued and joins the thread
+     */
+    ~TelemetryPublisher();
+
+    TelemetryPublisher(const TelemetryPublisher&) = delete;
+    TelemetryPublisher& operator=(const TelemetryPublisher&) = delete;
+
+    /**
+     * @brief Queue a message for publishing
+     * @param payload Encoded payload
+     * @param timestamp_ms Timestamp of the payload's readings
+     * @return false if the message was dropped (DROP_NEWEST, or stopped while blocked)
+     */
+    bool enqueue(std::string payload, std::int64_t timestamp_ms);
+
+    /**
+     * @brief Stop the thread after the queue has been drained
+     */
+    void stop();
+
+    size_t depth() const { return queue_.size(); }
+    size_t capacity() const { return queue_.capacity(); }
+    OverflowPolicy policy() const { return policy_; }
+
+    /**
+     * @brief Snapshot of the counters
+     */
+    PublisherStats getStats() const;
+
+private:
+    BoundedQueue<Message> queue_;
+    OverflowPolicy policy_;
+    PublishFunction publish_;
+
+    std::atomic<bool> running_{true};
+    std::mutex wake_mutex_;
+    std::condition_variable data_ready_;
+    std::condition_variable space_ready_;
+    std::atomic<int> blocked_producers_{0};
+    std::atomic<bool> publisher_idle_{false};
+
+    std::atomic<std::uint64_t> enqueued_{0};
+    std::atomic<std::uint64_t> published_{0};
+    std::atomic<std::uint64_t> failed_{0};
+    std::atomic<std::uint64_t> dropped_oldest_{0};
+    std::atomic<std::uint64_t> dropped_newest_{0};
+    Gauge& queue_depth_;  // Owned by MetricsRegistry
+
+    std::thread thread_;
+
+    void run();
+};
+
+} // namespace thermal
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace thermal {
+
+/**
+ * @brief Accumulates timestamped telemetry entries into upload payloads
+ *
+ * Each entry is one pre-encoded {"ts":..., "values":{...}} object. Entries are
+ * appended to a JSON array, which ThingsBoard accepts as a single telemetry
+ * message, until the upload window elapses. Arrays are closed early when the
+ * next entry would push them past the byte limit, so a window may yield
+ * several payloads but none exceeds the limit (unless a single entry does).
+ */
+class TelemetryWindow {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t DEFAULT_MAX_PAYLOAD_BYTES = 65536;
+
+    /**
+     * @brief Constructor
+     * @param window Upload window length (0 = windowing disabled)
+     * @param max_payload_bytes Maximum size of one uploaded array
+     */
+    explicit TelemetryWindow(std::chrono::milliseconds window = std::chrono::milliseconds(0),
+                             size_t max_payload_bytes = DEFAULT_MAX_PAYLOAD_BYTES);
+
+    /**
+     * @brief Change window length and byte limit, flushing nothing
+     * @param window Upload window length (0 = windowing disabled)
+     * @param max_payload_bytes Maximum size of one uploaded array
+     */
+    void configure(std::chrono::milliseconds window, size_t max_payload_bytes);
+
+    /**
+     * @brief Check if readings should be accumulated rather than sent directly
+     */
+    bool enabled() const { return window_.count() > 0; }
+
+    /**
+     * @brief Append one encoded entry
+     * @param entry JSON object text of a single {ts, values} entry
+     * @param now Current time; the first entry of a window starts its clock
+     * @return true if the window should be flushed now
+     */
+    bool add(const std::string& entry, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Check if the window has elapsed or a full payload is waiting
+     * @param now Current time
+     */
+    bool due(Clock::time_point now = Clock::now()) const;
+
+    /**
+     * @brief Close the window and hand out its payloads
+     * @return JSON array payloads in entry order, empty if nothing was added
+     */
+    std::vector<std::string> takePayloads();
+
+    size_t entryCount() const { return entry_count_; }
+    bool empty() const { return entry_count_ == 0; }
+    std::chrono::milliseconds window() const { return window_; }
+    size_t maxPayloadBytes() const { return max_payload_bytes_; }
+
+private:
+    std::chrono::milliseconds window_;
+    size_t max_payload_bytes_;
+
+    std::vector<std::string> closed_;  // Finished arrays waiting for upload
+    std::string open_;                 // Array being filled, without its closing bracket
+    size_t entry_count_ = 0;
+    Clock::time_point window_start_;
+
+    void closeOpenPayload();
+};
+
+} // namespace thermal
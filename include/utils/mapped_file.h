@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace utils {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The kernel pages data in on demand, so large recordings can be walked
+ * without read buffers or copies. The mapping is released on destruction.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map a file read-only
+     * @param file_path Path to the file
+     * @param sequential Hint the kernel that the file will be read front to back
+     * @return true if the file was mapped (an empty file maps to size 0)
+     */
+    bool open(const std::string& file_path, bool sequential = true);
+
+    /**
+     * @brief Unmap the file
+     */
+    void close();
+
+    bool isOpen() const { return open_; }
+    const unsigned char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0;
+    bool open_ = false;
+};
+
+} // namespace utils
@@ -0,0 +1,87 @@
+#include "common/executor.h"
+#include "common/logger.h"
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace thermal {
+
+Executor::Executor(size_t workers, const std::string& name)
+    : name_(name) {
+    workers = std::max<size_t>(workers, 1);
+    workers_.reserve(workers);
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back(&Executor::workerLoop, this);
+    }
+}
+
+Executor::~Executor() {
+    shutdown();
+}
+
+bool Executor::submit(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!accepting_) {
+            return false;
+        }
+        tasks_.push_back(std::move(task));
+    }
+    task_ready_.notify_one();
+    return true;
+}
+
+void Executor::shutdown() {
+    // A worker cannot join itself, and one left running would outlive this object
+    for (const auto& worker : workers_) {
+        if (worker.get_id() == std::this_thread::get_id()) {
+            LOG_ERROR("Ignoring shutdown of " << name_ << " requested from its own task");
+            return;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!accepting_) {
+            return;
+        }
+        accepting_ = false;
+    }
+    task_ready_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+size_t Executor::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tasks_.size();
+}
+
+void Executor::workerLoop() {
+    for (;;) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            task_ready_.wait(lock, [this] { return !accepting_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;  // Shut down and drained
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+
+        try {
+            task();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Unhandled exception in " << name_ << " task: " << e.what());
+        } catch (...) {
+            LOG_ERROR("Unknown exception in " << name_ << " task");
+        }
+    }
+}
+
+} // namespace thermal
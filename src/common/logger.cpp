@@ -1,108 +1,338 @@
 #include "common/logger.h"
+#include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
-#include <iomanip>
-#include <chrono>
-#include <mutex>
+#include <stdexcept>
 
 namespace thermal {
 
-// Static member initialization
-static std::unique_ptr<Logger> logger_instance = nullptr;
-static std::mutex logger_mutex;
-
-void Logger::initialize(LogLevel level, const std::string& output, const std::string& log_file) {
-    std::lock_guard<std::mutex> lock(logger_mutex);
-    
-    if (!logger_instance) {
-        logger_instance = std::unique_ptr<Logger>(new Logger());
-    }
-    
-    logger_instance->min_level_ = level;
-    logger_instance->output_mode_ = output;
-    logger_instance->log_file_path_ = log_file;
-    
+constexpr size_t Logger::QUEUE_CAPACITY;
+constexpr size_t Logger::DEFAULT_MAX_FILE_BYTES;
+constexpr size_t Logger::DEFAULT_MAX_FILES;
+
+namespace {
+
+// Records written per batch before the sinks are flushed
+constexpr size_t WRITE_BATCH = 256;
+
+void stop_logger_at_exit() {
+    Logger::instance().shutdown();
+}
+
+} // namespace
+
+Logger::Logger()
+    : queue_(QUEUE_CAPACITY) {
+    writer_ = std::thread(&Logger::run, this);
+}
+
+void Logger::initialize(LogLevel level, const std::string& output, const std::string& log_file,
+                        size_t max_file_bytes, size_t max_files) {
+    Logger& logger = instance();
+    logger.flush();  // Earlier messages go to the previous sinks
+
+    std::lock_guard<std::mutex> lock(logger.sink_mutex_);
+    logger.min_level_ = static_cast<int>(level);
+    logger.output_mode_ = output;
+    logger.log_file_path_ = log_file;
+    logger.max_file_bytes_ = max_file_bytes;
+    logger.max_files_ = max_files;
+    logger.file_stream_.reset();
+    logger.file_bytes_ = 0;
+
     // Initialize file stream if needed
     if (output == "file" || output == "both") {
         if (!log_file.empty()) {
-            logger_instance->file_stream_ = std::make_shared<std::ofstream>(
-                log_file, std::ios::out | std::ios::app);
-            
-            if (!logger_instance->file_stream_->is_open()) {
+            logger.file_stream_ = std::make_unique<std::ofstream>(log_file, std::ios::out | std::ios::app);
+
+            if (!logger.file_stream_->is_open()) {
                 std::cerr << "Failed to open log file: " << log_file << std::endl;
-                logger_instance->file_stream_.reset();
+                logger.file_stream_.reset();
+            } else {
+                logger.file_bytes_ = static_cast<size_t>(logger.file_stream_->tellp());
             }
         }
     }
 }
 
 Logger& Logger::instance() {
-    std::lock_guard<std::mutex> lock(logger_mutex);
-    
-    if (!logger_instance) {
-        // Initialize with default settings if not already initialized
-        logger_instance = std::unique_ptr<Logger>(new Logger());
-    }
-    
-    return *logger_instance;
+    // Function-local static: thread-safe construction, no lock afterwards
+    static Logger* logger = [] {
+        Logger* created = new Logger();
+        std::atexit(stop_logger_at_exit);
+        return created;
+    }();
+    return *logger;
 }
 
-void Logger::debug(const std::string& message) {
-    log(LogLevel::DEBUG, message);
+LogLevel Logger::level_from_string(const std::string& level) {
+    if (level == "debug") return LogLevel::DEBUG;
+    if (level == "info") return LogLevel::INFO;
+    if (level == "warn") return LogLevel::WARN;
+    if (level == "error") return LogLevel::ERROR;
+    throw std::invalid_argument("Invalid log level: " + level);
 }
 
-void Logger::info(const std::string& message) {
-    log(LogLevel::INFO, message);
+void Logger::debug(std::string message) {
+    log(LogLevel::DEBUG, std::move(message));
 }
 
-void Logger::warn(const std::string& message) {
-    log(LogLevel::WARN, message);
+void Logger::info(std::string message) {
+    log(LogLevel::INFO, std::move(message));
 }
 
-void Logger::error(const std::string& message) {
-    log(LogLevel::ERROR, message);
+void Logger::warn(std::string message) {
+    log(LogLevel::WARN, std::move(message));
 }
 
-bool Logger::is_enabled(LogLevel level) const {
-    return level >= min_level_;
+void Logger::error(std::string message) {
+    log(LogLevel::ERROR, std::move(message));
 }
 
 void Logger::set_level(LogLevel level) {
-    std::lock_guard<std::mutex> lock(logger_mutex);
-    min_level_ = level;
+    min_level_ = static_cast<int>(level);
 }
 
-void Logger::log(LogLevel level, const std::string& message) {
+void Logger::log(LogLevel level, std::string message) {
     if (!is_enabled(level)) {
         return;
     }
-    
-    std::lock_guard<std::mutex> lock(logger_mutex);
-    
-    std::string formatted_message = format_message(level, message);
-    
-    // Output to console
+
+    Record record;
+    record.level = level;
+    record.time = std::chrono::system_clock::now();
+    record.message = std::move(message);
+
+    if (!running_) {
+        // Writer stopped (process exit): write inline
+        std::lock_guard<std::mutex> lock(sink_mutex_);
+        write_record(record);
+        flush_sinks();
+        return;
+    }
+
+    if (!queue_.tryPush(record)) {
+        dropped_++;
+        return;
+    }
+    pushed_++;
+
+    // Only pay for the lock when the writer thread may be asleep
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writer_idle_) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        data_ready_.notify_one();
+    }
+}
+
+void Logger::flush() {
+    if (!running_ || std::this_thread::get_id() == writer_.get_id()) {
+        return;
+    }
+
+    std::uint64_t target = pushed_;
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    data_ready_.notify_one();
+    drained_.wait(lock, [this, target] { return processed_ >= target || !running_; });
+}
+
+void Logger::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+    }
+    data_ready_.notify_one();
+    if (writer_.joinable() && std::this_thread::get_id() != writer_.get_id()) {
+        writer_.join();
+    }
+}
+
+void Logger::run() {
+    Record record;
+    for (;;) {
+        size_t written = 0;
+        {
+            std::lock_guard<std::mutex> lock(sink_mutex_);
+            while (written < WRITE_BATCH && queue_.tryPop(record)) {
+                write_record(record);
+                written++;
+            }
+
+            std::uint64_t dropped = dropped_;
+            if (dropped != reported_dropped_) {
+                Record notice;
+                notice.level = LogLevel::WARN;
+                notice.time = std::chrono::system_clock::now();
+                notice.message = std::to_string(dropped - reported_dropped_) +
+                                 " log messages dropped (buffer full)";
+                reported_dropped_ = dropped;
+                write_record(notice);
+            }
+
+            if (written > 0) {
+                flush_sinks();
+            }
+        }
+
+        if (written > 0) {
+            processed_ += written;
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            drained_.notify_all();
+            continue;
+        }
+
+        // Buffer drained; exit only once asked to and nothing is left
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        if (!running_ && queue_.empty()) {
+            drained_.notify_all();
+            break;
+        }
+        writer_idle_ = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        data_ready_.wait_for(lock, std::chrono::milliseconds(100),
+                             [this] { return !running_ || !queue_.empty(); });
+        writer_idle_ = false;
+    }
+}
+
+void Logger::write_record(const Record& record) {
+    line_.clear();
+    line_ += '[';
+    format_timestamp(record.time, line_);
+    line_ += "] [";
+    line_ += level_to_string(record.level);
+    line_ += "] ";
+    line_ += record.message;
+    line_ += '\n';
+    write_line(record.level, line_);
+}
+
+void Logger::write_line(LogLevel level, const std::string& line) {
+    // Output to console; cerr is tied to cout, so lines stay in order
     if (output_mode_ == "console" || output_mode_ == "both") {
         if (level >= LogLevel::WARN) {
-            std::cerr << formatted_message << std::endl;
+            std::cerr << line;
         } else {
-            std::cout << formatted_message << std::endl;
+            std::cout << line;
         }
     }
-    
+
     // Output to file
-    if ((output_mode_ == "file" || output_mode_ == "both") && file_stream_ && file_stream_->is_open()) {
-        *file_stream_ << formatted_message << std::endl;
-        file_stream_->flush();  // Ensure immediate write for debugging
+    if ((output_mode_ == "file" || output_mode_ == "both") && file_stream_) {
+        if (max_file_bytes_ > 0 && file_bytes_ > 0 && file_bytes_ + line.size() > max_file_bytes_) {
+            rotate_file();
+        }
+        if (file_stream_) {
+            file_stream_->write(line.data(), static_cast<std::streamsize>(line.size()));
+            file_bytes_ += line.size();
+        }
+    }
+}
+
+void Logger::flush_sinks() {
+    std::cout.flush();
+    if (file_stream_) {
+        file_stream_->flush();
+    }
+}
+
+void Logger::rotate_file() {
+    file_stream_.reset();
+
+    // log.N-1 -> log.N ... log -> log.1; the oldest falls off the end
+    if (max_files_ > 0) {
+        std::remove((log_file_path_ + "." + std::to_string(max_files_)).c_str());
+        for (size_t index = max_files_ - 1; index > 0; --index) {
+            std::rename((log_file_path_ + "." + std::to_string(index)).c_str(),
+                        (log_file_path_ + "." + std::to_string(index + 1)).c_str());
+        }
+        std::rename(log_file_path_.c_str(), (log_file_path_ + ".1").c_str());
+    }
+
+    file_stream_ = std::make_unique<std::ofstream>(log_file_path_, std::ios::out | std::ios::trunc);
+    file_bytes_ = 0;
+    if (!file_stream_->is_open()) {
+        std::cerr << "Failed to reopen log file after rotation: " << log_file_path_ << std::endl;
+        file_stream_.reset();
+    }
+}
+
+void Logger::format_timestamp(std::chrono::system_clock::time_point time, std::string& out) {
+    std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    if (seconds != cached_second_) {
+        std::tm local_time{};
+        localtime_r(&seconds, &local_time);
+        char buffer[32];
+        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local_time);
+        cached_timestamp_ = buffer;
+        cached_second_ = seconds;
     }
+
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count() % 1000;
+    char millis[8];
+    std::snprintf(millis, sizeof(millis), ".%03d", static_cast<int>(ms));
+    out += cached_timestamp_;
+    out += millis;
+}
+
+constexpr std::int64_t LogRateLimit::FIRST_N_SUMMARY_INTERVAL_MS;
+
+namespace {
+
+std::int64_t steady_now_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 }
 
-std::string Logger::format_message(LogLevel level, const std::string& message) const {
-    std::stringstream ss;
-    ss << "[" << get_timestamp() << "] ";
-    ss << "[" << level_to_string(level) << "] ";
-    ss << message;
-    return ss.str();
+// Claim the next pass if its time has come; only one racing caller wins
+bool claim_interval(std::atomic<std::int64_t>& next_pass_ms, std::int64_t interval_ms) {
+    std::int64_t now = steady_now_ms();
+    std::int64_t next = next_pass_ms.load(std::memory_order_relaxed);
+    return now >= next &&
+           next_pass_ms.compare_exchange_strong(next, now + interval_ms, std::memory_order_relaxed);
+}
+
+} // namespace
+
+bool LogRateLimit::pass(std::uint64_t& suppressed) {
+    suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+bool LogRateLimit::every_n(std::uint64_t n, std::uint64_t& suppressed) {
+    std::uint64_t count = count_.fetch_add(1, std::memory_order_relaxed);
+    if (n <= 1 || count % n == 0) {
+        return pass(suppressed);
+    }
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool LogRateLimit::every_ms(std::int64_t interval_ms, std::uint64_t& suppressed) {
+    if (claim_interval(next_pass_ms_, interval_ms)) {
+        return pass(suppressed);
+    }
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool LogRateLimit::first_n(std::uint64_t n, std::uint64_t& suppressed) {
+    std::uint64_t count = count_.fetch_add(1, std::memory_order_relaxed);
+    if (count < n) {
+        return pass(suppressed);
+    }
+    if (count == n) {
+        // Suppression starts now; the first summary is due one interval later
+        next_pass_ms_.store(steady_now_ms() + FIRST_N_SUMMARY_INTERVAL_MS, std::memory_order_relaxed);
+    } else if (claim_interval(next_pass_ms_, FIRST_N_SUMMARY_INTERVAL_MS)) {
+        return pass(suppressed);
+    }
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
 }
 
 std::string Logger::level_to_string(LogLevel level) const {
@@ -115,17 +345,4 @@ std::string Logger::level_to_string(LogLevel level) const {
     }
 }
 
-std::string Logger::get_timestamp() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
-    
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    ss << "." << std::setfill('0') << std::setw(3) << ms.count();
-    
-    return ss.str();
-}
-
-} // namespace thermal
\ No newline at end of file
+} // namespace thermal
@@ -0,0 +1,229 @@
+#include "common/metrics.h"
+#include "common/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace thermal {
+
+constexpr unsigned Histogram::SUB_BUCKET_BITS;
+constexpr std::uint64_t Histogram::SUB_BUCKETS;
+constexpr unsigned Histogram::MAX_EXPONENT;
+constexpr size_t Histogram::BUCKET_COUNT;
+
+namespace {
+
+unsigned floor_log2(std::uint64_t value) {
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+}
+
+std::string series_key(const std::string& name, const MetricLabels& labels) {
+    std::string key = name;
+    for (const auto& label : labels) {
+        key += '\x1f';
+        key += label.first;
+        key += '=';
+        key += label.second;
+    }
+    return key;
+}
+
+} // namespace
+
+std::uint64_t HistogramSnapshot::percentile(double quantile) const {
+    if (count == 0) {
+        return 0;
+    }
+    if (quantile <= 0.0) {
+        return min;
+    }
+
+    auto rank = static_cast<std::uint64_t>(std::ceil(std::min(quantile, 1.0) * static_cast<double>(count)));
+    rank = std::max<std::uint64_t>(rank, 1);
+    std::uint64_t seen = 0;
+    for (const auto& bucket : buckets) {
+        seen += bucket.count;
+        if (seen >= rank) {
+            return std::min(bucket.upper_bound, max);
+        }
+    }
+    return max;
+}
+
+size_t Histogram::bucketIndex(std::uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return static_cast<size_t>(value);  // Exact below the first power of two
+    }
+
+    unsigned exponent = floor_log2(value);
+    if (exponent >= MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    unsigned shift = exponent - SUB_BUCKET_BITS;
+    size_t group = exponent - SUB_BUCKET_BITS + 1;
+    size_t sub_bucket = static_cast<size_t>((value >> shift) - SUB_BUCKETS);
+    return group * SUB_BUCKETS + sub_bucket;
+}
+
+std::uint64_t Histogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+
+    size_t group = index / SUB_BUCKETS;
+    std::uint64_t sub_bucket = index % SUB_BUCKETS;
+    unsigned shift = static_cast<unsigned>(group - 1);
+    std::uint64_t lower = (SUB_BUCKETS + sub_bucket) << shift;
+    return lower + (1ULL << shift) - 1;
+}
+
+void Histogram::record(std::uint64_t value) {
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    std::uint64_t current = min_.load(std::memory_order_relaxed);
+    while (value < current && !min_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+    current = max_.load(std::memory_order_relaxed);
+    while (value > current && !max_.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot snapshot;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        std::uint64_t count = buckets_[i].load(std::memory_order_relaxed);
+        if (count > 0) {
+            snapshot.buckets.push_back({bucketUpperBound(i), count});
+            snapshot.count += count;
+        }
+    }
+
+    // Concurrent records may land between loads; count follows the buckets
+    snapshot.sum = sum_.load(std::memory_order_relaxed);
+    if (snapshot.count > 0) {
+        snapshot.min = min_.load(std::memory_order_relaxed);
+        snapshot.max = max_.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void Histogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    sum_.store(0, std::memory_order_relaxed);
+    min_.store(UINT64_MAX, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+MetricSnapshot makeMetricSnapshot(MetricType type, const std::string& name, const std::string& help,
+                                  std::int64_t value, const MetricLabels& labels) {
+    MetricSnapshot metric;
+    metric.name = name;
+    metric.labels = labels;
+    metric.help = help;
+    metric.type = type;
+    metric.value = value;
+    return metric;
+}
+
+MetricsRegistry& MetricsRegistry::instance() {
+    // Never destroyed: instrumented objects may outlive static destruction order
+    static MetricsRegistry* registry = new MetricsRegistry();
+    return *registry;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    return *getOrCreate(name, help, labels, MetricType::COUNTER).counter;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    return *getOrCreate(name, help, labels, MetricType::GAUGE).gauge;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    return *getOrCreate(name, help, labels, MetricType::HISTOGRAM).histogram;
+}
+
+MetricsRegistry::Entry& MetricsRegistry::getOrCreate(const std::string& name, const std::string& help,
+                                                     const MetricLabels& labels, MetricType type) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto family = families_.emplace(name, Family{type, help}).first;
+    if (family->second.type != type) {
+        throw std::invalid_argument("Metric " + name + " is already registered with another type");
+    }
+    if (family->second.help.empty()) {
+        family->second.help = help;
+    }
+
+    std::string key = series_key(name, labels);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        return it->second;
+    }
+
+    Entry entry;
+    entry.name = name;
+    entry.labels = labels;
+    entry.type = type;
+    switch (type) {
+        case MetricType::COUNTER: entry.counter = std::make_unique<Counter>(); break;
+        case MetricType::GAUGE: entry.gauge = std::make_unique<Gauge>(); break;
+        case MetricType::HISTOGRAM: entry.histogram = std::make_unique<Histogram>(); break;
+    }
+    return entries_.emplace(key, std::move(entry)).first->second;
+}
+
+std::vector<MetricSnapshot> MetricsRegistry::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<MetricSnapshot> result;
+    result.reserve(entries_.size());
+    for (const auto& item : entries_) {
+        const Entry& entry = item.second;
+        MetricSnapshot metric;
+        metric.name = entry.name;
+        metric.labels = entry.labels;
+        metric.help = families_.at(entry.name).help;
+        metric.type = entry.type;
+        switch (entry.type) {
+            case MetricType::COUNTER: metric.value = static_cast<std::int64_t>(entry.counter->value()); break;
+            case MetricType::GAUGE: metric.value = entry.gauge->value(); break;
+            case MetricType::HISTOGRAM: metric.histogram = entry.histogram->snapshot(); break;
+        }
+        result.push_back(std::move(metric));
+    }
+    return result;
+}
+
+void MetricsRegistry::logSummary() const {
+    for (const auto& metric : snapshot()) {
+        if (metric.type != MetricType::HISTOGRAM || metric.histogram.count == 0) {
+            continue;
+        }
+        std::ostringstream name;
+        name << metric.name;
+        for (const auto& label : metric.labels) {
+            name << " " << label.first << "=" << label.second;
+        }
+        LOG_INFO(name.str() << ": " << metric.histogram.count << " samples, p50 "
+                << metric.histogram.percentile(0.5) << ", p99 " << metric.histogram.percentile(0.99)
+                << ", max " << metric.histogram.max);
+    }
+}
+
+void MetricsRegistry::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto& item : entries_) {
+        if (item.second.counter) {
+            item.second.counter->reset();
+        }
+        if (item.second.histogram) {
+            item.second.histogram->reset();
+        }
+    }
+}
+
+} // namespace thermal
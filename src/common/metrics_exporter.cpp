@@ -0,0 +1,311 @@
+#include "common/metrics_exporter.h"
+#include "common/logger.h"
+#include "utils/file_utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace thermal {
+
+constexpr std::chrono::milliseconds MetricsExporter::POLL_INTERVAL;
+constexpr std::chrono::milliseconds MetricsExporter::REQUEST_TIMEOUT;
+constexpr size_t MetricsExporter::MAX_REQUEST_BYTES;
+
+namespace {
+
+const char* type_name(MetricType type) {
+    switch (type) {
+        case MetricType::COUNTER: return "counter";
+        case MetricType::GAUGE: return "gauge";
+        case MetricType::HISTOGRAM: return "histogram";
+    }
+    return "untyped";
+}
+
+void write_escaped(std::ostringstream& out, const std::string& text, bool quote) {
+    for (char c : text) {
+        if (c == '\\') {
+            out << "\\\\";
+        } else if (c == '\n') {
+            out << "\\n";
+        } else if (quote && c == '"') {
+            out << "\\\"";
+        } else {
+            out << c;
+        }
+    }
+}
+
+// Writes {a="1",b="2"} with an optional trailing le label; nothing if empty
+void write_labels(std::ostringstream& out, const MetricLabels& labels, const char* le = nullptr) {
+    if (labels.empty() && !le) {
+        return;
+    }
+    out << '{';
+    bool first = true;
+    for (const auto& label : labels) {
+        out << (first ? "" : ",") << label.first << "=\"";
+        write_escaped(out, label.second, true);
+        out << '"';
+        first = false;
+    }
+    if (le) {
+        out << (first ? "" : ",") << "le=\"" << le << '"';
+    }
+    out << '}';
+}
+
+void write_histogram(std::ostringstream& out, const MetricSnapshot& metric) {
+    const HistogramSnapshot& histogram = metric.histogram;
+    size_t bucket = 0;
+    std::uint64_t cumulative = 0;
+    for (unsigned exponent = 0; exponent <= Histogram::MAX_EXPONENT && histogram.count > 0; ++exponent) {
+        std::uint64_t bound = (1ULL << exponent) - 1;
+        while (bucket < histogram.buckets.size() && histogram.buckets[bucket].upper_bound <= bound) {
+            cumulative += histogram.buckets[bucket++].count;
+        }
+        std::string le = std::to_string(bound);
+        out << metric.name << "_bucket";
+        write_labels(out, metric.labels, le.c_str());
+        out << ' ' << cumulative << '\n';
+        if (bound >= histogram.max) {
+            break;
+        }
+    }
+    out << metric.name << "_bucket";
+    write_labels(out, metric.labels, "+Inf");
+    out << ' ' << histogram.count << '\n';
+
+    out << metric.name << "_sum";
+    write_labels(out, metric.labels);
+    out << ' ' << histogram.sum << '\n';
+    out << metric.name << "_count";
+    write_labels(out, metric.labels);
+    out << ' ' << histogram.count << '\n';
+}
+
+bool send_all(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+std::string http_response(const std::string& status, const std::string& content_type, const std::string& body) {
+    std::ostringstream out;
+    out << "HTTP/1.0 " << status << "\r\n"
+        << "Content-Type: " << content_type << "\r\n"
+        << "Content-Length: " << body.size() << "\r\n"
+        << "Connection: close\r\n\r\n"
+        << body;
+    return out.str();
+}
+
+} // namespace
+
+std::string formatPrometheusText(std::vector<MetricSnapshot> metrics) {
+    // Registry snapshots are already ordered; collector metrics are appended
+    std::stable_sort(metrics.begin(), metrics.end(), [](const MetricSnapshot& a, const MetricSnapshot& b) {
+        return a.name < b.name;
+    });
+
+    std::ostringstream out;
+    const std::string* family = nullptr;
+    for (const auto& metric : metrics) {
+        if (!family || *family != metric.name) {
+            family = &metric.name;
+            if (!metric.help.empty()) {
+                out << "# HELP " << metric.name << ' ';
+                write_escaped(out, metric.help, false);
+                out << '\n';
+            }
+            out << "# TYPE " << metric.name << ' ' << type_name(metric.type) << '\n';
+        }
+
+        if (metric.type == MetricType::HISTOGRAM) {
+            write_histogram(out, metric);
+        } else {
+            out << metric.name;
+            write_labels(out, metric.labels);
+            out << ' ' << metric.value << '\n';
+        }
+    }
+    return out.str();
+}
+
+MetricsExporter::MetricsExporter(Collector collector)
+    : collector_(std::move(collector)) {
+}
+
+MetricsExporter::~MetricsExporter() {
+    stop();
+}
+
+void MetricsExporter::serveHttp(const std::string& address, int port) {
+    if (thread_.joinable()) {
+        throw std::runtime_error("Metrics exporter already started");
+    }
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1) {
+        throw std::runtime_error("Invalid metrics listen address: " + address);
+    }
+
+    int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create metrics socket: " + std::string(std::strerror(errno)));
+    }
+    int reuse = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 8) != 0) {
+        std::string error = std::strerror(errno);
+        ::close(fd);
+        throw std::runtime_error("Failed to listen on " + address + ":" + std::to_string(port) + ": " + error);
+    }
+
+    socklen_t length = sizeof(addr);
+    ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &length);
+    listen_fd_ = fd;
+    port_ = ntohs(addr.sin_port);
+    running_ = true;
+    thread_ = std::thread(&MetricsExporter::serveLoop, this);
+    LOG_INFO("Serving metrics on http://" << address << ":" << port_ << "/metrics");
+}
+
+void MetricsExporter::writeTextfile(const std::string& path, std::chrono::milliseconds interval) {
+    if (thread_.joinable()) {
+        throw std::runtime_error("Metrics exporter already started");
+    }
+    running_ = true;
+    thread_ = std::thread(&MetricsExporter::textfileLoop, this, path, interval);
+    LOG_INFO("Writing metrics to " << path << " every " << interval.count() << " ms");
+}
+
+void MetricsExporter::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    stop_requested_.notify_all();
+    thread_.join();
+
+    if (listen_fd_ >= 0) {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        port_ = 0;
+    }
+}
+
+std::string MetricsExporter::render() const {
+    std::vector<MetricSnapshot> metrics = MetricsRegistry::instance().snapshot();
+    if (collector_) {
+        collector_(metrics);
+    }
+    return formatPrometheusText(std::move(metrics));
+}
+
+bool MetricsExporter::writeTextfileOnce(const std::string& path) const {
+    return utils::FileUtils::atomicFileUpdate(path, render());
+}
+
+void MetricsExporter::serveLoop() {
+    while (running_) {
+        pollfd pfd{listen_fd_, POLLIN, 0};
+        int ready = ::poll(&pfd, 1, static_cast<int>(POLL_INTERVAL.count()));
+        if (ready <= 0) {
+            continue;  // Timeout or EINTR; re-check running_
+        }
+
+        int client = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0) {
+            continue;
+        }
+        try {
+            handleConnection(client);
+        } catch (const std::exception& e) {
+            LOG_ERROR("Metrics request failed: " << e.what());
+        }
+        ::close(client);
+    }
+}
+
+void MetricsExporter::handleConnection(int fd) {
+    // Scrapes are served one at a time; a stalled client only holds the thread this long
+    timeval timeout{};
+    timeout.tv_sec = REQUEST_TIMEOUT.count() / 1000;
+    timeout.tv_usec = static_cast<suseconds_t>((REQUEST_TIMEOUT.count() % 1000) * 1000);
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST_BYTES) {
+        ssize_t n = ::recv(fd, buffer, sizeof(buffer), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<size_t>(n));
+    }
+
+    // Request line: METHOD SP TARGET SP VERSION
+    std::istringstream line(request.substr(0, request.find("\r\n")));
+    std::string method;
+    std::string target;
+    line >> method >> target;
+    target = target.substr(0, target.find('?'));
+
+    const std::string text = "text/plain; charset=utf-8";
+    if (method != "GET") {
+        send_all(fd, http_response("405 Method Not Allowed", text, "Only GET is supported\n"));
+    } else if (target != "/metrics") {
+        send_all(fd, http_response("404 Not Found", text, "Metrics are served at /metrics\n"));
+    } else {
+        send_all(fd, http_response("200 OK", "text/plain; version=0.0.4; charset=utf-8", render()));
+    }
+}
+
+void MetricsExporter::textfileLoop(std::string path, std::chrono::milliseconds interval) {
+    for (;;) {
+        try {
+            if (!writeTextfileOnce(path)) {
+                LOG_ERROR_EVERY_MS(60000, "Failed to write metrics file " << path);
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR("Failed to collect metrics: " << e.what());
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;  // Stopped after the final write
+        }
+        stop_requested_.wait_for(lock, interval, [this] { return !running_; });
+    }
+}
+
+} // namespace thermal
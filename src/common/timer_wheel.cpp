@@ -0,0 +1,57 @@
+#include "common/timer_wheel.h"
+#include <algorithm>
+
+namespace thermal {
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, size_t slots, Clock::time_point start)
+    : tick_(std::max(tick, std::chrono::milliseconds(1)))
+    , start_(start)
+    , slots_(std::max<size_t>(slots, 1)) {
+}
+
+void TimerWheel::schedule(std::uint64_t id, Clock::time_point deadline) {
+    // First tick whose start is at or after the deadline
+    auto offset = std::max(deadline - start_, Clock::duration::zero());
+    auto ticks = std::chrono::duration_cast<Clock::duration>(tick_).count();
+    std::uint64_t due_tick = static_cast<std::uint64_t>((offset.count() + ticks - 1) / ticks);
+    due_tick = std::max(due_tick, current_tick_ + 1);
+
+    std::uint64_t distance = due_tick - current_tick_;
+    slots_[due_tick % slots_.size()].push_back({id, (distance - 1) / slots_.size()});
+    ++size_;
+}
+
+size_t TimerWheel::advance(Clock::time_point now, std::vector<std::uint64_t>& expired) {
+    if (now < start_) {
+        return 0;
+    }
+
+    std::uint64_t target_tick = static_cast<std::uint64_t>((now - start_) / tick_);
+    size_t count = 0;
+
+    if (target_tick <= current_tick_) {
+        return 0;
+    }
+
+    // Visit each elapsed tick's slot; an empty wheel jumps straight to now
+    while (current_tick_ < target_tick && size_ > 0) {
+        ++current_tick_;
+        auto& slot = slots_[current_tick_ % slots_.size()];
+        auto keep = slot.begin();
+        for (auto& timer : slot) {
+            if (timer.rounds == 0) {
+                expired.push_back(timer.id);
+                ++count;
+                --size_;
+            } else {
+                --timer.rounds;
+                *keep++ = timer;
+            }
+        }
+        slot.erase(keep, slot.end());
+    }
+    current_tick_ = target_tick;
+    return count;
+}
+
+} // namespace thermal
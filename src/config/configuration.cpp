@@ -1,5 +1,6 @@
 #include "config/configuration.h"
 #include "thermal/measurement_spot.h"
+#include "thermal/measurement_area.h"
 #include <stdexcept>
 #include <regex>
 #include <set>
@@ -23,7 +24,9 @@ void Configuration::load_from_file(const std::string& filename) {
 bool Configuration::validate() const {
     return thingsboard_config.validate() && 
            telemetry_config.validate() && 
-           logging_config.validate();
+           logging_config.validate() &&
+           metrics_config.validate() &&
+           source_config.validate();
 }
 
 void Configuration::from_json(const nlohmann::json& json_data) {
@@ -45,6 +48,14 @@ void Configuration::from_json(const nlohmann::json& json_data) {
         }
         // logging_config has defaults, so it's optional
 
+        if (json_data.contains("metrics")) {
+            metrics_config.from_json(json_data["metrics"]);
+        }
+
+        if (json_data.contains("temperature_source")) {
+            source_config.from_json(json_data["temperature_source"]);
+        }
+
         if (!validate()) {
             throw std::invalid_argument("Configuration validation failed");
         }
@@ -58,6 +69,8 @@ nlohmann::json Configuration::to_json() const {
     json_data["thingsboard"] = thingsboard_config.to_json();
     json_data["telemetry"] = telemetry_config.to_json();
     json_data["logging"] = logging_config.to_json();
+    json_data["metrics"] = metrics_config.to_json();
+    json_data["temperature_source"] = source_config.to_json();
     return json_data;
 }
 
@@ -93,6 +106,26 @@ bool ThingsBoardConfig::validate() const {
         throw std::invalid_argument("QoS level must be 0, 1, or 2");
     }
     
+    if (rpc_max_queue_depth < 1 || rpc_max_queue_depth > 4096) {
+        throw std::invalid_argument("RPC queue depth must be between 1 and 4096 commands");
+    }
+    
+    if (rpc_max_pending_per_method < 1 || rpc_max_pending_per_method > 4096) {
+        throw std::invalid_argument("RPC pending limit per method must be between 1 and 4096 commands");
+    }
+    
+    if (rpc_rate_limit_per_second < 0.0 || rpc_rate_limit_per_second > 1000.0) {
+        throw std::invalid_argument("RPC rate limit must be between 0 and 1000 commands per second");
+    }
+    
+    if (rpc_rate_burst < 1.0) {
+        throw std::invalid_argument("RPC rate burst must be at least 1 command");
+    }
+    
+    if (payload_format != "json" && payload_format != "protobuf") {
+        throw std::invalid_argument("Invalid payload format: " + payload_format + " (expected json or protobuf)");
+    }
+    
     return true;
 }
 
@@ -118,6 +151,21 @@ void ThingsBoardConfig::from_json(const nlohmann::json& json_data) {
     if (json_data.contains("qos_level")) {
         qos_level = json_data["qos_level"].get<int>();
     }
+    if (json_data.contains("rpc_max_queue_depth")) {
+        rpc_max_queue_depth = json_data["rpc_max_queue_depth"].get<size_t>();
+    }
+    if (json_data.contains("rpc_max_pending_per_method")) {
+        rpc_max_pending_per_method = json_data["rpc_max_pending_per_method"].get<size_t>();
+    }
+    if (json_data.contains("rpc_rate_limit_per_second")) {
+        rpc_rate_limit_per_second = json_data["rpc_rate_limit_per_second"].get<double>();
+    }
+    if (json_data.contains("rpc_rate_burst")) {
+        rpc_rate_burst = json_data["rpc_rate_burst"].get<double>();
+    }
+    if (json_data.contains("payload_format")) {
+        payload_format = json_data["payload_format"].get<std::string>();
+    }
 }
 
 nlohmann::json ThingsBoardConfig::to_json() const {
@@ -128,7 +176,12 @@ nlohmann::json ThingsBoardConfig::to_json() const {
         {"device_id", device_id},
         {"use_ssl", use_ssl},
         {"keep_alive_seconds", keep_alive_seconds},
-        {"qos_level", qos_level}
+        {"qos_level", qos_level},
+        {"rpc_max_queue_depth", rpc_max_queue_depth},
+        {"rpc_max_pending_per_method", rpc_max_pending_per_method},
+        {"rpc_rate_limit_per_second", rpc_rate_limit_per_second},
+        {"rpc_rate_burst", rpc_rate_burst},
+        {"payload_format", payload_format}
     };
 }
 
@@ -139,8 +192,14 @@ bool TelemetryConfig::validate() const {
     }
     
     // Allow empty measurement_spots array - spots can be created dynamically via RPC
-    if (measurement_spots.size() > 5) {
-        throw std::invalid_argument("Maximum 5 measurement spots allowed");
+    if (measurement_spots.size() > MAX_MEASUREMENT_SPOTS) {
+        throw std::invalid_argument("Maximum " + std::to_string(MAX_MEASUREMENT_SPOTS) +
+                                    " measurement spots allowed");
+    }
+    
+    if (measurement_areas.size() > MAX_MEASUREMENT_AREAS) {
+        throw std::invalid_argument("Maximum " + std::to_string(MAX_MEASUREMENT_AREAS) +
+                                    " measurement areas allowed");
     }
     
     if (retry_attempts < 0 || retry_attempts > 10) {
@@ -151,6 +210,43 @@ bool TelemetryConfig::validate() const {
         throw std::invalid_argument("Retry delay must be between 100 and 10000 milliseconds");
     }
     
+    if (sample_interval_ms != 0 && (sample_interval_ms < 100 || sample_interval_ms > 3600000)) {
+        throw std::invalid_argument("Sample interval must be 0 or between 100 and 3600000 milliseconds");
+    }
+    
+    if (upload_window_seconds < 0 || upload_window_seconds > 3600) {
+        throw std::invalid_argument("Upload window must be between 0 and 3600 seconds");
+    }
+    
+    if (max_upload_bytes < 1024 || max_upload_bytes > 1048576) {
+        throw std::invalid_argument("Max upload size must be between 1024 and 1048576 bytes");
+    }
+    
+    if (deadband_celsius < 0.0 || deadband_percent < 0.0) {
+        throw std::invalid_argument("Deadband must be non-negative");
+    }
+    
+    if (heartbeat_seconds < 0 || heartbeat_seconds > 86400) {
+        throw std::invalid_argument("Heartbeat interval must be between 0 and 86400 seconds");
+    }
+    
+    if (!journal_directory.empty() && journal_max_bytes < 1024 * 1024) {
+        throw std::invalid_argument("Journal size limit must be at least 1 MiB");
+    }
+    
+    if (backfill_messages_per_second <= 0.0 || backfill_messages_per_second > 1000.0) {
+        throw std::invalid_argument("Backfill rate must be greater than 0 and at most 1000 messages per second");
+    }
+    
+    if (publish_queue_capacity > 65536) {
+        throw std::invalid_argument("Publish queue capacity must be at most 65536 messages");
+    }
+    
+    const std::set<std::string> valid_policies = {"drop_oldest", "drop_newest", "block"};
+    if (valid_policies.count(publish_overflow_policy) == 0) {
+        throw std::invalid_argument("Invalid publish overflow policy: " + publish_overflow_policy);
+    }
+    
     // Validate each measurement spot
     for (const auto& spot : measurement_spots) {
         if (!spot.validate()) {
@@ -167,6 +263,17 @@ bool TelemetryConfig::validate() const {
         spot_ids.insert(spot.id);
     }
     
+    // Validate each measurement area and check for unique area IDs
+    std::set<int> area_ids;
+    for (const auto& area : measurement_areas) {
+        if (!area.validate()) {
+            return false;
+        }
+        if (!area_ids.insert(area.id).second) {
+            throw std::invalid_argument("Duplicate measurement area ID: " + std::to_string(area.id));
+        }
+    }
+    
     return true;
 }
 
@@ -183,6 +290,39 @@ void TelemetryConfig::from_json(const nlohmann::json& json_data) {
     if (json_data.contains("retry_delay_ms")) {
         retry_delay_ms = json_data["retry_delay_ms"].get<int>();
     }
+    if (json_data.contains("sample_interval_ms")) {
+        sample_interval_ms = json_data["sample_interval_ms"].get<int>();
+    }
+    if (json_data.contains("upload_window_seconds")) {
+        upload_window_seconds = json_data["upload_window_seconds"].get<int>();
+    }
+    if (json_data.contains("max_upload_bytes")) {
+        max_upload_bytes = json_data["max_upload_bytes"].get<size_t>();
+    }
+    if (json_data.contains("deadband_celsius")) {
+        deadband_celsius = json_data["deadband_celsius"].get<double>();
+    }
+    if (json_data.contains("deadband_percent")) {
+        deadband_percent = json_data["deadband_percent"].get<double>();
+    }
+    if (json_data.contains("heartbeat_seconds")) {
+        heartbeat_seconds = json_data["heartbeat_seconds"].get<int>();
+    }
+    if (json_data.contains("journal_directory")) {
+        journal_directory = json_data["journal_directory"].get<std::string>();
+    }
+    if (json_data.contains("journal_max_bytes")) {
+        journal_max_bytes = json_data["journal_max_bytes"].get<size_t>();
+    }
+    if (json_data.contains("backfill_messages_per_second")) {
+        backfill_messages_per_second = json_data["backfill_messages_per_second"].get<double>();
+    }
+    if (json_data.contains("publish_queue_capacity")) {
+        publish_queue_capacity = json_data["publish_queue_capacity"].get<size_t>();
+    }
+    if (json_data.contains("publish_overflow_policy")) {
+        publish_overflow_policy = json_data["publish_overflow_policy"].get<std::string>();
+    }
     if (json_data.contains("measurement_spots")) {
         measurement_spots.clear();
         for (const auto& spot_json : json_data["measurement_spots"]) {
@@ -191,6 +331,14 @@ void TelemetryConfig::from_json(const nlohmann::json& json_data) {
             measurement_spots.push_back(spot);
         }
     }
+    if (json_data.contains("measurement_areas")) {
+        measurement_areas.clear();
+        for (const auto& area_json : json_data["measurement_areas"]) {
+            MeasurementArea area;
+            area.from_json(area_json);
+            measurement_areas.push_back(area);
+        }
+    }
 }
 
 nlohmann::json TelemetryConfig::to_json() const {
@@ -198,13 +346,29 @@ nlohmann::json TelemetryConfig::to_json() const {
     for (const auto& spot : measurement_spots) {
         spots_json.push_back(spot.to_json());
     }
+    nlohmann::json areas_json = nlohmann::json::array();
+    for (const auto& area : measurement_areas) {
+        areas_json.push_back(area.to_json());
+    }
     
     return nlohmann::json{
         {"interval_seconds", interval_seconds},
         {"batch_transmission", batch_transmission},
         {"retry_attempts", retry_attempts},
         {"retry_delay_ms", retry_delay_ms},
-        {"measurement_spots", spots_json}
+        {"sample_interval_ms", sample_interval_ms},
+        {"upload_window_seconds", upload_window_seconds},
+        {"max_upload_bytes", max_upload_bytes},
+        {"deadband_celsius", deadband_celsius},
+        {"deadband_percent", deadband_percent},
+        {"heartbeat_seconds", heartbeat_seconds},
+        {"journal_directory", journal_directory},
+        {"journal_max_bytes", journal_max_bytes},
+        {"backfill_messages_per_second", backfill_messages_per_second},
+        {"publish_queue_capacity", publish_queue_capacity},
+        {"publish_overflow_policy", publish_overflow_policy},
+        {"measurement_spots", spots_json},
+        {"measurement_areas", areas_json}
     };
 }
 
@@ -226,6 +390,14 @@ bool LoggingConfig::validate() const {
         }
     }
     
+    if (max_file_bytes != 0 && max_file_bytes < 64 * 1024) {
+        throw std::invalid_argument("Log file size limit must be 0 or at least 65536 bytes");
+    }
+    
+    if (max_files > 100) {
+        throw std::invalid_argument("At most 100 rotated log files can be kept");
+    }
+    
     return true;
 }
 
@@ -239,14 +411,123 @@ void LoggingConfig::from_json(const nlohmann::json& json_data) {
     if (json_data.contains("log_file")) {
         log_file = json_data["log_file"].get<std::string>();
     }
+    if (json_data.contains("max_file_bytes")) {
+        max_file_bytes = json_data["max_file_bytes"].get<size_t>();
+    }
+    if (json_data.contains("max_files")) {
+        max_files = json_data["max_files"].get<size_t>();
+    }
 }
 
 nlohmann::json LoggingConfig::to_json() const {
     return nlohmann::json{
         {"level", level},
         {"output", output},
-        {"log_file", log_file}
+        {"log_file", log_file},
+        {"max_file_bytes", max_file_bytes},
+        {"max_files", max_files}
+    };
+}
+
+// MetricsConfig implementation
+bool MetricsConfig::validate() const {
+    const std::set<std::string> valid_modes = {"off", "http", "textfile"};
+    if (valid_modes.count(mode) == 0) {
+        throw std::invalid_argument("Invalid metrics mode: " + mode);
+    }
+    
+    if (mode == "http") {
+        if (listen_address.empty()) {
+            throw std::invalid_argument("Metrics listen address cannot be empty");
+        }
+        if (port < 1 || port > 65535) {
+            throw std::invalid_argument("Metrics port must be between 1 and 65535");
+        }
+    }
+    
+    if (mode == "textfile") {
+        const std::string extension = ".prom";
+        if (textfile_path.size() <= extension.size() ||
+            textfile_path.compare(textfile_path.size() - extension.size(), extension.size(), extension) != 0) {
+            throw std::invalid_argument("Metrics textfile path must end in .prom");
+        }
+        if (interval_seconds < 1) {
+            throw std::invalid_argument("Metrics textfile interval must be at least 1 second");
+        }
+    }
+    
+    return true;
+}
+
+void MetricsConfig::from_json(const nlohmann::json& json_data) {
+    if (json_data.contains("mode")) {
+        mode = json_data["mode"].get<std::string>();
+    }
+    if (json_data.contains("listen_address")) {
+        listen_address = json_data["listen_address"].get<std::string>();
+    }
+    if (json_data.contains("port")) {
+        port = json_data["port"].get<int>();
+    }
+    if (json_data.contains("textfile_path")) {
+        textfile_path = json_data["textfile_path"].get<std::string>();
+    }
+    if (json_data.contains("interval_seconds")) {
+        interval_seconds = json_data["interval_seconds"].get<int>();
+    }
+}
+
+nlohmann::json MetricsConfig::to_json() const {
+    return nlohmann::json{
+        {"mode", mode},
+        {"listen_address", listen_address},
+        {"port", port},
+        {"textfile_path", textfile_path},
+        {"interval_seconds", interval_seconds}
+    };
+}
+
+// SourceConfig implementation
+bool SourceConfig::validate() const {
+    const std::set<std::string> valid_types = {"coordinate_based", "frame_based", "file_replay"};
+    if (valid_types.count(type) == 0) {
+        throw std::invalid_argument("Invalid temperature source type: " + type);
+    }
+    
+    if (type == "file_replay") {
+        if (replay_file.empty()) {
+            throw std::invalid_argument("Replay file cannot be empty for the file_replay source");
+        }
+        if (!(replay_fps >= 0.0 && replay_fps <= 1000.0)) {
+            throw std::invalid_argument("Replay rate must be between 0 and 1000 frames per second");
+        }
+    }
+    
+    return true;
+}
+
+void SourceConfig::from_json(const nlohmann::json& json_data) {
+    if (json_data.contains("type")) {
+        type = json_data["type"].get<std::string>();
+    }
+    if (json_data.contains("replay_file")) {
+        replay_file = json_data["replay_file"].get<std::string>();
+    }
+    if (json_data.contains("replay_fps")) {
+        replay_fps = json_data["replay_fps"].get<double>();
+    }
+    if (json_data.contains("replay_loop")) {
+        replay_loop = json_data["replay_loop"].get<bool>();
+    }
+}
+
+nlohmann::json SourceConfig::to_json() const {
+    return nlohmann::json{
+        {"type", type},
+        {"replay_file", replay_file},
+        {"replay_fps", replay_fps},
+        {"replay_loop", replay_loop}
     };
 }
 
-} // namespace thermal
\ No newline at end of file
+} // namespace thermal
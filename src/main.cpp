@@ -1,6 +1,7 @@
 #include "config/configuration.h"
 #include "thermal/temperature_reading.h"
 #include "thermal/measurement_spot.h"
+#include "thermal/measurement_area.h"
 #include "thingsboard/mock_device.h"
 #include "common/logger.h"
 #include <iostream>
@@ -4,6 +4,7 @@
 
 #include "config/configuration.h"
 #include "thermal/measurement_spot.h"
+#include "thermal/measurement_area.h"
 #include "thermal/temperature_reading.h"
 #include "common/logger.h"
 #include "common/error_handler.h"
@@ -51,13 +52,8 @@ Result<Configuration> load_configuration(const std::string& config_file) {
  * @param config Logging configuration
  */
 void initialize_logging(const LoggingConfig& config) {
-    LogLevel level = LogLevel::INFO;
-    if (config.level == "debug") level = LogLevel::DEBUG;
-    else if (config.level == "info") level = LogLevel::INFO;
-    else if (config.level == "warn") level = LogLevel::WARN;
-    else if (config.level == "error") level = LogLevel::ERROR;
-    
-    Logger::initialize(level, config.output, config.log_file);
+    Logger::initialize(Logger::level_from_string(config.level), config.output, config.log_file,
+                       config.max_file_bytes, config.max_files);
 }
 
 /**
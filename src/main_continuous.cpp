@@ -1,9 +1,13 @@
 #include "config/configuration.h"
 #include "thermal/temperature_reading.h"
 #include "thermal/measurement_spot.h"
+#include "thermal/temperature_source/temperature_source_factory.h"
 #include "thingsboard/device.h"
 #include "common/logger.h"
+#include "common/metrics.h"
+#include "common/metrics_exporter.h"
 #include "provisioning/workflow.h"
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <thread>
@@ -23,10 +27,17 @@ class ContinuousTelemetryApp {
 private:
     thermal::Configuration config_;
     std::unique_ptr<thermal::ThingsBoardDevice> device_;
+    std::unique_ptr<thermal::MetricsExporter> metrics_exporter_;  // Declared after device_: reads it
     std::vector<thermal::MeasurementSpot> measurement_spots_;
+    std::unique_ptr<thermal::TemperatureDataSource> temp_source_;
+    std::vector<thermal::Point> sample_points_;
+    std::vector<float> sample_temperatures_;
+    std::vector<thermal::TemperatureReading> batch_readings_;
     std::chrono::steady_clock::time_point last_telemetry_time_;
-    int total_transmissions_ = 0;
-    int failed_transmissions_ = 0;
+    thermal::Counter& total_transmissions_ = thermal::MetricsRegistry::instance().counter(
+        "telemetry_transmissions_total", "Spot readings sent successfully");
+    thermal::Counter& failed_transmissions_ = thermal::MetricsRegistry::instance().counter(
+        "telemetry_failed_transmissions_total", "Spot readings that failed to send");
 
 public:
     bool initialize(const std::string& config_file) {
@@ -44,6 +55,15 @@ public:
             device_ = std::make_unique<thermal::ThingsBoardDevice>(config_.thingsboard_config);
             device_->set_auto_reconnect(true);
             
+            // Publishing runs on its own thread so broker latency never delays sampling
+            if (config_.telemetry_config.publish_queue_capacity > 0) {
+                device_->start_publisher(config_.telemetry_config.publish_queue_capacity,
+                                         thermal::overflowPolicyFromString(config_.telemetry_config.publish_overflow_policy));
+            }
+            
+            // Temperature source sampled once per batch for all spots
+            temp_source_ = thermal::TemperatureSourceFactory::createDefault();
+            
             // Initialize measurement spots
             measurement_spots_ = config_.telemetry_config.measurement_spots;
             
@@ -59,6 +79,8 @@ public:
             
             LOG_INFO("Initialized " << measurement_spots_.size() << " measurement spots");
             
+            start_metrics_export();
+            
             return true;
             
         } catch (const std::exception& e) {
@@ -134,45 +156,64 @@ public:
         int batch_successes = 0;
         int batch_failures = 0;
         
-        for (auto& spot : measurement_spots_) {
-            if (!spot.enabled || spot.get_state() != thermal::SpotState::ACTIVE) {
-                continue;
+        // Sample all active spots with a single batched source query
+        sample_points_.clear();
+        for (const auto& spot : measurement_spots_) {
+            if (spot.is_ready()) {
+                sample_points_.push_back({spot.x, spot.y});
             }
-            
-            // Generate temperature while spot is active
-            double temperature = spot.generate_temperature();
-            
-            // Temporarily set to reading state for telemetry
-            spot.set_state(thermal::SpotState::READING);
-            
-            // Add timestamp for more realistic telemetry
-            auto timestamp = std::chrono::system_clock::now();
-            bool success = device_->send_telemetry(spot.id, temperature, timestamp);
-            
-            if (success) {
-                LOG_INFO("Spot " << spot.id << " (" << spot.name << "): " 
-                        << std::fixed << std::setprecision(2) << temperature << "°C ✓");
-                batch_successes++;
-                total_transmissions_++;
+        }
+        sample_temperatures_.resize(sample_points_.size());
+        temp_source_->captureFrame();
+        temp_source_->getTemperatures(sample_points_.data(), sample_points_.size(),
+                                      sample_temperatures_.data());
+        
+        // All spots of this cycle share one sampling instant
+        auto timestamp = std::chrono::system_clock::now();
+        batch_readings_.clear();
+        size_t sample_index = 0;
+        for (const auto& spot : measurement_spots_) {
+            if (spot.is_ready()) {
+                thermal::TemperatureReading reading(spot.id, sample_temperatures_[sample_index++]);
+                reading.timestamp = timestamp;
+                batch_readings_.push_back(reading);
+            }
+        }
+        
+        if (config_.telemetry_config.batch_transmission) {
+            // One publish for the whole sampling instant
+            if (device_->send_telemetry_batch(batch_readings_.data(), batch_readings_.size())) {
+                LOG_INFO("Sent " << batch_readings_.size() << " spots in one message ✓");
+                batch_successes += static_cast<int>(batch_readings_.size());
+                total_transmissions_.increment(batch_readings_.size());
             } else {
-                LOG_WARN("Spot " << spot.id << " (" << spot.name << "): " 
-                        << std::fixed << std::setprecision(2) << temperature << "°C ✗");
-                batch_failures++;
-                failed_transmissions_++;
+                LOG_WARN("Failed to send " << batch_readings_.size() << " spots in one message ✗");
+                batch_failures += static_cast<int>(batch_readings_.size());
+                failed_transmissions_.increment(batch_readings_.size());
+            }
+        } else {
+            for (const auto& reading : batch_readings_) {
+                bool success = device_->send_telemetry(reading.spot_id, reading.temperature, reading.timestamp);
+                
+                if (success) {
+                    LOG_INFO("Spot " << reading.spot_id << ": " 
+                            << std::fixed << std::setprecision(2) << reading.temperature << "°C ✓");
+                    batch_successes++;
+                    total_transmissions_.increment();
+                } else {
+                    LOG_WARN("Spot " << reading.spot_id << ": " 
+                            << std::fixed << std::setprecision(2) << reading.temperature << "°C ✗");
+                    batch_failures++;
+                    failed_transmissions_.increment();
+                }
             }
-            
-            // Return to active state
-            spot.set_state(thermal::SpotState::ACTIVE);
-            
-            // Small delay between spot readings
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
         }
         
         LOG_INFO("Batch complete: " << batch_successes << " sent, " 
                 << batch_failures << " failed");
         
         // Log periodic statistics
-        if (total_transmissions_ > 0 && total_transmissions_ % 20 == 0) {
+        if (total_transmissions_.value() > 0 && total_transmissions_.value() % 20 == 0) {
             print_statistics();
         }
     }
@@ -181,21 +222,60 @@ public:
         const auto& stats = device_->get_connection_stats();
         
         LOG_INFO("=== Telemetry Statistics ===");
-        LOG_INFO("Total transmissions: " << total_transmissions_);
-        LOG_INFO("Failed transmissions: " << failed_transmissions_);
+        const auto total = total_transmissions_.value();
+        const auto failed = failed_transmissions_.value();
+        LOG_INFO("Total transmissions: " << total);
+        LOG_INFO("Failed transmissions: " << failed);
         LOG_INFO("Success rate: " << std::fixed << std::setprecision(1) 
-                << (total_transmissions_ > 0 ? 
-                    100.0 * (total_transmissions_ - failed_transmissions_) / total_transmissions_ : 0.0) 
+                << (total + failed > 0 ? 100.0 * total / (total + failed) : 0.0)
                 << "%");
-        LOG_INFO("MQTT messages sent: " << stats.messages_sent);
-        LOG_INFO("MQTT connection failures: " << stats.connection_failures);
-        LOG_INFO("Connection attempts: " << stats.connection_attempts);
+        LOG_INFO("MQTT messages sent: " << stats.messages_sent.load());
+        LOG_INFO("MQTT connection failures: " << stats.connection_failures.load());
+        LOG_INFO("Connection attempts: " << stats.connection_attempts.load());
+        const auto deliveries = device_->get_delivery_stats();
+        LOG_INFO("MQTT deliveries acknowledged: " << deliveries.delivered << ", unacknowledged: "
+                << deliveries.in_flight << " (oldest " << deliveries.oldest_age.count() / 1000 << " ms), lost: "
+                << deliveries.failed + deliveries.connection_lost);
+        
+        const auto publisher_stats = device_->get_publisher_stats();
+        if (publisher_stats.enqueued > 0) {
+            LOG_INFO("Publish queue depth: " << publisher_stats.depth);
+            LOG_INFO("Publish queue drops: " << publisher_stats.dropped_oldest << " oldest, "
+                    << publisher_stats.dropped_newest << " newest");
+        }
+        thermal::MetricsRegistry::instance().logSummary();
         LOG_INFO("===========================");
     }
     
+    void start_metrics_export() {
+        const auto& metrics = config_.metrics_config;
+        if (metrics.mode == "off") {
+            return;
+        }
+        
+        auto active_spots = std::count_if(measurement_spots_.begin(), measurement_spots_.end(),
+                                          [](const thermal::MeasurementSpot& spot) { return spot.enabled; });
+        thermal::ThingsBoardDevice* device = device_.get();
+        metrics_exporter_ = std::make_unique<thermal::MetricsExporter>(
+            [device, active_spots](std::vector<thermal::MetricSnapshot>& snapshot) {
+                device->collect_metrics(snapshot);
+                snapshot.push_back(thermal::makeMetricSnapshot(thermal::MetricType::GAUGE, "thermal_active_spots",
+                    "Active measurement spots", static_cast<std::int64_t>(active_spots)));
+            });
+        if (metrics.mode == "http") {
+            metrics_exporter_->serveHttp(metrics.listen_address, metrics.port);
+        } else {
+            metrics_exporter_->writeTextfile(metrics.textfile_path, std::chrono::seconds(metrics.interval_seconds));
+        }
+    }
+    
     void shutdown() {
         LOG_INFO("Shutting down...");
         
+        if (metrics_exporter_) {
+            metrics_exporter_->stop();
+        }
+        
         if (device_) {
             print_statistics();
             device_->disconnect();
@@ -1,12 +1,18 @@
 #include "config/configuration.h"
 #include "thermal/temperature_reading.h"
 #include "thermal/measurement_spot.h"
+#include "thermal/measurement_area.h"
 #include "thermal/spot_manager/thermal_spot_manager.h"
+#include "thermal/deadband_filter.h"
 #include "thermal/rpc/thermal_rpc_handler.h"
 #include "thermal/temperature_source/temperature_source_factory.h"
+#include "thermal/temperature_source/replay_temperature_source.h"
 #include "thingsboard/device.h"
 #include "provisioning/workflow.h"
 #include "common/logger.h"
+#include "common/metrics.h"
+#include "common/metrics_exporter.h"
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <thread>
@@ -104,14 +110,31 @@ int main() {
         // Load configuration
         thermal::Configuration config;
         config.load_from_file("thermal_config.json");
+        const auto& logging = config.logging_config;
+        thermal::Logger::initialize(thermal::Logger::level_from_string(logging.level), logging.output,
+                                    logging.log_file, logging.max_file_bytes, logging.max_files);
         
         LOG_INFO("Configuration loaded successfully");
         LOG_INFO("ThingsBoard host: " << config.thingsboard_config.host);
         LOG_INFO("MQTT port: " << config.thingsboard_config.port);
         LOG_INFO("Device ID: " << config.thingsboard_config.device_id);
         
-        // Initialize thermal spot manager with temperature source
-        auto temp_source = thermal::TemperatureSourceFactory::createDefault();
+        // Initialize thermal spot manager with the configured source; frame-based
+        // sources let every telemetry cycle sample all spots from the same captured image
+        const auto& source = config.source_config;
+        std::unique_ptr<thermal::TemperatureDataSource> temp_source;
+        if (thermal::TemperatureSourceFactory::parseSourceType(source.type) ==
+            thermal::TemperatureSourceFactory::SourceType::FILE_REPLAY) {
+            thermal::ReplayOptions replay_options;
+            replay_options.file_path = source.replay_file;
+            replay_options.playback_fps = source.replay_fps;
+            replay_options.loop = source.replay_loop;
+            temp_source = thermal::TemperatureSourceFactory::createReplaySource(replay_options);
+            LOG_INFO("Replaying thermal frames from " << source.replay_file);
+        } else {
+            temp_source = thermal::TemperatureSourceFactory::createSource(source.type);
+        }
+        LOG_INFO("Temperature source: " << temp_source->getSourceName());
         auto spot_manager = std::make_shared<thermal::ThermalSpotManager>(
             std::move(temp_source), "thermal_spots.json");
         
@@ -156,19 +179,31 @@ int main() {
             }
         }
         
-        // Initialize measurement spots from config (if any)
+        // Initialize measurement spots from config (if any), keeping their measurement settings
         std::vector<thermal::MeasurementSpot> config_spots = config.telemetry_config.measurement_spots;
         for (auto& spot : config_spots) {
-            std::string spot_id = std::to_string(spot.id);  // Convert int to string
-            bool created = spot_manager->createSpot(spot_id, spot.x, spot.y);
+            bool created = spot_manager->createSpot(spot);
             if (created) {
-                LOG_INFO("Created config spot " << spot_id << " (" << spot.name 
+                LOG_INFO("Created config spot " << spot.id << " (" << spot.name 
                         << ") at (" << spot.x << ", " << spot.y << ")");
             } else {
-                LOG_WARN("Failed to create config spot " << spot_id << " (may already exist)");
+                LOG_WARN("Failed to create config spot " << spot.id << " (may already exist)");
             }
         }
         
+        // Box and polygon areas are measured on every captured frame
+        if (!config.telemetry_config.measurement_areas.empty()) {
+            spot_manager->setAreas(config.telemetry_config.measurement_areas);
+        }
+        
+        // Report-by-exception: managed spots may override the telemetry-wide deadband;
+        // their settings are picked up (and old state dropped) as spots change
+        thermal::DeadbandSettings deadband_defaults;
+        deadband_defaults.deadband_celsius = config.telemetry_config.deadband_celsius;
+        deadband_defaults.deadband_percent = config.telemetry_config.deadband_percent;
+        deadband_defaults.heartbeat_seconds = config.telemetry_config.heartbeat_seconds;
+        thermal::DeadbandFilter deadband_filter(deadband_defaults);
+        
         LOG_INFO("=== Thermal Camera Ready for RPC Commands ===");
         LOG_INFO("Listening for RPC commands on: v1/devices/me/rpc/request/+");
         LOG_INFO("Available commands:");
@@ -177,43 +212,129 @@ int main() {
         LOG_INFO("  - deleteSpotMeasurement: Delete thermal spot");
         LOG_INFO("  - listSpotMeasurements: List all active spots");
         LOG_INFO("  - getSpotTemperature: Get temperature reading");
+        LOG_INFO("  - applySpotBatch: Create, move and delete many spots at once");
         LOG_INFO("Press Ctrl+C to stop...");
         LOG_INFO("===============================================");
         
         // Main loop - keep running and send periodic telemetry
         auto last_telemetry = std::chrono::steady_clock::now();
-        auto telemetry_interval = std::chrono::seconds(config.telemetry_config.interval_seconds);
+        std::chrono::milliseconds telemetry_interval = std::chrono::seconds(config.telemetry_config.interval_seconds);
+        
+        // Readings that cannot be published are journaled and backfilled later
+        if (!config.telemetry_config.journal_directory.empty()) {
+            thermal::JournalOptions journal_options;
+            journal_options.directory = config.telemetry_config.journal_directory;
+            journal_options.max_bytes = config.telemetry_config.journal_max_bytes;
+            journal_options.segment_bytes = std::min(journal_options.segment_bytes, journal_options.max_bytes);
+            device.set_journal(std::make_unique<thermal::TelemetryJournal>(journal_options),
+                               config.telemetry_config.backfill_messages_per_second,
+                               config.telemetry_config.max_upload_bytes);
+            LOG_INFO("Telemetry journal enabled in " << journal_options.directory);
+        }
+        
+        // Keep broker round trips out of the sampling loop
+        if (config.telemetry_config.publish_queue_capacity > 0) {
+            device.start_publisher(config.telemetry_config.publish_queue_capacity,
+                                   thermal::overflowPolicyFromString(config.telemetry_config.publish_overflow_policy));
+        }
+        
+        // Windowed mode samples at sample_interval_ms and uploads once per window
+        device.set_upload_window(std::chrono::seconds(config.telemetry_config.upload_window_seconds),
+                                 config.telemetry_config.max_upload_bytes);
+        if (device.upload_window_enabled() && config.telemetry_config.sample_interval_ms > 0) {
+            telemetry_interval = std::chrono::milliseconds(config.telemetry_config.sample_interval_ms);
+        }
+        
+        // Local Prometheus export; stopped before the device goes away
+        thermal::MetricsExporter metrics_exporter([&device, &spot_manager](std::vector<thermal::MetricSnapshot>& metrics) {
+            device.collect_metrics(metrics);
+            metrics.push_back(thermal::makeMetricSnapshot(thermal::MetricType::GAUGE, "thermal_active_spots",
+                "Active measurement spots", static_cast<std::int64_t>(spot_manager->getActiveSpotCount())));
+        });
+        const auto& metrics = config.metrics_config;
+        if (metrics.mode == "http") {
+            metrics_exporter.serveHttp(metrics.listen_address, metrics.port);
+        } else if (metrics.mode == "textfile") {
+            metrics_exporter.writeTextfile(metrics.textfile_path, std::chrono::seconds(metrics.interval_seconds));
+        }
         
         while (keep_running) {
             // Check if we should send telemetry
             auto now = std::chrono::steady_clock::now();
             if (now - last_telemetry >= telemetry_interval) {
-                // Send telemetry for all active spots from spot manager
-                auto active_spots = spot_manager->listSpots();
-                for (const auto& spot : active_spots) {
-                    std::string spot_id_str = std::to_string(spot.id);  // Convert int to string
-                    float temperature = spot_manager->getSpotTemperature(spot_id_str);
-                    if (temperature > 0.0f) {
-                        bool sent = device.send_telemetry(spot.id, temperature);  // Use int id for telemetry
+                // Capture one frame and send telemetry for all active spots sampled from it
+                auto readings = spot_manager->sampleSpots();
+                bool sampled_spots = !readings.empty();
+                
+                // Created, moved, deleted or reloaded spots start over with their own settings
+                thermal::MeasurementSpot changed_spot;
+                for (int spot_id : spot_manager->takeChangedSpots()) {
+                    deadband_filter.resetSpot(spot_id);
+                    if (spot_manager->getSpot(spot_id, changed_spot)) {
+                        deadband_filter.setSpotSettings(spot_id, deadband_defaults.withOverrides(changed_spot));
+                    }
+                }
+                readings.resize(deadband_filter.filter(readings.data(), readings.size()));
+                
+                const thermal::FrameExtremes& extremes = spot_manager->getFrameExtremes();
+                const thermal::FrameExtremes* pending_extremes = extremes.valid ? &extremes : nullptr;
+                
+                if (device.upload_window_enabled()) {
+                    // Accumulate this instant; the device uploads when the window closes
+                    if (!readings.empty() || pending_extremes) {
+                        if (!device.queue_telemetry(readings.data(), readings.size(), pending_extremes)) {
+                            LOG_WARN("Failed to upload windowed telemetry");
+                        }
+                    }
+                } else if (config.telemetry_config.batch_transmission) {
+                    // Every spot of this frame plus the hotspot in one publish
+                    if (!readings.empty() || pending_extremes) {
+                        bool sent = device.send_telemetry_batch(readings.data(), readings.size(), pending_extremes);
+                        if (sent) {
+                            LOG_INFO("Sent telemetry batch for " << readings.size() << " spots");
+                        } else {
+                            LOG_WARN("Failed to send telemetry batch for " << readings.size() << " spots");
+                        }
+                    }
+                } else {
+                    // Frame hotspot/coldspot keys go out with the first spot of the cycle
+                    for (const auto& reading : readings) {
+                        bool sent = device.send_telemetry(reading.spot_id, reading.temperature, reading.timestamp,
+                                                          pending_extremes);
+                        pending_extremes = nullptr;
                         if (sent) {
-                            LOG_INFO("Sent telemetry for spot " << spot.id << ": " << std::fixed << std::setprecision(2) << temperature << "°C");
+                            LOG_INFO("Sent telemetry for spot " << reading.spot_id << ": " << std::fixed << std::setprecision(2) << reading.temperature << "°C");
                         } else {
-                            LOG_WARN("Failed to send telemetry for spot " << spot.id);
+                            LOG_WARN("Failed to send telemetry for spot " << reading.spot_id);
                         }
                     }
+                    
+                    // Without spots the hotspot/coldspot is still reported on its own
+                    if (pending_extremes) {
+                        device.send_frame_extremes(*pending_extremes, pending_extremes->captured_at);
+                    }
+                }
+                
+                // Area statistics come from the same frame as the extremes
+                const auto& areas = spot_manager->getAreaReadings();
+                if (!areas.empty() && !device.send_area_telemetry(areas.data(), areas.size(), extremes.captured_at)) {
+                    LOG_WARN("Failed to send telemetry for " << areas.size() << " measurement areas");
                 }
                 
                 // Also send telemetry for original config spots if they exist and aren't managed by spot manager
-                if (active_spots.empty()) {
+                if (!sampled_spots) {
                     for (auto& config_spot : config_spots) {
                         // Generate temperature for config spot
                         config_spot.set_state(thermal::SpotState::ACTIVE);
-                        double temperature = config_spot.generate_temperature();
+                        thermal::TemperatureReading reading(config_spot.id, config_spot.generate_temperature());
+                        if (!deadband_filter.shouldPublish(reading)) {
+                            continue;
+                        }
                         
-                        bool sent = device.send_telemetry(config_spot.id, temperature);
+                        bool sent = device.send_telemetry(config_spot.id, reading.temperature, reading.timestamp);
                         if (sent) {
                             LOG_INFO("Sent config telemetry for spot " << config_spot.id << " (" << config_spot.name 
-                                    << "): " << std::fixed << std::setprecision(2) << temperature << "°C");
+                                    << "): " << std::fixed << std::setprecision(2) << reading.temperature << "°C");
                         } else {
                             LOG_WARN("Failed to send config telemetry for spot " << config_spot.id);
                         }
@@ -227,18 +348,40 @@ int main() {
             if (!device.is_connected()) {
                 LOG_WARN("Lost connection to ThingsBoard, attempting to reconnect...");
                 device.connect();
+            } else {
+                // Replay journaled telemetry at the configured rate
+                device.backfill_journal();
             }
             
             // Sleep for a short time to avoid busy waiting
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
         
+        // Upload whatever the current window has collected
+        device.flush_telemetry_window();
+        
         // Display final statistics
         const auto& stats = device.get_connection_stats();
         LOG_INFO("=== Final Statistics ===");
-        LOG_INFO("Connection attempts: " << stats.connection_attempts);
-        LOG_INFO("Messages sent: " << stats.messages_sent);
-        LOG_INFO("Connection failures: " << stats.connection_failures);
+        LOG_INFO("Connection attempts: " << stats.connection_attempts.load());
+        LOG_INFO("Messages sent: " << stats.messages_sent.load());
+        LOG_INFO("Readings suppressed by deadband: " << deadband_filter.getSuppressedCount());
+        const auto publisher_stats = device.get_publisher_stats();
+        if (publisher_stats.enqueued > 0) {
+            LOG_INFO("Publish queue: " << publisher_stats.published << " published, " << publisher_stats.failed
+                    << " failed, " << publisher_stats.dropped_oldest + publisher_stats.dropped_newest
+                    << " dropped, depth " << publisher_stats.depth);
+        }
+        const auto rpc_stats = device.get_rpc_stats();
+        LOG_INFO("RPC commands: " << rpc_stats.completed << " completed, " << rpc_stats.timed_out
+                << " timed out, " << rpc_stats.skipped << " skipped after timeout, "
+                << rpc_stats.rejected_busy << " refused as busy");
+        LOG_INFO("Connection failures: " << stats.connection_failures.load());
+        const auto deliveries = device.get_delivery_stats();
+        LOG_INFO("Deliveries: " << deliveries.delivered << " acknowledged, " << deliveries.failed << " failed, "
+                << deliveries.connection_lost << " lost with the connection, " << deliveries.in_flight
+                << " in flight (oldest " << deliveries.oldest_age.count() / 1000 << " ms)");
+        thermal::MetricsRegistry::instance().logSummary();
         LOG_INFO("========================");
         
         // Disconnect gracefully
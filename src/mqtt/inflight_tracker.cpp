@@ -0,0 +1,196 @@
+#include "mqtt/inflight_tracker.h"
+#include "common/logger.h"
+#include <algorithm>
+#include <exception>
+#include <utility>
+#include <vector>
+
+namespace thermal {
+
+constexpr size_t InFlightTracker::DEFAULT_MAX_TRACKED;
+
+namespace {
+
+const std::string DELIVERIES_HELP = "Outcomes of QoS > 0 publishes";
+
+void run_callback(const DeliveryCallback& on_complete, DeliveryResult result) {
+    if (!on_complete) {
+        return;
+    }
+    try {
+        on_complete(result);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Exception in publish completion callback: " << e.what());
+    }
+}
+
+} // namespace
+
+InFlightTracker::InFlightTracker(size_t max_tracked)
+    : max_tracked_(std::max<size_t>(max_tracked, 1))
+    , in_flight_gauge_(MetricsRegistry::instance().gauge(
+          "mqtt_inflight_messages", "QoS > 0 publishes awaiting delivery confirmation"))
+    , delivered_total_(MetricsRegistry::instance().counter(
+          "mqtt_deliveries_total", DELIVERIES_HELP, {{"outcome", "delivered"}}))
+    , failed_total_(MetricsRegistry::instance().counter(
+          "mqtt_deliveries_total", DELIVERIES_HELP, {{"outcome", "failed"}}))
+    , connection_lost_total_(MetricsRegistry::instance().counter(
+          "mqtt_deliveries_total", DELIVERIES_HELP, {{"outcome", "connection_lost"}})) {
+}
+
+bool InFlightTracker::track(int token, const std::string& topic, Clock::time_point sent_at,
+                            DeliveryCallback on_complete) {
+    DeliveryResult result = DeliveryResult::DELIVERED;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry entry{sent_at, &latencyLocked(topicClass(topic)), std::move(on_complete)};
+
+        // Tokens are message IDs and get reused; only an outcome newer than the send is ours
+        auto early = early_.find(token);
+        bool claimed = false;
+        if (early != early_.end()) {
+            EarlyOutcome outcome = early->second;
+            early_.erase(early);
+            if (outcome.at >= sent_at) {
+                finishLocked(entry, outcome.result, outcome.at);
+                result = outcome.result;
+                claimed = true;
+            }
+        }
+
+        if (!claimed) {
+            if (pending_.size() >= max_tracked_) {
+                return false;
+            }
+            pending_[token] = std::move(entry);
+            in_flight_gauge_.set(static_cast<std::int64_t>(pending_.size()));
+            return true;
+        }
+        on_complete = std::move(entry.on_complete);
+    }
+
+    run_callback(on_complete, result);
+    return true;
+}
+
+void InFlightTracker::complete(int token, DeliveryResult result) {
+    std::lock_guard<std::mutex> completion(completion_mutex_);
+    DeliveryCallback on_complete;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = Clock::now();
+        auto it = pending_.find(token);
+        if (it == pending_.end()) {
+            if (early_.size() < max_tracked_) {
+                early_[token] = {now, result};
+            }
+            return;
+        }
+
+        finishLocked(it->second, result, now);
+        on_complete = std::move(it->second.on_complete);
+        pending_.erase(it);
+        in_flight_gauge_.set(static_cast<std::int64_t>(pending_.size()));
+    }
+
+    run_callback(on_complete, result);
+}
+
+void InFlightTracker::failAll() {
+    std::lock_guard<std::mutex> completion(completion_mutex_);
+    std::vector<DeliveryCallback> callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = Clock::now();
+        for (auto& item : pending_) {
+            finishLocked(item.second, DeliveryResult::CONNECTION_LOST, now);
+            if (item.second.on_complete) {
+                callbacks.push_back(std::move(item.second.on_complete));
+            }
+        }
+        pending_.clear();
+        early_.clear();
+        in_flight_gauge_.set(0);
+    }
+
+    if (!callbacks.empty()) {
+        LOG_WARN(callbacks.size() << " publishes were not acknowledged before the connection closed");
+    }
+    for (const auto& on_complete : callbacks) {
+        run_callback(on_complete, DeliveryResult::CONNECTION_LOST);
+    }
+}
+
+void InFlightTracker::clear() {
+    std::lock_guard<std::mutex> completion(completion_mutex_);
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.clear();
+    early_.clear();
+    in_flight_gauge_.set(0);
+}
+
+InFlightStats InFlightTracker::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    InFlightStats stats;
+    stats.in_flight = pending_.size();
+    stats.delivered = delivered_;
+    stats.failed = failed_;
+    stats.connection_lost = connection_lost_;
+
+    auto now = Clock::now();
+    for (const auto& item : pending_) {
+        auto age = std::chrono::duration_cast<std::chrono::microseconds>(now - item.second.sent_at);
+        stats.oldest_age = std::max(stats.oldest_age, age);
+    }
+    return stats;
+}
+
+std::string InFlightTracker::topicClass(const std::string& topic) {
+    static const std::string DEVICE_PREFIX = "v1/devices/me/";
+    if (topic.compare(0, DEVICE_PREFIX.size(), DEVICE_PREFIX) != 0) {
+        return "other";
+    }
+    auto follows_prefix = [&topic](const std::string& name) {
+        return topic.compare(DEVICE_PREFIX.size(), name.size(), name) == 0;
+    };
+    if (follows_prefix("telemetry")) {
+        return "telemetry";
+    }
+    if (follows_prefix("attributes")) {
+        return "attributes";
+    }
+    if (follows_prefix("rpc/response/")) {
+        return "rpc_response";
+    }
+    return "other";
+}
+
+void InFlightTracker::finishLocked(const Entry& entry, DeliveryResult result, Clock::time_point at) {
+    switch (result) {
+        case DeliveryResult::DELIVERED:
+            entry.latency->recordDuration(at - entry.sent_at);
+            delivered_++;
+            delivered_total_.increment();
+            break;
+        case DeliveryResult::FAILED:
+            failed_++;
+            failed_total_.increment();
+            break;
+        case DeliveryResult::CONNECTION_LOST:
+            connection_lost_++;
+            connection_lost_total_.increment();
+            break;
+    }
+}
+
+Histogram& InFlightTracker::latencyLocked(const std::string& topic_class) {
+    Histogram*& histogram = latency_[topic_class];
+    if (!histogram) {
+        histogram = &MetricsRegistry::instance().histogram(
+            "mqtt_publish_delivery_microseconds", "Time from publish to broker acknowledgement (QoS > 0)",
+            {{"topic_class", topic_class}});
+    }
+    return *histogram;
+}
+
+} // namespace thermal
@@ -1,17 +1,41 @@
 #include "mqtt/paho_c_client.h"
 #include "common/logger.h"
+#include <algorithm>
 #include <stdexcept>
+#include <cstdint>
 #include <cstring>
 
 namespace thermal {
 
+namespace {
+
+// Per-message logs; failures repeat for every message during an outage
+constexpr std::int64_t OUTAGE_LOG_INTERVAL_MS = 10000;
+constexpr std::uint64_t DEBUG_LOG_EVERY_N = 100;
+constexpr std::uint64_t CALLBACK_ERROR_LOG_LIMIT = 10;
+
+std::int64_t steady_now_us() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+} // namespace
+
 PahoCClient::PahoCClient(const std::string& server_uri, 
                         const std::string& client_id,
                         MQTTEventCallback* callback)
     : client_(nullptr)
     , event_callback_(callback)
     , server_uri_(server_uri)
-    , client_id_(client_id) {
+    , client_id_(client_id)
+    , messages_sent_total_(MetricsRegistry::instance().counter(
+          "mqtt_messages_sent_total", "Messages handed to the MQTT client"))
+    , publish_failures_total_(MetricsRegistry::instance().counter(
+          "mqtt_publish_failures_total", "Publishes rejected by the MQTT client"))
+    , publish_call_latency_(MetricsRegistry::instance().histogram(
+          "mqtt_publish_call_microseconds", "Time spent in MQTTAsync_sendMessage"))
+    , reconnect_duration_(MetricsRegistry::instance().histogram(
+          "mqtt_reconnect_duration_microseconds", "Time from connection loss or first attempt until connected")) {
     
     int rc = MQTTAsync_create(&client_, server_uri.c_str(), client_id.c_str(),
                               MQTTCLIENT_PERSISTENCE_NONE, nullptr);
@@ -54,7 +78,8 @@ bool PahoCClient::connect(const std::string& username,
     }
     
     update_state(MQTTConnectionState::CONNECTING);
-    stats_.connection_attempts++;
+    stats_.connection_attempts.fetch_add(1, std::memory_order_relaxed);
+    mark_disconnected();
     
     MQTTAsync_connectOptions conn_opts = MQTTAsync_connectOptions_initializer;
     conn_opts.keepAliveInterval = keep_alive_seconds;
@@ -117,10 +142,11 @@ bool PahoCClient::is_connected() const {
 bool PahoCClient::publish(const std::string& topic,
                          const std::string& payload,
                          int qos,
-                         bool retained) {
+                         bool retained,
+                         DeliveryCallback on_complete) {
     
     if (!is_connected()) {
-        LOG_ERROR("Cannot publish: not connected to MQTT broker");
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Cannot publish: not connected to MQTT broker");
         return false;
     }
     
@@ -131,19 +157,28 @@ bool PahoCClient::publish(const std::string& topic,
     message.retained = retained ? 1 : 0;
     
     MQTTAsync_responseOptions opts = MQTTAsync_responseOptions_initializer;
+    opts.onFailure = on_publish_failure_wrapper;
     opts.context = this;
     
-    LOG_DEBUG("Publishing to topic '" << topic << "'");
+    LOG_DEBUG_EVERY_N(DEBUG_LOG_EVERY_N, "Publishing to topic '" << topic << "'");
     
+    auto sent_at = std::chrono::steady_clock::now();
     int rc = MQTTAsync_sendMessage(client_, topic.c_str(), &message, &opts);
+    publish_call_latency_.recordDuration(std::chrono::steady_clock::now() - sent_at);
     
     if (rc != MQTTASYNC_SUCCESS) {
-        LOG_ERROR("Failed to publish to topic '" << topic << "': " << rc);
+        publish_failures_total_.increment();
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Failed to publish to topic '" << topic << "': " << rc);
         return false;
     }
     
-    stats_.messages_sent++;
-    stats_.last_message_time = std::chrono::steady_clock::now();
+    if (qos > 0) {
+        inflight_.track(opts.token, topic, sent_at, std::move(on_complete));
+    }
+    
+    messages_sent_total_.increment();
+    stats_.messages_sent.fetch_add(1, std::memory_order_relaxed);
+    stats_.last_message_us.store(steady_now_us(), std::memory_order_relaxed);
     return true;
 }
 
@@ -195,7 +230,16 @@ const MQTTClientStats& PahoCClient::get_stats() const {
     return stats_;
 }
 
+InFlightStats PahoCClient::get_inflight_stats() const {
+    return inflight_.getStats();
+}
+
+void PahoCClient::drop_inflight() {
+    inflight_.clear();
+}
+
 void PahoCClient::set_event_callback(MQTTEventCallback* callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
     event_callback_ = callback;
 }
 
@@ -207,33 +251,38 @@ void PahoCClient::on_connection_lost_wrapper(void* context, char* cause) {
     LOG_WARN("MQTT connection lost: " << cause_str);
     
     client->update_state(MQTTConnectionState::DISCONNECTED);
-    client->stats_.last_error = cause_str;
+    client->mark_disconnected();
+    client->inflight_.failAll();
     
-    if (client->event_callback_) {
-        client->event_callback_->on_connection_lost(cause_str);
-    }
+    client->notify([&cause_str](MQTTEventCallback& callback) { callback.on_connection_lost(cause_str); });
 }
 
 int PahoCClient::on_message_arrived_wrapper(void* context, char* topicName, int topicLen, MQTTAsync_message* message) {
     auto* client = static_cast<PahoCClient*>(context);
     if (!client || !topicName || !message) {
-        LOG_ERROR("Invalid parameters in message arrived callback");
+        LOG_ERROR_FIRST_N(CALLBACK_ERROR_LOG_LIMIT, "Invalid parameters in message arrived callback");
         return 1; // Return 1 to indicate message was processed (even if error)
     }
     
-    std::string topic = topicLen > 0 ? std::string(topicName, topicLen) : std::string(topicName);
-    std::string payload;
+    // Lend Paho's buffers to the handler; they are freed once it returns
+    std::string_view topic = topicLen > 0 ? std::string_view(topicName, static_cast<size_t>(topicLen))
+                                          : std::string_view(topicName);
+    std::string_view payload;
     
     if (message->payload && message->payloadlen > 0) {
-        payload = std::string(static_cast<char*>(message->payload), message->payloadlen);
+        payload = std::string_view(static_cast<const char*>(message->payload), static_cast<size_t>(message->payloadlen));
     }
     
-    LOG_DEBUG("Message arrived on topic: " << topic << ", payload size: " << payload.size());
+    LOG_DEBUG_EVERY_N(DEBUG_LOG_EVERY_N, "Message arrived on topic: " << topic << ", payload size: " << payload.size());
     
     // Call the message handler if available
-    if (client->event_callback_) {
-        client->event_callback_->on_message_received(topic, payload);
-    }
+    client->notify([topic, payload](MQTTEventCallback& callback) {
+        try {
+            callback.on_message_view(topic, payload);
+        } catch (const std::exception& e) {
+            LOG_ERROR_FIRST_N(CALLBACK_ERROR_LOG_LIMIT, "Exception in message handler: " << e.what());
+        }
+    });
     
     // Free the message
     MQTTAsync_freeMessage(&message);
@@ -271,9 +320,8 @@ void PahoCClient::on_disconnect_wrapper(void* context, MQTTAsync_successData* re
     if (context) {
         PahoCClient* client = static_cast<PahoCClient*>(context);
         client->update_state(MQTTConnectionState::DISCONNECTED);
-        if (client->event_callback_) {
-            client->event_callback_->on_disconnected();
-        }
+        client->inflight_.failAll();
+        client->notify([](MQTTEventCallback& callback) { callback.on_disconnected(); });
     }
 }
 
@@ -296,6 +344,16 @@ void PahoCClient::on_subscribe_failure_wrapper(void* context, MQTTAsync_failureD
     LOG_ERROR("Failed to subscribe to RPC topic: " << error);
 }
 
+void PahoCClient::on_publish_failure_wrapper(void* context, MQTTAsync_failureData* response) {
+    if (!context || !response) {
+        LOG_ERROR_FIRST_N(CALLBACK_ERROR_LOG_LIMIT, "Invalid parameters in publish failure callback");
+        return;
+    }
+    LOG_WARN_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Publish failed (token: " << response->token << ", code: "
+                      << response->code << ")");
+    static_cast<PahoCClient*>(context)->inflight_.complete(response->token, DeliveryResult::FAILED);
+}
+
 // Private methods
 void PahoCClient::update_state(MQTTConnectionState new_state) {
     stats_.state = new_state;
@@ -303,33 +361,46 @@ void PahoCClient::update_state(MQTTConnectionState new_state) {
 
 void PahoCClient::handle_connection_success() {
     update_state(MQTTConnectionState::CONNECTED);
-    stats_.last_connect_time = std::chrono::steady_clock::now();
+    stats_.last_connect_us.store(steady_now_us(), std::memory_order_relaxed);
+    
+    std::int64_t since_us = disconnected_since_us_.exchange(0);
+    if (since_us > 0) {
+        reconnect_duration_.record(static_cast<std::uint64_t>(std::max<std::int64_t>(steady_now_us() - since_us, 0)));
+    }
     
     LOG_INFO("Successfully connected to MQTT broker");
     
-    if (event_callback_) {
-        event_callback_->on_connection_success();
-    }
+    notify([](MQTTEventCallback& callback) { callback.on_connection_success(); });
 }
 
 void PahoCClient::handle_connection_failure(const std::string& error) {
     update_state(MQTTConnectionState::FAILED);
-    stats_.connection_failures++;
-    stats_.last_error = error;
+    stats_.connection_failures.fetch_add(1, std::memory_order_relaxed);
     
     LOG_ERROR("MQTT connection failed: " << error);
     
-    if (event_callback_) {
-        event_callback_->on_connection_failure(error);
-    }
+    notify([&error](MQTTEventCallback& callback) { callback.on_connection_failure(error); });
 }
 
 void PahoCClient::handle_message_delivered(int token) {
-    LOG_DEBUG("Message delivery confirmed (token: " << token << ")");
+    LOG_DEBUG_EVERY_N(DEBUG_LOG_EVERY_N, "Message delivery confirmed (token: " << token << ")");
     
+    inflight_.complete(token, DeliveryResult::DELIVERED);
+    
+    notify([token](MQTTEventCallback& callback) { callback.on_message_delivered("", token); });
+}
+
+void PahoCClient::mark_disconnected() {
+    std::int64_t expected = 0;
+    disconnected_since_us_.compare_exchange_strong(expected, steady_now_us());
+}
+
+template <typename Event>
+void PahoCClient::notify(Event&& event) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
     if (event_callback_) {
-        event_callback_->on_message_delivered("", token);
+        event(*event_callback_);
     }
 }
 
-} // namespace thermal
\ No newline at end of file
+} // namespace thermal
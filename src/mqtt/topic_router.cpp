@@ -0,0 +1,20 @@
+#include "mqtt/topic_router.h"
+#include <utility>
+
+namespace thermal {
+
+void TopicRouter::add(std::string prefix, Handler handler) {
+    routes_.push_back({std::move(prefix), std::move(handler)});
+}
+
+bool TopicRouter::dispatch(std::string_view topic, std::string_view payload) const {
+    for (const auto& route : routes_) {
+        if (topic.compare(0, route.prefix.size(), route.prefix) == 0) {
+            route.handler(topic.substr(route.prefix.size()), payload);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace thermal
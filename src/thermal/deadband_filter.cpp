@@ -0,0 +1,89 @@
+#include "thermal/deadband_filter.h"
+#include <cmath>
+#include <utility>
+
+namespace thermal {
+
+DeadbandSettings DeadbandSettings::withOverrides(const MeasurementSpot& spot) const {
+    DeadbandSettings settings = *this;
+    if (spot.deadband_celsius) {
+        settings.deadband_celsius = *spot.deadband_celsius;
+    }
+    if (spot.deadband_percent) {
+        settings.deadband_percent = *spot.deadband_percent;
+    }
+    if (spot.heartbeat_seconds) {
+        settings.heartbeat_seconds = *spot.heartbeat_seconds;
+    }
+    return settings;
+}
+
+DeadbandFilter::DeadbandFilter(const DeadbandSettings& defaults, size_t capacity)
+    : defaults_(defaults), tracks_(capacity + 1) {
+}
+
+void DeadbandFilter::setSpotSettings(int spot_id, const DeadbandSettings& settings) {
+    if (spot_id < 1 || static_cast<size_t>(spot_id) >= tracks_.size()) {
+        return;
+    }
+    tracks_[spot_id].has_settings = true;
+    tracks_[spot_id].settings = settings;
+}
+
+void DeadbandFilter::resetSpot(int spot_id) {
+    if (spot_id < 1 || static_cast<size_t>(spot_id) >= tracks_.size()) {
+        return;
+    }
+    tracks_[spot_id] = SpotTrack();
+}
+
+bool DeadbandFilter::shouldPublish(const TemperatureReading& reading) {
+    if (reading.spot_id < 1 || static_cast<size_t>(reading.spot_id) >= tracks_.size()) {
+        // Untracked IDs are never held back
+        ++published_;
+        return true;
+    }
+
+    SpotTrack& track = tracks_[reading.spot_id];
+    const DeadbandSettings& settings = track.has_settings ? track.settings : defaults_;
+
+    bool publish = !track.has_sent || !settings.active();
+    if (!publish) {
+        double change = std::fabs(reading.temperature - track.last_value);
+        if (settings.deadband_celsius > 0.0 && change > settings.deadband_celsius) {
+            publish = true;
+        } else if (settings.deadband_percent > 0.0 &&
+                   change > std::fabs(track.last_value) * settings.deadband_percent / 100.0) {
+            publish = true;
+        } else if (settings.heartbeat_seconds > 0 &&
+                   reading.timestamp - track.last_sent_at >= std::chrono::seconds(settings.heartbeat_seconds)) {
+            publish = true;
+        }
+    }
+
+    if (!publish) {
+        ++suppressed_;
+        return false;
+    }
+
+    track.has_sent = true;
+    track.last_value = reading.temperature;
+    track.last_sent_at = reading.timestamp;
+    ++published_;
+    return true;
+}
+
+size_t DeadbandFilter::filter(TemperatureReading* readings, size_t count) {
+    size_t kept = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (shouldPublish(readings[i])) {
+            if (kept != i) {
+                readings[kept] = std::move(readings[i]);
+            }
+            ++kept;
+        }
+    }
+    return kept;
+}
+
+} // namespace thermal
@@ -0,0 +1,43 @@
+#include "thermal/frame/hotspot_finder.h"
+#include "common/simd.h"
+#include <algorithm>
+
+namespace thermal {
+
+FrameExtremes HotspotFinder::find(const ThermalFrame& frame) {
+    FrameExtremes extremes;
+    if (!frame.isValid()) {
+        return extremes;
+    }
+
+    const size_t width = static_cast<size_t>(frame.width);
+    int max_row = 0;
+    int min_row = 0;
+    simd::minMax(frame.row(0), width, extremes.min_temp, extremes.max_temp);
+
+    for (int y = 1; y < frame.height; ++y) {
+        float row_min = 0.0f;
+        float row_max = 0.0f;
+        simd::minMax(frame.row(y), width, row_min, row_max);
+        if (row_max > extremes.max_temp) {
+            extremes.max_temp = row_max;
+            max_row = y;
+        }
+        if (row_min < extremes.min_temp) {
+            extremes.min_temp = row_min;
+            min_row = y;
+        }
+    }
+
+    const float* hot_row = frame.row(max_row);
+    const float* cold_row = frame.row(min_row);
+    extremes.max_location = {static_cast<int>(std::max_element(hot_row, hot_row + width) - hot_row), max_row};
+    extremes.min_location = {static_cast<int>(std::min_element(cold_row, cold_row + width) - cold_row), min_row};
+    extremes.sequence = frame.sequence;
+    extremes.captured_at = frame.captured_at;
+    extremes.valid = true;
+
+    return extremes;
+}
+
+} // namespace thermal
@@ -0,0 +1,26 @@
+#include "thermal/frame/integral_image.h"
+
+namespace thermal {
+
+void IntegralImage::build(const ThermalFrame& frame) {
+    width_ = frame.width;
+    height_ = frame.height;
+    sequence_ = frame.sequence;
+
+    const size_t stride = static_cast<size_t>(width_) + 1;
+    table_.assign(stride * (static_cast<size_t>(height_) + 1), 0.0);
+
+    for (int y = 0; y < height_; ++y) {
+        const float* pixels = frame.row(y);
+        const double* above = table_.data() + static_cast<size_t>(y) * stride;
+        double* current = table_.data() + static_cast<size_t>(y + 1) * stride;
+
+        double row_sum = 0.0;
+        for (int x = 0; x < width_; ++x) {
+            row_sum += pixels[x];
+            current[x + 1] = above[x + 1] + row_sum;
+        }
+    }
+}
+
+} // namespace thermal
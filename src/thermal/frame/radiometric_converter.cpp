@@ -0,0 +1,62 @@
+#include "thermal/frame/radiometric_converter.h"
+#include "common/simd.h"
+#include <cmath>
+
+namespace thermal {
+
+namespace {
+
+constexpr double KELVIN_OFFSET = 273.15;
+
+} // namespace
+
+RadiometricConverter::RadiometricConverter(const RadiometricCalibration& calibration)
+    : lut_(LUT_SIZE) {
+    setCalibration(calibration);
+}
+
+void RadiometricConverter::setCalibration(const RadiometricCalibration& calibration) {
+    calibration_ = calibration;
+
+    for (size_t count = 0; count < LUT_SIZE; ++count) {
+        double kelvin = 0.0;
+        if (calibration_.usesPlanck()) {
+            double signal = static_cast<double>(count) - calibration_.planck_o;
+            double ratio = signal > 0.0 ? calibration_.planck_r / signal + calibration_.planck_f : 0.0;
+            // Counts at or below the offset carry no signal; clamp to absolute zero
+            kelvin = ratio > 1.0 ? calibration_.planck_b / std::log(ratio) : 0.0;
+        } else {
+            kelvin = static_cast<double>(count) * calibration_.kelvin_per_count;
+        }
+        lut_[count] = static_cast<float>(kelvin - KELVIN_OFFSET);
+    }
+}
+
+void RadiometricConverter::convert(const std::uint16_t* counts, size_t count, float* celsius) const {
+    const float* lut = lut_.data();
+    for (size_t i = 0; i < count; ++i) {
+        celsius[i] = lut[counts[i]];
+    }
+}
+
+void RadiometricConverter::compensationCoefficients(double emissivity, double reflected_temp,
+                                                    float& gain, float& offset) {
+    const double reflected_kelvin = reflected_temp + KELVIN_OFFSET;
+    gain = static_cast<float>(1.0 / emissivity);
+    offset = static_cast<float>((KELVIN_OFFSET - (1.0 - emissivity) * reflected_kelvin) / emissivity
+                                - KELVIN_OFFSET);
+}
+
+void RadiometricConverter::applyCompensation(const float* in, const float* gain, const float* offset,
+                                             size_t count, float* out) {
+    size_t i = 0;
+    for (; i + simd::LANES <= count; i += simd::LANES) {
+        simd::f32x4 value = simd::mul(simd::load(in + i), simd::load(gain + i));
+        simd::store(out + i, simd::add(value, simd::load(offset + i)));
+    }
+    for (; i < count; ++i) {
+        out[i] = in[i] * gain[i] + offset[i];
+    }
+}
+
+} // namespace thermal
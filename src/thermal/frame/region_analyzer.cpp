@@ -0,0 +1,130 @@
+#include "thermal/frame/region_analyzer.h"
+#include "common/simd.h"
+#include <algorithm>
+#include <cmath>
+
+namespace thermal {
+
+void RegionAnalyzer::update(const ThermalFrame& frame) {
+    frame_ = &frame;
+
+    if (integral_.sequence() != frame.sequence ||
+        integral_.width() != frame.width || integral_.height() != frame.height) {
+        integral_.build(frame);
+    }
+}
+
+AreaStatistics RegionAnalyzer::measure(const MeasurementArea& area) const {
+    if (area.shape == AreaShape::POLYGON) {
+        return measurePolygon(area.vertices);
+    }
+    return measureBox(area.x, area.y, area.width, area.height);
+}
+
+AreaStatistics RegionAnalyzer::measureBox(int x, int y, int width, int height) const {
+    SpanAccumulator acc;
+    if (!frame_ || !frame_->isValid()) {
+        return finish(acc);
+    }
+
+    // Clip to the frame
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + width, frame_->width);
+    int y1 = std::min(y + height, frame_->height);
+    if (x0 >= x1 || y0 >= y1) {
+        return finish(acc);
+    }
+
+    for (int row = y0; row < y1; ++row) {
+        addSpan(acc, row, x0, x1);
+    }
+
+    // The mean comes straight from the integral image in O(1)
+    acc.sum = integral_.sum(x0, y0, x1 - x0, y1 - y0);
+    return finish(acc);
+}
+
+AreaStatistics RegionAnalyzer::measurePolygon(const std::vector<Point>& vertices) const {
+    SpanAccumulator acc;
+    if (!frame_ || !frame_->isValid() || vertices.size() < 3) {
+        return finish(acc);
+    }
+
+    int min_y = vertices[0].y;
+    int max_y = vertices[0].y;
+    for (const auto& vertex : vertices) {
+        min_y = std::min(min_y, vertex.y);
+        max_y = std::max(max_y, vertex.y);
+    }
+    min_y = std::max(min_y, 0);
+    max_y = std::min(max_y, frame_->height);
+
+    std::vector<double> crossings;
+    crossings.reserve(vertices.size());
+
+    for (int row = min_y; row < max_y; ++row) {
+        // Even-odd scanline through the pixel centers of this row
+        const double center_y = row + 0.5;
+        crossings.clear();
+        for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++) {
+            const Point& a = vertices[j];
+            const Point& b = vertices[i];
+            if ((a.y <= center_y) != (b.y <= center_y)) {
+                crossings.push_back(a.x + (center_y - a.y) * (b.x - a.x) / (b.y - a.y));
+            }
+        }
+        std::sort(crossings.begin(), crossings.end());
+
+        for (size_t k = 0; k + 1 < crossings.size(); k += 2) {
+            // Pixel x is inside when its center x + 0.5 lies in [left, right)
+            int x0 = std::max(static_cast<int>(std::ceil(crossings[k] - 0.5)), 0);
+            int x1 = std::min(static_cast<int>(std::ceil(crossings[k + 1] - 0.5)), frame_->width);
+            if (x0 < x1) {
+                addSpan(acc, row, x0, x1);
+                acc.sum += integral_.sum(x0, row, x1 - x0, 1);
+            }
+        }
+    }
+
+    return finish(acc);
+}
+
+void RegionAnalyzer::addSpan(SpanAccumulator& acc, int y, int x0, int x1) const {
+    float span_min = 0.0f;
+    float span_max = 0.0f;
+    simd::minMax(frame_->row(y) + x0, static_cast<size_t>(x1 - x0), span_min, span_max);
+
+    if (acc.count == 0 || span_min < acc.min_temp) {
+        acc.min_temp = span_min;
+    }
+    if (acc.count == 0 || span_max > acc.max_temp) {
+        acc.max_temp = span_max;
+        acc.hottest_row = y;
+        acc.hottest_x0 = x0;
+        acc.hottest_x1 = x1;
+    }
+    acc.count += static_cast<size_t>(x1 - x0);
+}
+
+AreaStatistics RegionAnalyzer::finish(const SpanAccumulator& acc) const {
+    AreaStatistics stats;
+    if (acc.count == 0) {
+        return stats;
+    }
+
+    stats.valid = true;
+    stats.min_temp = acc.min_temp;
+    stats.max_temp = acc.max_temp;
+    stats.mean_temp = acc.sum / static_cast<double>(acc.count);
+    stats.pixel_count = acc.count;
+
+    // Only the winning span is rescanned to locate the hottest pixel
+    const float* row = frame_->row(acc.hottest_row);
+    const float* hottest = std::max_element(row + acc.hottest_x0, row + acc.hottest_x1);
+    stats.hottest = {static_cast<int>(hottest - row), acc.hottest_row};
+
+    return stats;
+}
+
+} // namespace thermal
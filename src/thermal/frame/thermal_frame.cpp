@@ -0,0 +1,20 @@
+#include "thermal/frame/thermal_frame.h"
+#include <stdexcept>
+
+namespace thermal {
+
+ThermalFrame::ThermalFrame(int frame_width, int frame_height) {
+    resize(frame_width, frame_height);
+}
+
+void ThermalFrame::resize(int frame_width, int frame_height) {
+    if (frame_width <= 0 || frame_height <= 0) {
+        throw std::invalid_argument("Frame dimensions must be positive");
+    }
+    
+    width = frame_width;
+    height = frame_height;
+    pixels.resize(static_cast<size_t>(width) * height);
+}
+
+} // namespace thermal
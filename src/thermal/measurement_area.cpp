@@ -0,0 +1,112 @@
+#include "thermal/measurement_area.h"
+#include <stdexcept>
+
+namespace thermal {
+
+bool MeasurementArea::validate() const {
+    if (id <= 0 || static_cast<size_t>(id) > MAX_MEASUREMENT_AREAS) {
+        throw std::invalid_argument("Area ID must be between 1 and " + std::to_string(MAX_MEASUREMENT_AREAS));
+    }
+
+    if (name.empty()) {
+        throw std::invalid_argument("Area name cannot be empty");
+    }
+
+    if (shape == AreaShape::BOX) {
+        if (x < 0 || y < 0) {
+            throw std::invalid_argument("Box coordinates must be non-negative");
+        }
+        if (width <= 0 || height <= 0) {
+            throw std::invalid_argument("Box width and height must be positive");
+        }
+    } else {
+        if (vertices.size() < 3) {
+            throw std::invalid_argument("Polygon must have at least 3 vertices");
+        }
+        for (const auto& vertex : vertices) {
+            if (vertex.x < 0 || vertex.y < 0) {
+                throw std::invalid_argument("Polygon vertices must be non-negative");
+            }
+        }
+    }
+
+    return true;
+}
+
+void MeasurementArea::from_json(const nlohmann::json& json_data) {
+    if (json_data.contains("id")) {
+        id = json_data["id"].get<int>();
+    }
+    if (json_data.contains("name")) {
+        name = json_data["name"].get<std::string>();
+    }
+    if (json_data.contains("shape")) {
+        shape = areaShapeFromString(json_data["shape"].get<std::string>());
+    }
+    if (json_data.contains("x")) {
+        x = json_data["x"].get<int>();
+    }
+    if (json_data.contains("y")) {
+        y = json_data["y"].get<int>();
+    }
+    if (json_data.contains("width")) {
+        width = json_data["width"].get<int>();
+    }
+    if (json_data.contains("height")) {
+        height = json_data["height"].get<int>();
+    }
+    if (json_data.contains("vertices")) {
+        const auto& points = json_data["vertices"];
+        if (!points.is_array()) {
+            throw std::invalid_argument("Polygon vertices must be an array");
+        }
+        vertices.clear();
+        vertices.reserve(points.size());
+        for (const auto& point : points) {
+            vertices.push_back({point.at("x").get<int>(), point.at("y").get<int>()});
+        }
+    }
+    if (json_data.contains("enabled")) {
+        enabled = json_data["enabled"].get<bool>();
+    }
+}
+
+nlohmann::json MeasurementArea::to_json() const {
+    nlohmann::json result{
+        {"id", id},
+        {"name", name},
+        {"shape", areaShapeToString(shape)},
+        {"enabled", enabled}
+    };
+
+    if (shape == AreaShape::BOX) {
+        result["x"] = x;
+        result["y"] = y;
+        result["width"] = width;
+        result["height"] = height;
+    } else {
+        nlohmann::json points = nlohmann::json::array();
+        for (const auto& vertex : vertices) {
+            points.push_back({{"x", vertex.x}, {"y", vertex.y}});
+        }
+        result["vertices"] = points;
+    }
+
+    return result;
+}
+
+std::string areaShapeToString(AreaShape shape) {
+    return shape == AreaShape::POLYGON ? "polygon" : "box";
+}
+
+AreaShape areaShapeFromString(const std::string& name) {
+    if (name == "box") {
+        return AreaShape::BOX;
+    }
+    if (name == "polygon") {
+        return AreaShape::POLYGON;
+    }
+    throw std::invalid_argument("Unknown area shape: " + name);
+}
+
+} // namespace thermal
@@ -5,6 +5,23 @@
 
 namespace thermal {
 
+int parse_spot_id(const std::string& spot_id) {
+    // Plain decimal without sign or leading zeros, so each ID has one spelling
+    if (spot_id.empty() || spot_id.size() > 9 || spot_id[0] == '0') {
+        return 0;
+    }
+    
+    int id = 0;
+    for (char c : spot_id) {
+        if (c < '0' || c > '9') {
+            return 0;
+        }
+        id = id * 10 + (c - '0');
+    }
+    
+    return static_cast<size_t>(id) <= MAX_MEASUREMENT_SPOTS ? id : 0;
+}
+
 bool MeasurementSpot::validate() const {
     if (id <= 0) {
         throw std::invalid_argument("Spot ID must be positive");
@@ -37,6 +54,23 @@ bool MeasurementSpot::validate() const {
         throw std::invalid_argument("Noise factor must be between 0.0 and 1.0");
     }
     
+    if (emissivity <= 0.0 || emissivity > 1.0) {
+        throw std::invalid_argument("Emissivity must be greater than 0.0 and at most 1.0");
+    }
+    
+    // Same -100°C to 500°C limits as the temperature range (also rejects NaN)
+    if (!(reflected_temp >= -100.0 && reflected_temp <= 500.0)) {
+        throw std::invalid_argument("Reflected temperature must be between -100°C and 500°C");
+    }
+    
+    if ((deadband_celsius && *deadband_celsius < 0.0) || (deadband_percent && *deadband_percent < 0.0)) {
+        throw std::invalid_argument("Deadband must be non-negative");
+    }
+    
+    if (heartbeat_seconds && *heartbeat_seconds < 0) {
+        throw std::invalid_argument("Heartbeat interval must be non-negative");
+    }
+    
     return true;
 }
 
@@ -62,9 +96,24 @@ void MeasurementSpot::from_json(const nlohmann::json& json_data) {
     if (json_data.contains("noise_factor")) {
         noise_factor = json_data["noise_factor"].get<double>();
     }
+    if (json_data.contains("emissivity")) {
+        emissivity = json_data["emissivity"].get<double>();
+    }
+    if (json_data.contains("reflected_temp")) {
+        reflected_temp = json_data["reflected_temp"].get<double>();
+    }
     if (json_data.contains("enabled")) {
         enabled = json_data["enabled"].get<bool>();
     }
+    if (json_data.contains("deadband_celsius")) {
+        deadband_celsius = json_data["deadband_celsius"].get<double>();
+    }
+    if (json_data.contains("deadband_percent")) {
+        deadband_percent = json_data["deadband_percent"].get<double>();
+    }
+    if (json_data.contains("heartbeat_seconds")) {
+        heartbeat_seconds = json_data["heartbeat_seconds"].get<int>();
+    }
     if (json_data.contains("created_at")) {
         created_at = json_data["created_at"].get<std::string>();
     }
@@ -77,7 +126,7 @@ void MeasurementSpot::from_json(const nlohmann::json& json_data) {
 }
 
 nlohmann::json MeasurementSpot::to_json() const {
-    return nlohmann::json{
+    nlohmann::json json_data{
         {"id", id},
         {"name", name},
         {"x", x},
@@ -85,10 +134,25 @@ nlohmann::json MeasurementSpot::to_json() const {
         {"min_temp", min_temp},
         {"max_temp", max_temp},
         {"noise_factor", noise_factor},
+        {"emissivity", emissivity},
+        {"reflected_temp", reflected_temp},
         {"enabled", enabled},
         {"created_at", created_at},
         {"last_reading_at", last_reading_at}
     };
+    
+    // Overrides are only written when set, so defaults keep applying
+    if (deadband_celsius) {
+        json_data["deadband_celsius"] = *deadband_celsius;
+    }
+    if (deadband_percent) {
+        json_data["deadband_percent"] = *deadband_percent;
+    }
+    if (heartbeat_seconds) {
+        json_data["heartbeat_seconds"] = *heartbeat_seconds;
+    }
+    
+    return json_data;
 }
 
 double MeasurementSpot::generate_temperature() const {
@@ -1,9 +1,9 @@
 #include "thermal/rpc/thermal_rpc_handler.h"
 #include "common/logger.h"
-#include <set>
 #include <cmath>
 #include <chrono>
 #include <iomanip>
+#include <vector>
 
 namespace thermal {
 
@@ -18,16 +18,8 @@ void ThermalRPCHandler::setResponseCallback(ResponseCallback callback) {
     response_callback_ = callback;
 }
 
-bool ThermalRPCHandler::isSupported(const std::string& method) const {
-    static const std::set<std::string> supported_methods = {
-        "createSpotMeasurement",
-        "moveSpotMeasurement", 
-        "deleteSpotMeasurement",
-        "listSpotMeasurements",
-        "getSpotTemperature"
-    };
-    
-    return supported_methods.find(method) != supported_methods.end();
+bool ThermalRPCHandler::isSupported(RPCMethod method) const {
+    return method != RPCMethod::UNKNOWN;
 }
 
 void ThermalRPCHandler::handleRPCCommand(const std::string& request_id, const RPCCommand& command) {
@@ -36,44 +28,66 @@ void ThermalRPCHandler::handleRPCCommand(const std::string& request_id, const RP
         return;
     }
     
-    // Convert method enum to string for comparison
-    std::string method_str = RPCCommand::methodToString(command.method);
-    LOG_INFO("Processing RPC method: " << method_str);
+    LOG_INFO("Processing RPC method: " << RPCCommand::methodToString(command.method));
     
-    // Route to appropriate handler based on method
-    if (method_str == "createSpotMeasurement") {
-        handleCreateSpotMeasurement(request_id, command);
-    } else if (method_str == "moveSpotMeasurement") {
-        handleMoveSpotMeasurement(request_id, command);
-    } else if (method_str == "deleteSpotMeasurement") {
-        handleDeleteSpotMeasurement(request_id, command);
-    } else if (method_str == "listSpotMeasurements") {
-        handleListSpotMeasurements(request_id, command);
-    } else if (method_str == "getSpotTemperature") {
-        handleGetSpotTemperature(request_id, command);
-    } else {
-        sendErrorResponse(request_id, RPCErrorCodes::UNKNOWN_METHOD, 
-                         "Unsupported thermal RPC method: " + method_str);
+    // Arguments were validated by RPCParser; only their presence is checked here
+    const RPCArguments& args = command.arguments;
+    switch (command.method) {
+        case RPCMethod::CREATE_SPOT_MEASUREMENT:
+            if (auto create = std::get_if<CreateSpotArgs>(&args)) {
+                return handleCreateSpotMeasurement(request_id, *create);
+            }
+            break;
+        case RPCMethod::MOVE_SPOT_MEASUREMENT:
+            if (auto move = std::get_if<MoveSpotArgs>(&args)) {
+                return handleMoveSpotMeasurement(request_id, *move);
+            }
+            break;
+        case RPCMethod::DELETE_SPOT_MEASUREMENT:
+            if (auto remove = std::get_if<DeleteSpotArgs>(&args)) {
+                return handleDeleteSpotMeasurement(request_id, *remove);
+            }
+            break;
+        case RPCMethod::LIST_SPOT_MEASUREMENTS:
+            return handleListSpotMeasurements(request_id);
+        case RPCMethod::GET_SPOT_TEMPERATURE:
+            if (auto get = std::get_if<GetSpotTemperatureArgs>(&args)) {
+                return handleGetSpotTemperature(request_id, *get);
+            }
+            break;
+        case RPCMethod::APPLY_SPOT_BATCH:
+            if (auto batch = std::get_if<ApplySpotBatchArgs>(&args)) {
+                return handleApplySpotBatch(request_id, *batch);
+            }
+            break;
+        case RPCMethod::UNKNOWN:
+        default:
+            sendErrorResponse(request_id, RPCErrorCodes::UNKNOWN_METHOD,
+                             "Unsupported thermal RPC method: " + RPCCommand::methodToString(command.method));
+            return;
     }
+    
+    sendErrorResponse(request_id, RPCErrorCodes::MISSING_PARAMETERS,
+                     command.error.empty() ? "Missing required parameters" : command.error);
 }
 
-void ThermalRPCHandler::handleCreateSpotMeasurement(const std::string& request_id, const RPCCommand& command) {
-    // Validate required parameters
-    if (!validateCreateSpotParams(command)) {
-        sendErrorResponse(request_id, RPCErrorCodes::MISSING_PARAMETERS,
-                         "Missing required parameters: spotId, x, y");
-        return;
-    }
+void ThermalRPCHandler::handleCreateSpotMeasurement(const std::string& request_id, const CreateSpotArgs& args) {
+    // spotId is optional; a free ID is assigned if omitted
+    std::string spot_id = args.spotId;
+    int x = args.x;
+    int y = args.y;
     
-    // Extract parameters
-    std::string spot_id = command.parameters.at("spotId").get<std::string>();
-    int x = command.parameters.at("x").get<int>();
-    int y = command.parameters.at("y").get<int>();
-    
-    LOG_INFO("Creating thermal spot: ID=" << spot_id << " at position (" << x << ", " << y << ")");
+    LOG_INFO("Creating thermal spot: ID=" << (spot_id.empty() ? "<auto>" : spot_id)
+             << " at position (" << x << ", " << y << ")");
     
     // Create spot via manager
-    bool success = spot_manager_->createSpot(spot_id, x, y);
+    bool success = false;
+    if (spot_id.empty()) {
+        spot_id = spot_manager_->createSpot(x, y);
+        success = !spot_id.empty();
+    } else {
+        success = spot_manager_->createSpot(spot_id, x, y);
+    }
     
     if (success) {
         // Get temperature reading for the new spot
@@ -101,19 +115,20 @@ void ThermalRPCHandler::handleCreateSpotMeasurement(const std::string& request_i
         std::string error_message = "Failed to create spot";
         
         // Check if spot already exists
-        if (spot_manager_->spotExists(spot_id)) {
+        if (!spot_id.empty() && spot_manager_->spotExists(spot_id)) {
             error_code = RPCErrorCodes::SPOT_ALREADY_EXISTS;
             error_message = "Spot with ID '" + spot_id + "' already exists";
         }
-        // Check if coordinates are invalid (basic range check)
-        else if (x < 0 || x > 319 || y < 0 || y > 239) {
+        // Check if coordinates are invalid for the active temperature source
+        else if (!spot_manager_->validateCoordinates(x, y)) {
             error_code = RPCErrorCodes::INVALID_COORDINATES;
             error_message = "Invalid coordinates: x must be 0-319, y must be 0-239";
         }
         // Check if max spots reached
-        else if (spot_manager_->getActiveSpotCount() >= 5) {
+        else if (spot_manager_->isMaxSpotsReached()) {
             error_code = RPCErrorCodes::MAX_SPOTS_REACHED;
-            error_message = "Maximum number of spots (5) already created";
+            error_message = "Maximum number of spots (" + std::to_string(ThermalSpotManager::MAX_SPOTS) +
+                            ") already created";
         }
         
         LOG_ERROR("✗ Failed to create spot " << spot_id << ": " << error_message);
@@ -121,18 +136,10 @@ void ThermalRPCHandler::handleCreateSpotMeasurement(const std::string& request_i
     }
 }
 
-void ThermalRPCHandler::handleMoveSpotMeasurement(const std::string& request_id, const RPCCommand& command) {
-    // Validate required parameters  
-    if (!validateMoveSpotParams(command)) {
-        sendErrorResponse(request_id, RPCErrorCodes::MISSING_PARAMETERS,
-                         "Missing required parameters: spotId, x, y");
-        return;
-    }
-    
-    // Extract parameters
-    std::string spot_id = command.parameters.at("spotId").get<std::string>();
-    int x = command.parameters.at("x").get<int>();
-    int y = command.parameters.at("y").get<int>();
+void ThermalRPCHandler::handleMoveSpotMeasurement(const std::string& request_id, const MoveSpotArgs& args) {
+    const std::string& spot_id = args.spotId;
+    int x = args.x;
+    int y = args.y;
     
     // Check if spot exists first
     if (!spot_manager_->spotExists(spot_id)) {
@@ -161,16 +168,8 @@ void ThermalRPCHandler::handleMoveSpotMeasurement(const std::string& request_id,
     }
 }
 
-void ThermalRPCHandler::handleDeleteSpotMeasurement(const std::string& request_id, const RPCCommand& command) {
-    // Validate required parameters
-    if (!validateDeleteSpotParams(command)) {
-        sendErrorResponse(request_id, RPCErrorCodes::MISSING_PARAMETERS,
-                         "Missing required parameter: spotId");
-        return;
-    }
-    
-    // Extract parameters
-    std::string spot_id = command.parameters.at("spotId").get<std::string>();
+void ThermalRPCHandler::handleDeleteSpotMeasurement(const std::string& request_id, const DeleteSpotArgs& args) {
+    const std::string& spot_id = args.spotId;
     
     // Check if spot exists first
     if (!spot_manager_->spotExists(spot_id)) {
@@ -196,7 +195,7 @@ void ThermalRPCHandler::handleDeleteSpotMeasurement(const std::string& request_i
     }
 }
 
-void ThermalRPCHandler::handleListSpotMeasurements(const std::string& request_id, const RPCCommand& /* command */) {
+void ThermalRPCHandler::handleListSpotMeasurements(const std::string& request_id) {
     LOG_DEBUG("Processing listSpotMeasurements RPC command");
     
     // Get all spots from manager
@@ -246,16 +245,8 @@ void ThermalRPCHandler::handleListSpotMeasurements(const std::string& request_id
     sendSuccessResponse(request_id, response_data);
 }
 
-void ThermalRPCHandler::handleGetSpotTemperature(const std::string& request_id, const RPCCommand& command) {
-    // Validate required parameters
-    if (!validateGetTempParams(command)) {
-        sendErrorResponse(request_id, RPCErrorCodes::MISSING_PARAMETERS,
-                         "Missing required parameter: spotId");
-        return;
-    }
-    
-    // Extract parameters
-    std::string spot_id = command.parameters.at("spotId").get<std::string>();
+void ThermalRPCHandler::handleGetSpotTemperature(const std::string& request_id, const GetSpotTemperatureArgs& args) {
+    const std::string& spot_id = args.spotId;
     
     // Check if spot exists first
     if (!spot_manager_->spotExists(spot_id)) {
@@ -283,13 +274,120 @@ void ThermalRPCHandler::handleGetSpotTemperature(const std::string& request_id,
     }
 }
 
-void ThermalRPCHandler::sendErrorResponse(const std::string& request_id, const std::string& error_code, const std::string& error_message) {
+void ThermalRPCHandler::handleApplySpotBatch(const std::string& request_id, const ApplySpotBatchArgs& args) {
+    static const char* const op_names[] = {"create", "move", "delete"};
+    
+    std::vector<SpotChange> changes;
+    changes.reserve(args.operations.size());
+    for (const auto& operation : args.operations) {
+        SpotChange change;
+        if (auto create = std::get_if<CreateSpotArgs>(&operation)) {
+            change = {SpotChange::Type::CREATE, create->spotId, create->x, create->y};
+        } else if (auto move = std::get_if<MoveSpotArgs>(&operation)) {
+            change = {SpotChange::Type::MOVE, move->spotId, move->x, move->y};
+        } else {
+            change = {SpotChange::Type::DELETE, std::get<DeleteSpotArgs>(operation).spotId, 0, 0};
+        }
+        changes.push_back(std::move(change));
+    }
+    
+    LOG_INFO("Applying spot batch of " << changes.size() << " operations");
+    
+    std::vector<SpotChangeResult> results;
+    bool applied = spot_manager_->applySpotChanges(changes, results);
+    
+    // One entry per operation, in request order
+    nlohmann::json results_array = nlohmann::json::array();
+    std::string first_error_code;
+    size_t failed = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const SpotChange& change = changes[i];
+        const SpotChangeResult& result = results[i];
+        nlohmann::json item = {
+            {"op", op_names[static_cast<int>(change.type)]},
+            {"spotId", result.spotId}
+        };
+        
+        std::string error_code;
+        std::string error_message;
+        switch (result.status) {
+            case SpotChangeStatus::APPLIED: {
+                static const char* const applied_status[] = {"created", "moved", "deleted"};
+                item["status"] = applied_status[static_cast<int>(change.type)];
+                break;
+            }
+            case SpotChangeStatus::NOT_APPLIED:
+                item["status"] = "not_applied";
+                break;
+            case SpotChangeStatus::INVALID_SPOT_ID:
+                error_code = RPCErrorCodes::INVALID_SPOT_ID;
+                error_message = "Invalid spotId '" + result.spotId + "'";
+                break;
+            case SpotChangeStatus::SPOT_EXISTS:
+                error_code = RPCErrorCodes::SPOT_ALREADY_EXISTS;
+                error_message = "Spot with ID '" + result.spotId + "' already exists";
+                break;
+            case SpotChangeStatus::SPOT_NOT_FOUND:
+                error_code = RPCErrorCodes::SPOT_NOT_FOUND;
+                error_message = "Spot with ID '" + result.spotId + "' not found";
+                break;
+            case SpotChangeStatus::INVALID_COORDINATES:
+                error_code = RPCErrorCodes::INVALID_COORDINATES;
+                error_message = "Invalid coordinates: x must be 0-319, y must be 0-239";
+                break;
+            case SpotChangeStatus::MAX_SPOTS_REACHED:
+                error_code = RPCErrorCodes::MAX_SPOTS_REACHED;
+                error_message = "Maximum number of spots (" + std::to_string(ThermalSpotManager::MAX_SPOTS) +
+                                ") already created";
+                break;
+            case SpotChangeStatus::INVALID_SPOT:
+            default:
+                error_code = RPCErrorCodes::INTERNAL_ERROR;
+                error_message = "Failed to " + std::string(op_names[static_cast<int>(change.type)]) + " spot";
+                break;
+        }
+        
+        if (!error_code.empty()) {
+            item["status"] = "failed";
+            item["error"] = {
+                {"code", error_code},
+                {"message", error_message}
+            };
+            if (first_error_code.empty()) {
+                first_error_code = error_code;
+            }
+            failed++;
+        }
+        results_array.push_back(std::move(item));
+    }
+    
+    if (applied) {
+        nlohmann::json response_data = {
+            {"status", "applied"},
+            {"count", results.size()},
+            {"results", results_array}
+        };
+        sendSuccessResponse(request_id, response_data);
+    } else {
+        // Nothing was applied; the code of the first failure classifies the batch
+        sendErrorResponse(request_id, first_error_code.empty() ? RPCErrorCodes::INTERNAL_ERROR : first_error_code,
+                         "Spot batch rejected: " + std::to_string(failed) + " of " + std::to_string(results.size()) +
+                         " operations failed, no changes applied",
+                         results_array);
+    }
+}
+
+void ThermalRPCHandler::sendErrorResponse(const std::string& request_id, const std::string& error_code, const std::string& error_message,
+                                          const nlohmann::json& results) {
     nlohmann::json response = {
         {"error", {
             {"code", error_code},
             {"message", error_message}
         }}
     };
+    if (!results.is_null()) {
+        response["error"]["results"] = results;
+    }
     
     LOG_DEBUG("Sending error response for request " << request_id << ": " << error_message);
     
@@ -314,24 +412,4 @@ void ThermalRPCHandler::sendSuccessResponse(const std::string& request_id, const
     }
 }
 
-bool ThermalRPCHandler::validateCreateSpotParams(const RPCCommand& command) {
-    return command.parameters.contains("spotId") && command.parameters["spotId"].is_string() &&
-           command.parameters.contains("x") && command.parameters["x"].is_number_integer() &&
-           command.parameters.contains("y") && command.parameters["y"].is_number_integer();
-}
-
-bool ThermalRPCHandler::validateMoveSpotParams(const RPCCommand& command) {
-    return command.parameters.contains("spotId") && command.parameters["spotId"].is_string() &&
-           command.parameters.contains("x") && command.parameters["x"].is_number_integer() &&
-           command.parameters.contains("y") && command.parameters["y"].is_number_integer();
-}
-
-bool ThermalRPCHandler::validateDeleteSpotParams(const RPCCommand& command) {
-    return command.parameters.contains("spotId") && command.parameters["spotId"].is_string();
-}
-
-bool ThermalRPCHandler::validateGetTempParams(const RPCCommand& command) {
-    return command.parameters.contains("spotId") && command.parameters["spotId"].is_string();
-}
-
 } // namespace thermal
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "thermal/spot_manager/spot_store.h"
+#include "thermal/frame/radiometric_converter.h"
+#include <algorithm>
+#include <utility>
+
+namespace thermal {
+
+SpotStore::SpotStore(size_t capacity)
+    : capacity_(capacity)
+    , slot_of_id_(capacity + 1, -1)
+    , id_queued_(capacity + 1, 0) {
+    
+    ids_.reserve(capacity_);
+    positions_.reserve(capacity_);
+    min_temps_.reserve(capacity_);
+    max_temps_.reserve(capacity_);
+    enabled_.reserve(capacity_);
+    compensation_gains_.reserve(capacity_);
+    compensation_offsets_.reserve(capacity_);
+}
+
+bool SpotStore::insert(const MeasurementSpot& spot) {
+    if (spot.id < 1 || static_cast<size_t>(spot.id) > capacity_ || contains(spot.id)) {
+        return false;
+    }
+    
+    slot_of_id_[spot.id] = static_cast<int>(ids_.size());
+    
+    ids_.push_back(spot.id);
+    positions_.push_back({spot.x, spot.y});
+    min_temps_.push_back(spot.min_temp);
+    max_temps_.push_back(spot.max_temp);
+    enabled_.push_back(spot.enabled ? 1 : 0);
+    
+    float gain = 1.0f;
+    float offset = 0.0f;
+    RadiometricConverter::compensationCoefficients(spot.emissivity, spot.reflected_temp, gain, offset);
+    compensation_gains_.push_back(gain);
+    compensation_offsets_.push_back(offset);
+    
+    names_.push_back(spot.name);
+    noise_factors_.push_back(spot.noise_factor);
+    emissivities_.push_back(spot.emissivity);
+    reflected_temps_.push_back(spot.reflected_temp);
+    deadbands_celsius_.push_back(spot.deadband_celsius);
+    deadbands_percent_.push_back(spot.deadband_percent);
+    heartbeats_seconds_.push_back(spot.heartbeat_seconds);
+    created_at_.push_back(spot.created_at);
+    last_reading_at_.push_back(spot.last_reading_at);
+    
+    return true;
+}
+
+bool SpotStore::update(int id, int x, int y, double min_temp, double max_temp) {
+    int slot = slotOf(id);
+    if (slot < 0) {
+        return false;
+    }
+    
+    positions_[slot] = {x, y};
+    min_temps_[slot] = min_temp;
+    max_temps_[slot] = max_temp;
+    return true;
+}
+
+bool SpotStore::erase(int id) {
+    int slot = slotOf(id);
+    if (slot < 0) {
+        return false;
+    }
+    
+    // Swap the last slot into the hole so columns stay dense
+    size_t last = ids_.size() - 1;
+    if (static_cast<size_t>(slot) != last) {
+        ids_[slot] = ids_[last];
+        positions_[slot] = positions_[last];
+        min_temps_[slot] = min_temps_[last];
+        max_temps_[slot] = max_temps_[last];
+        enabled_[slot] = enabled_[last];
+        compensation_gains_[slot] = compensation_gains_[last];
+        compensation_offsets_[slot] = compensation_offsets_[last];
+        names_[slot] = std::move(names_[last]);
+        noise_factors_[slot] = noise_factors_[last];
+        emissivities_[slot] = emissivities_[last];
+        reflected_temps_[slot] = reflected_temps_[last];
+        deadbands_celsius_[slot] = deadbands_celsius_[last];
+        deadbands_percent_[slot] = deadbands_percent_[last];
+        heartbeats_seconds_[slot] = heartbeats_seconds_[last];
+        created_at_[slot] = std::move(created_at_[last]);
+        last_reading_at_[slot] = std::move(last_reading_at_[last]);
+        slot_of_id_[ids_[slot]] = slot;
+    }
+    
+    ids_.pop_back();
+    positions_.pop_back();
+    min_temps_.pop_back();
+    max_temps_.pop_back();
+    enabled_.pop_back();
+    compensation_gains_.pop_back();
+    compensation_offsets_.pop_back();
+    names_.pop_back();
+    noise_factors_.pop_back();
+    emissivities_.pop_back();
+    reflected_temps_.pop_back();
+    deadbands_celsius_.pop_back();
+    deadbands_percent_.pop_back();
+    heartbeats_seconds_.pop_back();
+    created_at_.pop_back();
+    last_reading_at_.pop_back();
+    
+    slot_of_id_[id] = -1;
+    
+    // An ID still queued from an earlier release is not queued again, so
+    // create/delete churn of explicit IDs keeps the list bounded by capacity
+    if (!id_queued_[id]) {
+        id_queued_[id] = 1;
+        free_ids_.push_back(id);
+    }
+    return true;
+}
+
+void SpotStore::clear() {
+    ids_.clear();
+    positions_.clear();
+    min_temps_.clear();
+    max_temps_.clear();
+    enabled_.clear();
+    compensation_gains_.clear();
+    compensation_offsets_.clear();
+    names_.clear();
+    noise_factors_.clear();
+    emissivities_.clear();
+    reflected_temps_.clear();
+    deadbands_celsius_.clear();
+    deadbands_percent_.clear();
+    heartbeats_seconds_.clear();
+    created_at_.clear();
+    last_reading_at_.clear();
+    
+    std::fill(slot_of_id_.begin(), slot_of_id_.end(), -1);
+    free_ids_.clear();
+    std::fill(id_queued_.begin(), id_queued_.end(), 0);
+    next_unused_id_ = 1;
+}
+
+int SpotStore::allocateId() {
+    // Released IDs first; entries re-taken by an explicit insert are stale
+    while (!free_ids_.empty()) {
+        int id = free_ids_.back();
+        if (!contains(id)) {
+            return id;
+        }
+        free_ids_.pop_back();
+        id_queued_[id] = 0;
+    }
+    
+    // Every free ID below the high-water mark is on the free list, so only
+    // IDs at or above it remain to be scanned
+    while (static_cast<size_t>(next_unused_id_) <= capacity_ && contains(next_unused_id_)) {
+        ++next_unused_id_;
+    }
+    
+    return static_cast<size_t>(next_unused_id_) <= capacity_ ? next_unused_id_ : 0;
+}
+
+MeasurementSpot SpotStore::toSpot(int slot) const {
+    MeasurementSpot spot;
+    spot.id = ids_[slot];
+    spot.name = names_[slot];
+    spot.x = positions_[slot].x;
+    spot.y = positions_[slot].y;
+    spot.min_temp = min_temps_[slot];
+    spot.max_temp = max_temps_[slot];
+    spot.noise_factor = noise_factors_[slot];
+    spot.emissivity = emissivities_[slot];
+    spot.reflected_temp = reflected_temps_[slot];
+    spot.deadband_celsius = deadbands_celsius_[slot];
+    spot.deadband_percent = deadbands_percent_[slot];
+    spot.heartbeat_seconds = heartbeats_seconds_[slot];
+    spot.enabled = enabled_[slot] != 0;
+    spot.created_at = created_at_[slot];
+    spot.last_reading_at = last_reading_at_[slot];
+    spot.set_state(spot.enabled ? SpotState::ACTIVE : SpotState::INACTIVE);
+    return spot;
+}
+
+} // namespace thermal
@@ -1,15 +1,21 @@
 #include "thermal/spot_manager/thermal_spot_manager.h"
 #include "thermal/spot_manager/spot_persistence.h"
+#include "thermal/frame/radiometric_converter.h"
+#include "thermal/frame/thermal_frame.h"
 #include "common/logger.h"
+#include "common/metrics.h"
 #include <algorithm>
 #include <cmath>
+#include <utility>
 
 namespace thermal {
 
 ThermalSpotManager::ThermalSpotManager(std::unique_ptr<TemperatureDataSource> temp_source,
                                      const std::string& persistence_file)
-    : temp_source_(std::move(temp_source))
-    , persistence_file_path_(persistence_file) {
+    : spots_(MAX_SPOTS)
+    , temp_source_(std::move(temp_source))
+    , persistence_file_path_(persistence_file)
+    , spot_changed_(MAX_SPOTS + 1, 0) {
     
     if (!temp_source_) {
         throw std::invalid_argument("Temperature source cannot be null");
@@ -32,19 +38,70 @@ ThermalSpotManager::~ThermalSpotManager() {
 
 bool ThermalSpotManager::createSpot(const std::string& spotId, int x, int y) {
     // Validate spot ID
-    if (!validateSpotId(spotId)) {
+    int id = parseSpotId(spotId);
+    if (id == 0) {
         LOG_ERROR("Invalid spot ID: " << spotId);
         return false;
     }
     
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!createSpotWithId(id, x, y)) {
+        return false;
+    }
+    
+    // Save to persistence
+    persistAndUnlock(lock);
+    
+    LOG_INFO("Created spot " << id << " at coordinates (" << x << ", " << y << ")");
+    return true;
+}
+
+bool ThermalSpotManager::createSpot(const MeasurementSpot& config) {
+    if (config.id < 1 || static_cast<size_t>(config.id) > MAX_SPOTS) {
+        LOG_ERROR("Invalid spot ID: " << config.id);
+        return false;
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!createSpotWithId(config.id, config.x, config.y, &config)) {
+        return false;
+    }
+    
+    // Save to persistence
+    persistAndUnlock(lock);
+    
+    LOG_INFO("Created spot " << config.id << " at coordinates (" << config.x << ", " << config.y << ")");
+    return true;
+}
+
+std::string ThermalSpotManager::createSpot(int x, int y) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    int id = spots_.allocateId();
+    if (id == 0) {
+        LOG_ERROR("Maximum spots (" << MAX_SPOTS << ") already reached");
+        return "";
+    }
+    
+    if (!createSpotWithId(id, x, y)) {
+        return "";
+    }
+    
+    // Save to persistence
+    persistAndUnlock(lock);
+    
+    LOG_INFO("Created spot " << id << " at coordinates (" << x << ", " << y << ")");
+    return std::to_string(id);
+}
+
+bool ThermalSpotManager::createSpotWithId(int id, int x, int y, const MeasurementSpot* config) {
     // Check if spot already exists
-    if (spotExists(spotId)) {
-        LOG_ERROR("Spot " << spotId << " already exists");
+    if (spots_.contains(id)) {
+        LOG_ERROR("Spot " << id << " already exists");
         return false;
     }
     
     // Check maximum spots limit
-    if (isMaxSpotsReached()) {
+    if (spots_.full()) {
         LOG_ERROR("Maximum spots (" << MAX_SPOTS << ") already reached");
         return false;
     }
@@ -56,18 +113,41 @@ bool ThermalSpotManager::createSpot(const std::string& spotId, int x, int y) {
     }
     
     // Create new spot
-    auto spot = std::make_unique<MeasurementSpot>();
-    spot->id = std::stoi(spotId);  // Convert string ID to int for MeasurementSpot
-    spot->name = generateSpotName(spotId);
-    spot->enabled = true;
-    spot->set_state(SpotState::ACTIVE);
+    MeasurementSpot spot;
+    if (!buildSpot(id, x, y, spot, config)) {
+        return false;
+    }
+    
+    // Add to spots collection
+    spots_.insert(spot);
+    markChanged(id);
+    return true;
+}
+
+bool ThermalSpotManager::buildSpot(int id, int x, int y, MeasurementSpot& spot,
+                                   const MeasurementSpot* config) const {
+    if (config) {
+        spot.emissivity = config->emissivity;
+        spot.reflected_temp = config->reflected_temp;
+        spot.deadband_celsius = config->deadband_celsius;
+        spot.deadband_percent = config->deadband_percent;
+        spot.heartbeat_seconds = config->heartbeat_seconds;
+    }
+    
+    spot.id = id;
+    spot.name = generateSpotName(std::to_string(id));
+    spot.enabled = true;
+    spot.set_state(SpotState::ACTIVE);
+    spot.x = x;
+    spot.y = y;
+    spot.noise_factor = 0.1;  // Small noise factor for MeasurementSpot's own variation
     
     // Configure with temperature source
-    configureSpotWithTemperatureSource(*spot, x, y);
+    computeTemperatureRange(x, y, spot.min_temp, spot.max_temp);
     
     // Validate the configured spot
     try {
-        if (!spot->validate()) {
+        if (!spot.validate()) {
             LOG_ERROR("Spot validation failed after configuration");
             return false;
         }
@@ -76,19 +156,15 @@ bool ThermalSpotManager::createSpot(const std::string& spotId, int x, int y) {
         return false;
     }
     
-    // Add to spots collection
-    spots_[spotId] = std::move(spot);
-    
-    // Save to persistence
-    saveSpots();
-    
-    LOG_INFO("Created spot " << spotId << " at coordinates (" << x << ", " << y << ")");
     return true;
 }
 
 bool ThermalSpotManager::moveSpot(const std::string& spotId, int x, int y) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    
     // Check if spot exists
-    if (!spotExists(spotId)) {
+    int id = parseSpotId(spotId);
+    if (!spotExistsLocked(id)) {
         LOG_ERROR("Spot " << spotId << " does not exist");
         return false;
     }
@@ -100,75 +176,304 @@ bool ThermalSpotManager::moveSpot(const std::string& spotId, int x, int y) {
     }
     
     // Update spot coordinates and temperature configuration
-    auto& spot = spots_[spotId];
-    configureSpotWithTemperatureSource(*spot, x, y);
+    double min_temp = 0.0;
+    double max_temp = 0.0;
+    computeTemperatureRange(x, y, min_temp, max_temp);
+    spots_.update(id, x, y, min_temp, max_temp);
+    markChanged(id);
     
     // Save to persistence
-    saveSpots();
+    persistAndUnlock(lock);
     
     LOG_INFO("Moved spot " << spotId << " to coordinates (" << x << ", " << y << ")");
     return true;
 }
 
 bool ThermalSpotManager::deleteSpot(const std::string& spotId) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    
     // Check if spot exists
-    if (!spotExists(spotId)) {
+    int id = parseSpotId(spotId);
+    if (!spotExistsLocked(id)) {
         LOG_ERROR("Spot " << spotId << " does not exist");
         return false;
     }
     
-    // Remove from collection
-    spots_.erase(spotId);
+    // Remove from collection (ID returns to the free list)
+    spots_.erase(id);
+    markChanged(id);
     
     // Save to persistence
-    saveSpots();
+    persistAndUnlock(lock);
     
     LOG_INFO("Deleted spot " << spotId);
     return true;
 }
 
+bool ThermalSpotManager::applySpotChanges(const std::vector<SpotChange>& changes,
+                                          std::vector<SpotChangeResult>& results) {
+    results.assign(changes.size(), SpotChangeResult());
+    if (changes.empty()) {
+        return true;
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    
+    // Stage on a copy so a failure part-way leaves the live spots untouched;
+    // failed changes are skipped and the rest still checked
+    SpotStore staged = spots_;
+    size_t failed = 0;
+    for (size_t i = 0; i < changes.size(); ++i) {
+        results[i].status = stageChange(staged, changes[i], results[i].spotId);
+        if (results[i].status != SpotChangeStatus::APPLIED) {
+            failed++;
+        }
+    }
+    
+    if (failed > 0) {
+        for (size_t i = 0; i < changes.size(); ++i) {
+            if (results[i].status == SpotChangeStatus::APPLIED) {
+                results[i].status = SpotChangeStatus::NOT_APPLIED;
+                results[i].spotId = changes[i].spotId;  // Drop IDs that were only assigned in staging
+            }
+        }
+        LOG_ERROR("Rejected spot batch: " << failed << " of " << changes.size() << " changes failed");
+        return false;
+    }
+    
+    spots_ = std::move(staged);
+    for (const auto& result : results) {
+        markChanged(parseSpotId(result.spotId));
+    }
+    
+    // Save to persistence once for the whole batch
+    persistAndUnlock(lock);
+    
+    LOG_INFO("Applied spot batch of " << changes.size() << " changes");
+    return true;
+}
+
+SpotChangeStatus ThermalSpotManager::stageChange(SpotStore& store, const SpotChange& change,
+                                                 std::string& spotId) const {
+    spotId = change.spotId;
+    
+    int id = 0;
+    if (change.type == SpotChange::Type::CREATE && change.spotId.empty()) {
+        id = store.allocateId();
+        if (id == 0) {
+            return SpotChangeStatus::MAX_SPOTS_REACHED;
+        }
+        spotId = std::to_string(id);
+    } else {
+        id = parseSpotId(change.spotId);
+        if (id == 0) {
+            return SpotChangeStatus::INVALID_SPOT_ID;
+        }
+    }
+    
+    switch (change.type) {
+        case SpotChange::Type::CREATE: {
+            if (store.contains(id)) {
+                return SpotChangeStatus::SPOT_EXISTS;
+            }
+            if (store.full()) {
+                return SpotChangeStatus::MAX_SPOTS_REACHED;
+            }
+            if (!validateCoordinates(change.x, change.y)) {
+                return SpotChangeStatus::INVALID_COORDINATES;
+            }
+            
+            MeasurementSpot spot;
+            if (!buildSpot(id, change.x, change.y, spot)) {
+                return SpotChangeStatus::INVALID_SPOT;
+            }
+            store.insert(spot);
+            return SpotChangeStatus::APPLIED;
+        }
+        
+        case SpotChange::Type::MOVE: {
+            if (!isActive(store, id)) {
+                return SpotChangeStatus::SPOT_NOT_FOUND;
+            }
+            if (!validateCoordinates(change.x, change.y)) {
+                return SpotChangeStatus::INVALID_COORDINATES;
+            }
+            
+            double min_temp = 0.0;
+            double max_temp = 0.0;
+            computeTemperatureRange(change.x, change.y, min_temp, max_temp);
+            store.update(id, change.x, change.y, min_temp, max_temp);
+            return SpotChangeStatus::APPLIED;
+        }
+        
+        case SpotChange::Type::DELETE:
+        default:
+            if (!isActive(store, id)) {
+                return SpotChangeStatus::SPOT_NOT_FOUND;
+            }
+            store.erase(id);
+            return SpotChangeStatus::APPLIED;
+    }
+}
+
 std::vector<MeasurementSpot> ThermalSpotManager::listSpots() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return listSpotsLocked();
+}
+
+std::vector<MeasurementSpot> ThermalSpotManager::listSpotsLocked() const {
     std::vector<MeasurementSpot> result;
+    result.reserve(spots_.size());
     
-    for (const auto& [id, spot] : spots_) {
-        if (spot) {
-            result.push_back(*spot);  // Copy spot for read-only access
-        }
+    for (size_t slot = 0; slot < spots_.size(); ++slot) {
+        result.push_back(spots_.toSpot(static_cast<int>(slot)));  // Copy spot for read-only access
     }
     
+    // Dense slots are reordered by deletes; present spots in ID order
+    std::sort(result.begin(), result.end(),
+              [](const MeasurementSpot& a, const MeasurementSpot& b) { return a.id < b.id; });
+    
     return result;
 }
 
+bool ThermalSpotManager::getSpot(int id, MeasurementSpot& spot) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    int slot = spots_.slotOf(id);
+    if (slot < 0) {
+        return false;
+    }
+    
+    spot = spots_.toSpot(slot);
+    return true;
+}
+
+std::vector<int> ThermalSpotManager::takeChangedSpots() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    std::vector<int> changed;
+    changed.swap(changed_spots_);
+    for (int id : changed) {
+        spot_changed_[id] = 0;
+    }
+    return changed;
+}
+
+void ThermalSpotManager::markChanged(int id) {
+    if (id < 1 || static_cast<size_t>(id) > MAX_SPOTS || spot_changed_[id]) {
+        return;
+    }
+    spot_changed_[id] = 1;
+    changed_spots_.push_back(id);
+}
+
 float ThermalSpotManager::getSpotTemperature(const std::string& spotId) const {
-    if (!spotExists(spotId)) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    
+    int id = parseSpotId(spotId);
+    if (!spotExistsLocked(id)) {
         return std::numeric_limits<float>::quiet_NaN();
     }
     
-    const auto& spot = spots_.at(spotId);
-    
-    if (!spot->is_ready() || !temp_source_->isReady()) {
+    if (!temp_source_->isReady()) {
         return std::numeric_limits<float>::quiet_NaN();
     }
     
-    // Get temperature from the data source
-    return temp_source_->getTemperature(spot->x, spot->y);
+    // Get temperature from the data source and apply the spot's compensation
+    int slot = spots_.slotOf(id);
+    const Point& position = spots_.positions()[slot];
+    float measured;
+    {
+        std::lock_guard<std::mutex> source_lock(source_mutex_);
+        measured = temp_source_->getTemperature(position.x, position.y);
+    }
+    return measured * spots_.compensationGains()[slot] + spots_.compensationOffsets()[slot];
+}
+
+std::vector<TemperatureReading> ThermalSpotManager::sampleSpots() {
+    std::vector<TemperatureReading> readings;
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    area_readings_.clear();
+    
+    if (!temp_source_->isReady() || !temp_source_->captureFrame()) {
+        LOG_WARN("Temperature source not ready, skipping spot sampling");
+        return readings;
+    }
+    
+    static Histogram& processing_time = MetricsRegistry::instance().histogram(
+        "frame_processing_microseconds", "Time to sample, compensate and scan one captured frame");
+    ScopedLatency latency(processing_time);
+    
+    // One batched call per cycle straight over the contiguous position column
+    const auto& positions = spots_.positions();
+    sample_temperatures_.resize(positions.size());
+    temp_source_->getTemperatures(positions.data(), positions.size(), sample_temperatures_.data());
+    
+    // Per-spot emissivity and reflected-temperature compensation in one vectorized pass
+    RadiometricConverter::applyCompensation(sample_temperatures_.data(), spots_.compensationGains().data(),
+                                            spots_.compensationOffsets().data(), sample_temperatures_.size(),
+                                            sample_temperatures_.data());
+    
+    const ThermalFrame* frame = temp_source_->getCurrentFrame();
+    auto timestamp = frame ? frame->captured_at : getCurrentTimestamp();
+    frame_extremes_ = frame ? HotspotFinder::find(*frame) : FrameExtremes();
+    
+    // The summed-area table is only built when there are areas to measure
+    if (frame && !areas_.empty()) {
+        region_analyzer_.update(*frame);
+        for (const auto& area : areas_) {
+            if (area.enabled) {
+                area_readings_.push_back({area.id, region_analyzer_.measure(area)});
+            }
+        }
+    }
+    
+    const auto& ids = spots_.ids();
+    const auto& enabled = spots_.enabled();
+    readings.reserve(ids.size());
+    for (size_t slot = 0; slot < ids.size(); ++slot) {
+        if (!enabled[slot]) {
+            continue;
+        }
+        
+        TemperatureReading reading(ids[slot], sample_temperatures_[slot]);
+        reading.timestamp = timestamp;
+        readings.push_back(reading);
+    }
+    
+    return readings;
+}
+
+void ThermalSpotManager::setAreas(const std::vector<MeasurementArea>& areas) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    areas_ = areas;
+    LOG_INFO("Measuring " << areas_.size() << " areas per frame");
 }
 
 bool ThermalSpotManager::spotExists(const std::string& spotId) const {
-    auto it = spots_.find(spotId);
-    return it != spots_.end() && it->second && it->second->is_ready();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return spotExistsLocked(parseSpotId(spotId));
+}
+
+bool ThermalSpotManager::isActive(const SpotStore& store, int id) {
+    int slot = store.slotOf(id);
+    return slot >= 0 && store.enabled()[slot];
 }
 
 size_t ThermalSpotManager::getActiveSpotCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
     return spots_.size();
 }
 
 bool ThermalSpotManager::isMaxSpotsReached() const {
-    return getActiveSpotCount() >= MAX_SPOTS;
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return spots_.full();
 }
 
 bool ThermalSpotManager::validateSpotId(const std::string& spotId) {
-    return spotId == "1" || spotId == "2" || spotId == "3" || spotId == "4" || spotId == "5";
+    return parseSpotId(spotId) != 0;
+}
+
+int ThermalSpotManager::parseSpotId(const std::string& spotId) {
+    return parse_spot_id(spotId);
 }
 
 bool ThermalSpotManager::validateCoordinates(int x, int y) const {
@@ -185,13 +490,21 @@ bool ThermalSpotManager::loadSpots() {
             return false;
         }
         
-        // Convert to spot ID mapping
+        // Move into dense storage; out-of-range or duplicate IDs are dropped
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (int id : spots_.ids()) {
+            markChanged(id);
+        }
         spots_.clear();
-        for (auto& spot : loaded_spots) {
-            if (spot && spot->id >= 1 && spot->id <= 5) {
-                std::string spotId = std::to_string(spot->id);
-                spots_[spotId] = std::move(spot);
+        for (const auto& spot : loaded_spots) {
+            if (!spot) {
+                continue;
             }
+            if (!spots_.insert(*spot)) {
+                LOG_WARN("Skipping persisted spot with invalid or duplicate ID " << spot->id);
+                continue;
+            }
+            markChanged(spot->id);
         }
         
         LOG_INFO("Loaded " << spots_.size() << " spots from persistence");
@@ -204,14 +517,29 @@ bool ThermalSpotManager::loadSpots() {
 }
 
 bool ThermalSpotManager::saveSpots() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return persistAndUnlock(lock);
+}
+
+template <typename Lock>
+bool ThermalSpotManager::persistAndUnlock(Lock& lock) const {
+    auto snapshot = listSpotsLocked();
+    
+    // Take the write turn before letting the next mutation in, so the file
+    // always ends up holding the latest state
+    std::lock_guard<std::mutex> persist_lock(persist_mutex_);
+    lock.unlock();
+    return writeSpots(snapshot);
+}
+
+bool ThermalSpotManager::writeSpots(const std::vector<MeasurementSpot>& spots) const {
     try {
         SpotPersistence persistence(persistence_file_path_);
         
         std::vector<std::unique_ptr<MeasurementSpot>> spots_to_save;
-        for (const auto& [id, spot] : spots_) {
-            if (spot) {
-                spots_to_save.push_back(std::make_unique<MeasurementSpot>(*spot));  // Copy for persistence
-            }
+        spots_to_save.reserve(spots.size());
+        for (const auto& spot : spots) {
+            spots_to_save.push_back(std::make_unique<MeasurementSpot>(spot));  // Copy for persistence
         }
         
         if (!persistence.saveSpots(spots_to_save)) {
@@ -228,23 +556,18 @@ bool ThermalSpotManager::saveSpots() const {
     }
 }
 
-void ThermalSpotManager::configureSpotWithTemperatureSource(MeasurementSpot& spot, int x, int y) {
-    spot.x = x;
-    spot.y = y;
-    
+void ThermalSpotManager::computeTemperatureRange(int x, int y, double& min_temp, double& max_temp) const {
     if (temp_source_->isReady()) {
         // Get base temperature for this coordinate
         float base_temp = temp_source_->getBaseTemperature(x, y);
         
         // Configure temperature range with ±0.5°C variation
-        spot.min_temp = base_temp - 0.5;
-        spot.max_temp = base_temp + 0.5;
-        spot.noise_factor = 0.1;  // Small noise factor for MeasurementSpot's own variation
+        min_temp = base_temp - 0.5;
+        max_temp = base_temp + 0.5;
     } else {
         LOG_WARN("Temperature source not ready, using default temperature range");
-        spot.min_temp = 20.0;
-        spot.max_temp = 25.0;
-        spot.noise_factor = 0.1;
+        min_temp = 20.0;
+        max_temp = 25.0;
     }
 }
 
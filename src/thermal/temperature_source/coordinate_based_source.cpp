@@ -1,4 +1,5 @@
 #include "thermal/temperature_source/coordinate_based_source.h"
+#include "common/simd.h"
 #include <cmath>
 #include <algorithm>
 
@@ -20,6 +21,31 @@ float CoordinateBasedTemperatureSource::getTemperature(int x, int y) {
     return base_temp + variation;
 }
 
+void CoordinateBasedTemperatureSource::getTemperatures(const Point* points, size_t count, float* temperatures) {
+    float xs[simd::LANES];
+    float ys[simd::LANES];
+    float base[simd::LANES];
+    
+    for (size_t i = 0; i < count; i += simd::LANES) {
+        size_t lanes = std::min(count - i, static_cast<size_t>(simd::LANES));
+        
+        // Pad a partial tail with the image center so unused lanes stay finite
+        for (size_t lane = 0; lane < static_cast<size_t>(simd::LANES); ++lane) {
+            xs[lane] = lane < lanes ? static_cast<float>(points[i + lane].x) : CENTER_X;
+            ys[lane] = lane < lanes ? static_cast<float>(points[i + lane].y) : CENTER_Y;
+        }
+        
+        calculateBaseTemperatures4(xs, ys, base);
+        
+        for (size_t lane = 0; lane < lanes; ++lane) {
+            const Point& point = points[i + lane];
+            temperatures[i + lane] = validateCoordinates(point.x, point.y)
+                ? base[lane] + generateRandomVariation()
+                : 20.0f; // Default temperature for invalid coordinates
+        }
+    }
+}
+
 bool CoordinateBasedTemperatureSource::isReady() const {
     return true; // Coordinate-based source is always ready
 }
@@ -61,6 +87,23 @@ float CoordinateBasedTemperatureSource::calculateDistanceFromCenter(int x, int y
     return std::min(1.0f, std::max(0.0f, normalized_distance));
 }
 
+void CoordinateBasedTemperatureSource::calculateBaseTemperatures4(const float* xs, const float* ys,
+                                                                   float* base_temps) const {
+    static const float inv_max_distance = 1.0f / std::sqrt(CENTER_X * CENTER_X + CENTER_Y * CENTER_Y);
+    
+    simd::f32x4 dx = simd::sub(simd::load(xs), simd::set1(CENTER_X));
+    simd::f32x4 dy = simd::sub(simd::load(ys), simd::set1(CENTER_Y));
+    simd::f32x4 distance = simd::sqrt(simd::add(simd::mul(dx, dx), simd::mul(dy, dy)));
+    
+    // Normalize and clamp to [0.0, 1.0], then interpolate between base temperatures
+    simd::f32x4 normalized = simd::mul(distance, simd::set1(inv_max_distance));
+    normalized = simd::min(simd::set1(1.0f), simd::max(simd::set1(0.0f), normalized));
+    simd::f32x4 result = simd::add(simd::set1(MIN_BASE_TEMP),
+                                   simd::mul(simd::set1(MAX_BASE_TEMP - MIN_BASE_TEMP), normalized));
+    
+    simd::store(base_temps, result);
+}
+
 float CoordinateBasedTemperatureSource::generateRandomVariation() const {
     return variation_dist_(gen_);
 }
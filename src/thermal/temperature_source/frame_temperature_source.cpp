@@ -0,0 +1,111 @@
+#include "thermal/temperature_source/frame_temperature_source.h"
+#include "thermal/temperature_source/coordinate_based_source.h"
+#include <algorithm>
+#include <random>
+
+namespace thermal {
+
+FrameTemperatureSource::FrameTemperatureSource()
+    : FrameTemperatureSource(ThermalFrame::DEFAULT_WIDTH, ThermalFrame::DEFAULT_HEIGHT) {
+    
+    // Precompute the static scene once; captures only add noise on top of it
+    CoordinateBasedTemperatureSource model;
+    base_temperatures_.resize(frame_.pixelCount());
+    for (int y = 0; y < frame_.height; ++y) {
+        for (int x = 0; x < frame_.width; ++x) {
+            base_temperatures_[static_cast<size_t>(y) * frame_.width + x] = model.getBaseTemperature(x, y);
+        }
+    }
+}
+
+FrameTemperatureSource::FrameTemperatureSource(int width, int height)
+    : frame_(width, height)
+    , noise_state_(std::random_device{}() | 1u) {
+}
+
+float FrameTemperatureSource::getTemperature(int x, int y) {
+    if (!validateCoordinates(x, y)) {
+        return DEFAULT_TEMPERATURE;
+    }
+    
+    if (!frame_.isValid() && !captureFrame()) {
+        return DEFAULT_TEMPERATURE;
+    }
+    
+    return frame_.at(x, y);
+}
+
+void FrameTemperatureSource::getTemperatures(const Point* points, size_t count, float* temperatures) {
+    if (!frame_.isValid() && !captureFrame()) {
+        std::fill(temperatures, temperatures + count, DEFAULT_TEMPERATURE);
+        return;
+    }
+    
+    for (size_t i = 0; i < count; ++i) {
+        const Point& point = points[i];
+        temperatures[i] = frame_.contains(point.x, point.y) ? frame_.at(point.x, point.y) : DEFAULT_TEMPERATURE;
+    }
+}
+
+bool FrameTemperatureSource::isReady() const {
+    return frame_.pixelCount() > 0;
+}
+
+std::string FrameTemperatureSource::getSourceName() const {
+    return "FrameTemperatureSource";
+}
+
+bool FrameTemperatureSource::validateCoordinates(int x, int y) const {
+    return frame_.contains(x, y);
+}
+
+float FrameTemperatureSource::getBaseTemperature(int x, int y) const {
+    if (!validateCoordinates(x, y) || base_temperatures_.empty()) {
+        return DEFAULT_TEMPERATURE;
+    }
+    
+    return base_temperatures_[static_cast<size_t>(y) * frame_.width + x];
+}
+
+bool FrameTemperatureSource::captureFrame() {
+    if (!renderFrame(frame_)) {
+        return false;
+    }
+    
+    frame_.sequence = next_sequence_++;
+    frame_.captured_at = std::chrono::system_clock::now();
+    return true;
+}
+
+const ThermalFrame* FrameTemperatureSource::getCurrentFrame() const {
+    return frame_.isValid() ? &frame_ : nullptr;
+}
+
+bool FrameTemperatureSource::renderFrame(ThermalFrame& frame) {
+    const size_t count = frame.pixelCount();
+    if (base_temperatures_.size() != count) {
+        return false;
+    }
+    
+    float* out = frame.pixels.data();
+    const float* base = base_temperatures_.data();
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = base[i] + nextVariation();
+    }
+    
+    return true;
+}
+
+float FrameTemperatureSource::nextVariation() {
+    // xorshift32: a full frame needs tens of thousands of draws per capture,
+    // so a Mersenne Twister + distribution per pixel is too expensive here
+    noise_state_ ^= noise_state_ << 13;
+    noise_state_ ^= noise_state_ >> 17;
+    noise_state_ ^= noise_state_ << 5;
+    
+    // Top 24 bits -> [0, 1) -> [-0.5, +0.5)
+    float unit = static_cast<float>(noise_state_ >> 8) * (1.0f / 16777216.0f);
+    return (unit - 0.5f) * (2.0f * VARIATION_RANGE);
+}
+
+} // namespace thermal
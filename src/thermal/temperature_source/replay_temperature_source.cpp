@@ -0,0 +1,104 @@
+#include "thermal/temperature_source/replay_temperature_source.h"
+#include <cstdlib>
+#include <stdexcept>
+
+namespace thermal {
+
+ReplayOptions ReplayOptions::fromEnvironment() {
+    ReplayOptions options;
+    if (const char* path = std::getenv("THERMAL_REPLAY_FILE")) {
+        options.file_path = path;
+    }
+    if (const char* width = std::getenv("THERMAL_REPLAY_WIDTH")) {
+        options.width = std::atoi(width);
+    }
+    if (const char* height = std::getenv("THERMAL_REPLAY_HEIGHT")) {
+        options.height = std::atoi(height);
+    }
+    if (const char* fps = std::getenv("THERMAL_REPLAY_FPS")) {
+        options.playback_fps = std::atof(fps);
+    }
+    if (const char* loop = std::getenv("THERMAL_REPLAY_LOOP")) {
+        options.loop = std::string(loop) != "0";
+    }
+    return options;
+}
+
+ReplayTemperatureSource::ReplayTemperatureSource(const ReplayOptions& options)
+    : FrameTemperatureSource(options.width, options.height)
+    , options_(options)
+    , converter_(options.calibration)
+    , frame_pixels_(static_cast<size_t>(options.width) * options.height)
+    , frame_count_(0) {
+
+    if (options_.playback_fps < 0.0) {
+        throw std::invalid_argument("Replay playback rate must not be negative");
+    }
+
+    if (!file_.open(options_.file_path)) {
+        throw std::runtime_error("Cannot map replay file: " + options_.file_path);
+    }
+
+    frame_count_ = file_.size() / (frame_pixels_ * sizeof(std::uint16_t));
+    if (frame_count_ == 0) {
+        throw std::runtime_error("Replay file holds no complete frame: " + options_.file_path);
+    }
+}
+
+std::string ReplayTemperatureSource::getSourceName() const {
+    return "ReplayTemperatureSource";
+}
+
+float ReplayTemperatureSource::getBaseTemperature(int x, int y) const {
+    const ThermalFrame* frame = getCurrentFrame();
+    if (!frame || !frame->contains(x, y)) {
+        return DEFAULT_TEMPERATURE;
+    }
+    return frame->at(x, y);
+}
+
+const std::uint16_t* ReplayTemperatureSource::getCurrentRawFrame() const {
+    if (captures_ == 0) {
+        return nullptr;
+    }
+    return reinterpret_cast<const std::uint16_t*>(file_.data()) + current_index_ * frame_pixels_;
+}
+
+bool ReplayTemperatureSource::renderFrame(ThermalFrame& frame) {
+    size_t index = 0;
+    if (!nextFrameIndex(index)) {
+        return false;
+    }
+    current_index_ = index;
+    ++captures_;
+
+    // Straight from the mapping into the frame buffer
+    converter_.convert(getCurrentRawFrame(), frame_pixels_, frame.pixels.data());
+
+    return true;
+}
+
+bool ReplayTemperatureSource::nextFrameIndex(size_t& index) {
+    std::uint64_t position = captures_;
+
+    if (options_.playback_fps > 0.0) {
+        auto now = std::chrono::steady_clock::now();
+        if (captures_ == 0) {
+            playback_start_ = now;
+        }
+        std::chrono::duration<double> elapsed = now - playback_start_;
+        position = static_cast<std::uint64_t>(elapsed.count() * options_.playback_fps);
+    }
+
+    if (position >= frame_count_) {
+        if (!options_.loop) {
+            return false;
+        }
+        position %= frame_count_;
+    }
+
+    index = static_cast<size_t>(position);
+    return true;
+}
+
+} // namespace thermal
@@ -1,9 +1,23 @@
 #include "thermal/temperature_source/temperature_data_source.h"
+#include "thermal/frame/thermal_frame.h"
 
 namespace thermal {
 
-// Base class implementation
-// The interface is pure virtual, so this file mainly serves as a placeholder
-// for any common functionality that might be added in the future.
+// Default implementations for sources that compute temperatures per pixel,
+// have no frame buffer to capture and no vectorized batch path.
+
+void TemperatureDataSource::getTemperatures(const Point* points, size_t count, float* temperatures) {
+    for (size_t i = 0; i < count; ++i) {
+        temperatures[i] = getTemperature(points[i].x, points[i].y);
+    }
+}
+
+bool TemperatureDataSource::captureFrame() {
+    return isReady();
+}
+
+const ThermalFrame* TemperatureDataSource::getCurrentFrame() const {
+    return nullptr;
+}
 
 } // namespace thermal
\ No newline at end of file
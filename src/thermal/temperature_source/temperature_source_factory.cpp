@@ -1,5 +1,7 @@
 #include "thermal/temperature_source/temperature_source_factory.h"
 #include "thermal/temperature_source/coordinate_based_source.h"
+#include "thermal/temperature_source/frame_temperature_source.h"
+#include "thermal/temperature_source/replay_temperature_source.h"
 #include <stdexcept>
 #include <algorithm>
 #include <cctype>
@@ -10,6 +12,10 @@ std::unique_ptr<TemperatureDataSource> TemperatureSourceFactory::createSource(So
     switch (type) {
         case SourceType::COORDINATE_BASED:
             return std::make_unique<CoordinateBasedTemperatureSource>();
+        case SourceType::FRAME_BASED:
+            return std::make_unique<FrameTemperatureSource>();
+        case SourceType::FILE_REPLAY:
+            return createReplaySource(ReplayOptions::fromEnvironment());
         case SourceType::REMOTE_HTTP:
             // Future implementation: HTTP API integration
             throw std::runtime_error("HTTP temperature source not yet implemented");
@@ -26,6 +32,10 @@ std::unique_ptr<TemperatureDataSource> TemperatureSourceFactory::createSource(co
     return createSource(type);
 }
 
+std::unique_ptr<TemperatureDataSource> TemperatureSourceFactory::createReplaySource(const ReplayOptions& options) {
+    return std::make_unique<ReplayTemperatureSource>(options);
+}
+
 std::unique_ptr<TemperatureDataSource> TemperatureSourceFactory::createDefault() {
     return createSource(SourceType::COORDINATE_BASED);
 }
@@ -34,6 +44,10 @@ std::string TemperatureSourceFactory::sourceTypeToString(SourceType type) {
     switch (type) {
         case SourceType::COORDINATE_BASED:
             return "coordinate_based";
+        case SourceType::FRAME_BASED:
+            return "frame_based";
+        case SourceType::FILE_REPLAY:
+            return "file_replay";
         case SourceType::REMOTE_HTTP:
             return "remote_http";
         case SourceType::REMOTE_MQTT:
@@ -51,6 +65,10 @@ TemperatureSourceFactory::SourceType TemperatureSourceFactory::parseSourceType(c
     
     if (lower_str == "coordinate_based") {
         return SourceType::COORDINATE_BASED;
+    } else if (lower_str == "frame_based") {
+        return SourceType::FRAME_BASED;
+    } else if (lower_str == "file_replay") {
+        return SourceType::FILE_REPLAY;
     } else if (lower_str == "remote_http") {
         return SourceType::REMOTE_HTTP;
     } else if (lower_str == "remote_mqtt") {
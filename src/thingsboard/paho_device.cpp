@@ -6,11 +6,30 @@
 #include <nlohmann/json.hpp>
 #include <iomanip>
 #include <sstream>
+#include <algorithm>
 #include <thread>
+#include <vector>
 #include <chrono>
 
 namespace thermal {
 
+namespace {
+
+// Hot-path failures repeat for every message during an outage
+constexpr std::int64_t OUTAGE_LOG_INTERVAL_MS = 10000;
+constexpr std::uint64_t INVALID_READING_LOG_LIMIT = 10;
+
+// Protobuf payloads are binary; debug logs show their size instead
+std::string loggable_payload(const std::string& payload, bool binary) {
+    return binary ? "<" + std::to_string(payload.size()) + " bytes of Protobuf>" : payload;
+}
+
+std::int64_t to_epoch_ms(std::chrono::time_point<std::chrono::system_clock> timestamp) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(timestamp.time_since_epoch()).count();
+}
+
+} // namespace
+
 ThingsBoardDevice::ThingsBoardDevice(const ThingsBoardConfig& config)
     : config_(config) {
     
@@ -18,6 +37,7 @@ ThingsBoardDevice::ThingsBoardDevice(const ThingsBoardConfig& config)
     if (!config_.validate()) {
         throw std::invalid_argument("Invalid ThingsBoard configuration");
     }
+    protobuf_payloads_ = config_.payload_format == "protobuf";
     
     // Create MQTT client
     std::string server_uri = build_server_uri();
@@ -28,13 +48,60 @@ ThingsBoardDevice::ThingsBoardDevice(const ThingsBoardConfig& config)
     // Initialize RPC parser
     rpc_parser_ = std::make_unique<thermal::RPCParser>();
     
-    LOG_INFO("ThingsBoard device initialized: " << config_.device_id << " -> " << server_uri);
+    // In-order worker for RPC responses, subscriptions and journaling
+    executor_ = std::make_unique<Executor>(WORKER_THREADS, "device");
+    
+    // RPC commands run on the engine's workers; timeouts are answered from its timer
+    RPCAdmissionLimits rpc_limits;
+    rpc_limits.max_queue_depth = config_.rpc_max_queue_depth;
+    rpc_limits.max_pending_per_method = config_.rpc_max_pending_per_method;
+    rpc_limits.rate_per_second = config_.rpc_rate_limit_per_second;
+    rpc_limits.burst = config_.rpc_rate_burst;
+    rpc_engine_ = std::make_unique<RPCEngine>(
+        RPC_WORKER_THREADS,
+        [this](const RPCCommand& command) {
+            thermal_rpc_handler_->handleRPCCommand(command.requestId, command);
+        },
+        [this](const RPCResponse& response) {
+            nlohmann::json error_response = {
+                {"error", {
+                    {"code", response.errorCode},
+                    {"message", response.errorMessage}
+                }}
+            };
+            queue_rpc_response(response.requestId, error_response.dump());
+        },
+        rpc_limits);
+    
+    // Only parsing happens on the Paho thread; the engine runs the command
+    topic_router_.add("v1/devices/me/rpc/request/", [this](std::string_view request_id, std::string_view payload) {
+        handle_rpc_command(request_id, payload);
+    });
+    
+    LOG_INFO("ThingsBoard device initialized: " << config_.device_id << " -> " << server_uri
+            << " (" << config_.payload_format << " payloads)");
 }
 
 ThingsBoardDevice::~ThingsBoardDevice() {
+    // Finish queued RPC work while everything it touches is still alive
+    rpc_engine_->shutdown();
+    if (thermal_rpc_handler_) {
+        // The handler may outlive this device; its callback must not reach us
+        thermal_rpc_handler_->setResponseCallback(nullptr);
+    }
+    
+    // Drain the publisher and disconnect first; the executor then refuses late
+    // delivery callbacks instead of running them
+    publisher_.reset();
     if (mqtt_client_ && is_connected()) {
         disconnect();
     }
+    executor_->shutdown();
+    
+    // Cut Paho threads off before any member goes away; both calls wait for
+    // callbacks already running
+    mqtt_client_->set_event_callback(nullptr);
+    mqtt_client_->drop_inflight();
 }
 
 bool ThingsBoardDevice::connect() {
@@ -65,6 +132,9 @@ bool ThingsBoardDevice::disconnect() {
         return true;
     }
     
+    // Publish what is still queued before the connection goes away
+    publisher_.reset();
+    
     LOG_INFO("Disconnecting from ThingsBoard");
     return mqtt_client_->disconnect();
 }
@@ -74,13 +144,19 @@ bool ThingsBoardDevice::is_connected() const {
 }
 
 bool ThingsBoardDevice::send_telemetry(int spot_id, double temperature) {
+    if (journal_ || protobuf_payloads_) {
+        // Journaled payloads need a timestamp to be replayed later, and the
+        // Protobuf schema only has the timestamped form
+        return send_telemetry(spot_id, temperature, std::chrono::system_clock::now());
+    }
+    
     if (!is_connected()) {
-        LOG_ERROR("Not connected to ThingsBoard");
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Not connected to ThingsBoard");
         return false;
     }
     
     if (!validate_temperature(temperature)) {
-        LOG_WARN("Invalid temperature reading " << temperature << "°C from spot " << spot_id 
+        LOG_WARN_FIRST_N(INVALID_READING_LOG_LIMIT, "Invalid temperature reading " << temperature << "°C from spot " << spot_id 
                 << " (outside -100°C to 500°C range), skipping");
         return false;
     }
@@ -95,51 +171,336 @@ bool ThingsBoardDevice::send_telemetry(int spot_id, double temperature) {
         LOG_DEBUG("Telemetry sent successfully for spot " << spot_id 
                  << " (temperature: " << temperature << "°C)");
     } else {
-        LOG_ERROR("Failed to send telemetry for spot " << spot_id);
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Failed to send telemetry for spot " << spot_id);
     }
     
     return result;
 }
 
 bool ThingsBoardDevice::send_telemetry(int spot_id, double temperature,
-                                     std::chrono::time_point<std::chrono::system_clock> timestamp) {
-    if (!is_connected()) {
-        LOG_ERROR("Not connected to ThingsBoard");
+                                     std::chrono::time_point<std::chrono::system_clock> timestamp,
+                                     const FrameExtremes* extremes) {
+    if (!is_connected() && !journal_) {
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Not connected to ThingsBoard");
         return false;
     }
     
     if (!validate_temperature(temperature)) {
-        LOG_WARN("Invalid temperature reading " << temperature << "°C from spot " << spot_id 
+        LOG_WARN_FIRST_N(INVALID_READING_LOG_LIMIT, "Invalid temperature reading " << temperature << "°C from spot " << spot_id 
                 << " (outside -100°C to 500°C range), skipping");
         return false;
     }
     
     std::string topic = build_telemetry_topic();
-    std::string payload = build_telemetry_payload_with_timestamp(spot_id, temperature, timestamp);
+    std::string payload = build_telemetry_payload_with_timestamp(spot_id, temperature, timestamp, extremes);
     
-    LOG_DEBUG("Sending timestamped telemetry to " << topic << ": " << payload);
+    LOG_DEBUG("Sending timestamped telemetry to " << topic << ": " << loggable_payload(payload, protobuf_payloads_));
     
-    bool result = mqtt_client_->publish(topic, payload, 1, false);
+    bool result = publish_telemetry(payload, to_epoch_ms(timestamp));
     if (result) {
         LOG_DEBUG("Timestamped telemetry sent successfully for spot " << spot_id 
                  << " (temperature: " << temperature << "°C)");
     } else {
-        LOG_ERROR("Failed to send timestamped telemetry for spot " << spot_id);
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Failed to send timestamped telemetry for spot " << spot_id);
+    }
+    
+    return result;
+}
+
+bool ThingsBoardDevice::send_telemetry_batch(const TemperatureReading* readings, size_t count,
+                                           const FrameExtremes* extremes) {
+    if (!is_connected() && !journal_) {
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Not connected to ThingsBoard");
+        return false;
+    }
+    
+    if (count == 0) {
+        // Nothing sampled; the hotspot alone can still go out
+        return extremes && send_frame_extremes(*extremes, extremes->captured_at);
+    }
+    
+    std::string topic = build_telemetry_topic();
+    std::string payload = build_telemetry_batch_payload(readings, count, extremes);
+    
+    LOG_DEBUG("Sending telemetry batch of " << count << " spots to " << topic << ": " << loggable_payload(payload, protobuf_payloads_));
+    
+    bool result = publish_telemetry(payload, to_epoch_ms(readings[0].timestamp));
+    if (result) {
+        LOG_DEBUG("Telemetry batch sent successfully (" << count << " spots)");
+    } else {
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Failed to send telemetry batch of " << count << " spots");
     }
     
     return result;
 }
 
+bool ThingsBoardDevice::send_frame_extremes(const FrameExtremes& extremes,
+                                          std::chrono::time_point<std::chrono::system_clock> timestamp) {
+    if (!is_connected() && !journal_) {
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Not connected to ThingsBoard");
+        return false;
+    }
+    
+    if (!extremes.valid) {
+        return false;
+    }
+    
+    std::string topic = build_telemetry_topic();
+    std::string payload = build_frame_extremes_payload(extremes, timestamp);
+    
+    LOG_DEBUG("Sending frame extremes to " << topic << ": " << loggable_payload(payload, protobuf_payloads_));
+    
+    bool result = publish_telemetry(payload, to_epoch_ms(timestamp));
+    if (!result) {
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Failed to send frame extremes telemetry");
+    }
+    
+    return result;
+}
+
+bool ThingsBoardDevice::send_area_telemetry(const AreaReading* areas, size_t count,
+                                           std::chrono::time_point<std::chrono::system_clock> timestamp) {
+    if (count == 0) {
+        return false;
+    }
+    
+    std::string payload = build_area_payload(areas, count, timestamp);
+    if (upload_window_.enabled()) {
+        if (upload_window_.add(payload)) {
+            return flush_telemetry_window();
+        }
+        return true;
+    }
+    
+    if (!is_connected() && !journal_) {
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Not connected to ThingsBoard");
+        return false;
+    }
+    
+    std::string topic = build_telemetry_topic();
+    LOG_DEBUG("Sending area telemetry to " << topic << ": " << loggable_payload(payload, protobuf_payloads_));
+    
+    bool result = publish_telemetry(payload, to_epoch_ms(timestamp));
+    if (!result) {
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Failed to send area telemetry for " << count << " areas");
+    }
+    
+    return result;
+}
+
+void ThingsBoardDevice::set_upload_window(std::chrono::milliseconds window, size_t max_payload_bytes) {
+    if (protobuf_payloads_ && window.count() > 0) {
+        // Windows are JSON arrays; a Protobuf message holds a single entry
+        LOG_WARN("Windowed uploads are not available with Protobuf payloads, publishing each sample");
+        window = std::chrono::milliseconds(0);
+    }
+    upload_window_.configure(window, max_payload_bytes);
+    if (upload_window_.enabled()) {
+        LOG_INFO("Windowed telemetry uploads every " << window.count() << " ms (max "
+                << max_payload_bytes << " bytes per message)");
+    }
+}
+
+bool ThingsBoardDevice::queue_telemetry(const TemperatureReading* readings, size_t count,
+                                      const FrameExtremes* extremes) {
+    std::string entry;
+    if (count > 0) {
+        entry = build_telemetry_batch_payload(readings, count, extremes);
+    } else if (extremes && extremes->valid) {
+        entry = build_frame_extremes_payload(*extremes, extremes->captured_at);
+    } else {
+        return false;
+    }
+    
+    if (upload_window_.add(entry)) {
+        return flush_telemetry_window();
+    }
+    return true;
+}
+
+bool ThingsBoardDevice::flush_telemetry_window() {
+    if (upload_window_.empty()) {
+        return true;
+    }
+    
+    size_t entries = upload_window_.entryCount();
+    std::int64_t flushed_at_ms = to_epoch_ms(std::chrono::system_clock::now());
+    std::vector<std::string> payloads = upload_window_.takePayloads();
+    
+    if (!is_connected() && !journal_) {
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Not connected to ThingsBoard, dropping " << entries << " windowed telemetry entries");
+        return false;
+    }
+    
+    std::string topic = build_telemetry_topic();
+    bool all_sent = true;
+    for (const auto& payload : payloads) {
+        LOG_DEBUG("Sending windowed telemetry (" << payload.size() << " bytes) to " << topic);
+        if (!publish_telemetry(payload, flushed_at_ms)) {
+            LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Failed to send windowed telemetry payload of " << payload.size() << " bytes");
+            all_sent = false;
+        }
+    }
+    
+    if (all_sent) {
+        LOG_DEBUG("Windowed telemetry sent: " << entries << " entries in " << payloads.size() << " messages");
+    }
+    return all_sent;
+}
+
+void ThingsBoardDevice::set_journal(std::unique_ptr<TelemetryJournal> journal,
+                                    double backfill_messages_per_second, size_t backfill_max_bytes) {
+    std::lock_guard<std::mutex> lock(journal_mutex_);
+    journal_ = std::move(journal);
+    backfill_rate_ = backfill_messages_per_second;
+    backfill_max_bytes_ = backfill_max_bytes;
+    backfill_tokens_ = 0.0;
+    last_backfill_ = std::chrono::steady_clock::now();
+}
+
+size_t ThingsBoardDevice::backfill_journal() {
+    auto now = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed = now - last_backfill_;
+    last_backfill_ = now;
+    
+    std::lock_guard<std::mutex> lock(journal_mutex_);
+    if (!journal_ || journal_->empty() || !is_connected()) {
+        backfill_tokens_ = 0.0;
+        return 0;
+    }
+    
+    // Token bucket: at most one second worth of messages in a burst, so live
+    // telemetry published between calls is never queued behind the backlog
+    backfill_tokens_ = std::min(backfill_tokens_ + elapsed.count() * backfill_rate_,
+                                std::max(backfill_rate_, 1.0));
+    
+    std::string topic = build_telemetry_topic();
+    size_t replayed = 0;
+    while (backfill_tokens_ >= 1.0 && !journal_->empty()) {
+        // Leave room for the brackets and separators added when merging;
+        // concatenated Protobuf messages would merge into one, so those go singly
+        size_t max_records = protobuf_payloads_ ? 1 : BACKFILL_MAX_RECORDS;
+        size_t payload_budget = backfill_max_bytes_ - BACKFILL_MAX_RECORDS - 2;
+        if (journal_->peek(max_records, payload_budget, backfill_records_) == 0) {
+            break;
+        }
+        
+        std::string payload;
+        if (protobuf_payloads_) {
+            payload = backfill_records_.front().payload;
+        } else {
+            // Merge the records into one JSON array, unwrapping windowed arrays
+            payload = "[";
+            for (const auto& record : backfill_records_) {
+                const std::string& entry = record.payload;
+                bool is_array = !entry.empty() && entry.front() == '[';
+                if (payload.size() > 1) {
+                    payload += ',';
+                }
+                payload.append(entry, is_array ? 1 : 0, is_array ? entry.size() - 2 : entry.size());
+            }
+            payload += ']';
+        }
+        
+        DeliveryCallback on_complete = journal_if_undelivered(payload, backfill_records_.front().timestamp_ms);
+        if (!mqtt_client_->publish(topic, payload, 1, false, std::move(on_complete))) {
+            LOG_WARN("Journal backfill publish failed, " << journal_->pendingRecords() << " records pending");
+            break;
+        }
+        
+        journal_->consume(backfill_records_.size());
+        replayed += backfill_records_.size();
+        backfill_tokens_ -= 1.0;
+    }
+    
+    if (replayed > 0) {
+        journal_->sync();
+        LOG_INFO("Backfilled " << replayed << " journaled telemetry records, "
+                << journal_->pendingRecords() << " pending");
+    }
+    return replayed;
+}
+
+DeliveryCallback ThingsBoardDevice::journal_if_undelivered(const std::string& payload, std::int64_t timestamp_ms) {
+    if (!journal_) {
+        return nullptr;
+    }
+    
+    return [this, payload, timestamp_ms](DeliveryResult result) {
+        if (result == DeliveryResult::DELIVERED) {
+            return;
+        }
+        // Runs on a Paho thread; the journal lock is taken on a worker instead, since
+        // backfill_journal() holds it while calling into Paho. The record can land
+        // after newer ones, so backfill replays it out of timestamp order
+        bool queued = executor_->submit([this, payload, timestamp_ms]() {
+            std::lock_guard<std::mutex> lock(journal_mutex_);
+            if (journal_ && journal_->append(timestamp_ms, payload)) {
+                LOG_DEBUG("Unacknowledged telemetry journaled for backfill (" << journal_->pendingRecords()
+                          << " pending)");
+            }
+        });
+        if (!queued) {
+            LOG_WARN_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Unacknowledged telemetry dropped during shutdown");
+        }
+    };
+}
+
+InFlightStats ThingsBoardDevice::get_delivery_stats() const {
+    return mqtt_client_ ? mqtt_client_->get_inflight_stats() : InFlightStats();
+}
+
+void ThingsBoardDevice::start_publisher(size_t capacity, OverflowPolicy policy) {
+    publisher_.reset();
+    publisher_ = std::make_unique<TelemetryPublisher>(
+        capacity, policy,
+        [this](const std::string& payload, std::int64_t timestamp_ms) {
+            return publish_telemetry_now(payload, timestamp_ms);
+        });
+    LOG_INFO("Telemetry publisher thread started (queue capacity " << publisher_->capacity()
+            << ", overflow policy " << overflowPolicyToString(policy) << ")");
+}
+
+PublisherStats ThingsBoardDevice::get_publisher_stats() const {
+    return publisher_ ? publisher_->getStats() : PublisherStats();
+}
+
+RPCEngineStats ThingsBoardDevice::get_rpc_stats() const {
+    return rpc_engine_->getStats();
+}
+
+bool ThingsBoardDevice::publish_telemetry(std::string payload, std::int64_t timestamp_ms) {
+    if (publisher_) {
+        return publisher_->enqueue(std::move(payload), timestamp_ms);
+    }
+    return publish_telemetry_now(payload, timestamp_ms);
+}
+
+bool ThingsBoardDevice::publish_telemetry_now(const std::string& payload, std::int64_t timestamp_ms) {
+    if (is_connected() &&
+        mqtt_client_->publish(build_telemetry_topic(), payload, 1, false, journal_if_undelivered(payload, timestamp_ms))) {
+        return true;
+    }
+    
+    std::lock_guard<std::mutex> lock(journal_mutex_);
+    if (journal_ && journal_->append(timestamp_ms, payload)) {
+        LOG_DEBUG("Telemetry journaled for backfill (" << journal_->pendingRecords() << " pending)");
+    }
+    return false;
+}
+
 bool ThingsBoardDevice::send_rpc_response(const std::string& request_id, const std::string& response) {
     if (!is_connected()) {
-        LOG_ERROR("Not connected to ThingsBoard for RPC response");
+        LOG_ERROR_EVERY_MS(OUTAGE_LOG_INTERVAL_MS, "Not connected to ThingsBoard for RPC response");
         return false;
     }
     
     std::string topic = build_rpc_response_topic(request_id);
     LOG_DEBUG("Sending RPC response to " << topic);
     
-    bool result = mqtt_client_->publish(topic, response, 1, false);
+    bool result = protobuf_payloads_
+        ? mqtt_client_->publish(topic, ProtobufTelemetryEncoder::encodeRpcResponse(response), 1, false)
+        : mqtt_client_->publish(topic, response, 1, false);
     if (result) {
         LOG_DEBUG("RPC response sent successfully for request " << request_id);
     } else {
@@ -157,6 +518,46 @@ const MQTTClientStats& ThingsBoardDevice::get_connection_stats() const {
     return mqtt_client_->get_stats();
 }
 
+void ThingsBoardDevice::collect_metrics(std::vector<MetricSnapshot>& metrics) const {
+    const auto& connection = get_connection_stats();
+    metrics.push_back(makeMetricSnapshot(MetricType::GAUGE, "mqtt_connected", "1 while connected to the broker",
+                                         is_connected() ? 1 : 0));
+    metrics.push_back(makeMetricSnapshot(MetricType::COUNTER, "mqtt_connection_attempts_total",
+                                         "Broker connection attempts",
+                                         connection.connection_attempts.load(std::memory_order_relaxed)));
+    metrics.push_back(makeMetricSnapshot(MetricType::COUNTER, "mqtt_connection_failures_total",
+                                         "Failed broker connection attempts",
+                                         connection.connection_failures.load(std::memory_order_relaxed)));
+    const auto deliveries = get_delivery_stats();
+    metrics.push_back(makeMetricSnapshot(MetricType::GAUGE, "mqtt_oldest_unacked_age_microseconds",
+                                         "Age of the oldest publish awaiting acknowledgement",
+                                         deliveries.oldest_age.count()));
+    
+    const auto publisher = get_publisher_stats();
+    const std::string published_help = "Telemetry messages leaving the publish queue, by outcome";
+    metrics.push_back(makeMetricSnapshot(MetricType::COUNTER, "telemetry_publisher_messages_total", published_help,
+                                         static_cast<std::int64_t>(publisher.published), {{"outcome", "published"}}));
+    metrics.push_back(makeMetricSnapshot(MetricType::COUNTER, "telemetry_publisher_messages_total", published_help,
+                                         static_cast<std::int64_t>(publisher.failed), {{"outcome", "failed"}}));
+    metrics.push_back(makeMetricSnapshot(MetricType::COUNTER, "telemetry_publisher_messages_total", published_help,
+                                         static_cast<std::int64_t>(publisher.dropped_oldest), {{"outcome", "dropped_oldest"}}));
+    metrics.push_back(makeMetricSnapshot(MetricType::COUNTER, "telemetry_publisher_messages_total", published_help,
+                                         static_cast<std::int64_t>(publisher.dropped_newest), {{"outcome", "dropped_newest"}}));
+    
+    const auto rpc = get_rpc_stats();
+    const std::string rpc_help = "RPC commands by outcome";
+    metrics.push_back(makeMetricSnapshot(MetricType::COUNTER, "rpc_commands_total", rpc_help,
+                                         static_cast<std::int64_t>(rpc.completed), {{"outcome", "completed"}}));
+    metrics.push_back(makeMetricSnapshot(MetricType::COUNTER, "rpc_commands_total", rpc_help,
+                                         static_cast<std::int64_t>(rpc.timed_out), {{"outcome", "timed_out"}}));
+    metrics.push_back(makeMetricSnapshot(MetricType::COUNTER, "rpc_commands_total", rpc_help,
+                                         static_cast<std::int64_t>(rpc.skipped), {{"outcome", "skipped"}}));
+    metrics.push_back(makeMetricSnapshot(MetricType::COUNTER, "rpc_commands_total", rpc_help,
+                                         static_cast<std::int64_t>(rpc.rejected_busy), {{"outcome", "busy"}}));
+    metrics.push_back(makeMetricSnapshot(MetricType::GAUGE, "rpc_commands_in_flight",
+                                         "RPC commands awaiting a response", static_cast<std::int64_t>(rpc.in_flight)));
+}
+
 void ThingsBoardDevice::set_auto_reconnect(bool enable) {
     // Auto-reconnect functionality not yet implemented in PahoCClient
     (void)enable; // Suppress unused parameter warning
@@ -179,8 +580,8 @@ void ThingsBoardDevice::on_connection_success() {
     // Now that we're connected, subscribe to RPC commands
     LOG_INFO("Subscribing to ThingsBoard RPC topic: v1/devices/me/rpc/request/+");
     
-    // Try subscription in a separate thread to avoid blocking
-    std::thread subscription_thread([this]() {
+    // Subscribe from a worker; subscribing inside the Paho callback blocks
+    bool queued = executor_->submit([this]() {
         bool subscription_result = mqtt_client_->subscribe("v1/devices/me/rpc/request/+", 1);
         if (subscription_result) {
             LOG_DEBUG("Successfully queued RPC subscription request");
@@ -188,9 +589,9 @@ void ThingsBoardDevice::on_connection_success() {
             LOG_ERROR("Failed to queue RPC subscription request");
         }
     });
-    
-    // Detach the thread so it can run independently
-    subscription_thread.detach();
+    if (!queued) {
+        LOG_WARN("Device shutting down, skipping RPC subscription");
+    }
 }
 
 void ThingsBoardDevice::on_connection_failure(const std::string& error) {
@@ -202,14 +603,14 @@ void ThingsBoardDevice::on_disconnected() {
 }
 
 void ThingsBoardDevice::on_message_received(const std::string& topic, const std::string& payload) {
+    on_message_view(topic, payload);
+}
+
+void ThingsBoardDevice::on_message_view(std::string_view topic, std::string_view payload) {
     LOG_DEBUG("Received MQTT message on topic: " << topic);
     
-    // Check if this is an RPC command
-    if (topic.find("v1/devices/me/rpc/request/") == 0) {
-        LOG_INFO("Processing RPC command from topic: " << topic);
-        handle_rpc_command(topic, payload);
-    } else {
-        LOG_DEBUG("Ignoring non-RPC message on topic: " << topic);
+    if (!topic_router_.dispatch(topic, payload)) {
+        LOG_DEBUG("Ignoring message on unrouted topic: " << topic);
     }
 }
 
@@ -232,34 +633,87 @@ std::string ThingsBoardDevice::build_rpc_response_topic(const std::string& reque
 }
 
 std::string ThingsBoardDevice::build_telemetry_payload(int spot_id, double temperature) const {
-    nlohmann::json telemetry;
-    std::string temp_key = "temperature_spot_" + std::to_string(spot_id);
-    telemetry[temp_key] = temperature;
-    return telemetry.dump();
+    std::lock_guard<std::mutex> lock(encoder_mutex_);
+    return encoder_.encodeReading(spot_id, temperature);
 }
 
 std::string ThingsBoardDevice::build_telemetry_payload_with_timestamp(
     int spot_id, double temperature,
-    std::chrono::time_point<std::chrono::system_clock> timestamp) const {
+    std::chrono::time_point<std::chrono::system_clock> timestamp,
+    const FrameExtremes* extremes) const {
     
-    nlohmann::json telemetry;
-    std::string temp_key = "temperature_spot_" + std::to_string(spot_id);
+    std::lock_guard<std::mutex> lock(encoder_mutex_);
+    TelemetryPayloadEncoder& encoder = payload_encoder();
+    encoder.begin(to_epoch_ms(timestamp));
+    encoder.addSpot(spot_id, temperature);
     
-    // Convert timestamp to milliseconds since epoch
-    auto timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        timestamp.time_since_epoch()).count();
+    // Frame-wide hotspot/coldspot keys ride along with the spot values
+    if (extremes && extremes->valid) {
+        encoder.addFrameExtremes(*extremes);
+    }
     
-    nlohmann::json ts_data;
-    ts_data["ts"] = timestamp_ms;
-    ts_data["values"][temp_key] = temperature;
+    return encoder.finish();
+}
+
+std::string ThingsBoardDevice::build_telemetry_batch_payload(
+    const TemperatureReading* readings, size_t count,
+    const FrameExtremes* extremes) const {
+    
+    std::lock_guard<std::mutex> lock(encoder_mutex_);
+    TelemetryPayloadEncoder& encoder = payload_encoder();
+    encoder.begin(to_epoch_ms(readings[0].timestamp));
+    for (size_t i = 0; i < count; ++i) {
+        const TemperatureReading& reading = readings[i];
+        if (!validate_temperature(reading.temperature)) {
+            LOG_WARN_FIRST_N(INVALID_READING_LOG_LIMIT, "Invalid temperature reading " << reading.temperature << "°C from spot " << reading.spot_id
+                    << " (outside -100°C to 500°C range), leaving it out of the batch");
+            continue;
+        }
+        encoder.addSpot(reading.spot_id, reading.temperature);
+    }
     
-    return ts_data.dump();
+    if (extremes && extremes->valid) {
+        encoder.addFrameExtremes(*extremes);
+    }
+    
+    return encoder.finish();
+}
+
+std::string ThingsBoardDevice::build_frame_extremes_payload(
+    const FrameExtremes& extremes,
+    std::chrono::time_point<std::chrono::system_clock> timestamp) const {
+    
+    std::lock_guard<std::mutex> lock(encoder_mutex_);
+    TelemetryPayloadEncoder& encoder = payload_encoder();
+    encoder.begin(to_epoch_ms(timestamp));
+    encoder.addFrameExtremes(extremes);
+    return encoder.finish();
+}
+
+std::string ThingsBoardDevice::build_area_payload(
+    const AreaReading* areas, size_t count,
+    std::chrono::time_point<std::chrono::system_clock> timestamp) const {
+    
+    std::lock_guard<std::mutex> lock(encoder_mutex_);
+    TelemetryPayloadEncoder& encoder = payload_encoder();
+    encoder.begin(to_epoch_ms(timestamp));
+    for (size_t i = 0; i < count; ++i) {
+        encoder.addArea(areas[i].area_id, areas[i].statistics);
+    }
+    return encoder.finish();
 }
 
 bool ThingsBoardDevice::validate_temperature(double temperature) const {
     return temperature >= -100.0 && temperature <= 500.0;
 }
 
+TelemetryPayloadEncoder& ThingsBoardDevice::payload_encoder() const {
+    if (protobuf_payloads_) {
+        return protobuf_encoder_;
+    }
+    return encoder_;
+}
+
 std::string ThingsBoardDevice::format_timestamp(
     std::chrono::time_point<std::chrono::system_clock> timestamp) const {
     
@@ -269,14 +723,15 @@ std::string ThingsBoardDevice::format_timestamp(
     return ss.str();
 }
 
-void ThingsBoardDevice::handle_rpc_command(const std::string& topic, const std::string& payload) {
+void ThingsBoardDevice::handle_rpc_command(std::string_view request_id_view, std::string_view payload) {
+    if (request_id_view.empty()) {
+        LOG_ERROR("Invalid RPC topic format: missing request ID");
+        return;
+    }
+    // Responses outlive the Paho buffers the view points into
+    std::string request_id(request_id_view);
+    
     try {
-        std::string request_id = extract_request_id(topic);
-        if (request_id.empty()) {
-            LOG_ERROR("Invalid RPC topic format: " << topic);
-            return;
-        }
-        
         LOG_INFO("Processing RPC command with request ID: " << request_id);
         LOG_INFO("RPC command payload: " << payload);
         
@@ -295,16 +750,30 @@ void ThingsBoardDevice::handle_rpc_command(const std::string& topic, const std::
                     {"message", validation_error}
                 }}
             };
-            send_rpc_response(request_id, error_response.dump());
+            queue_rpc_response(request_id, error_response.dump());
             return;
         }
         
         // Check if we have a thermal RPC handler and if it supports this method
         std::string method_str = thermal::RPCCommand::methodToString(rpc_command.method);
         LOG_INFO("Parsed RPC method: " << method_str);
-        if (thermal_rpc_handler_ && thermal_rpc_handler_->isSupported(method_str)) {
+        if (thermal_rpc_handler_ && thermal_rpc_handler_->isSupported(rpc_command.method)) {
             LOG_DEBUG("Routing RPC command to thermal handler: " << method_str);
-            thermal_rpc_handler_->handleRPCCommand(request_id, rpc_command);
+            int retry_after_ms = 0;
+            RPCAdmission admission = rpc_engine_->submit(std::move(rpc_command), &retry_after_ms);
+            if (admission == RPCAdmission::BUSY) {
+                // Shed load right away rather than answering minutes late
+                nlohmann::json error_response = {
+                    {"error", {
+                        {"code", thermal::RPCErrorCodes::CAMERA_BUSY},
+                        {"message", "Device busy, retry after " + std::to_string(retry_after_ms) + " ms"},
+                        {"retryAfterMs", retry_after_ms}
+                    }}
+                };
+                queue_rpc_response(request_id, error_response.dump());
+            } else if (admission == RPCAdmission::REJECTED) {
+                LOG_WARN("RPC engine rejected request " << request_id);
+            }
         } else {
             LOG_WARN("Unsupported RPC method: " << method_str);
             
@@ -315,7 +784,7 @@ void ThingsBoardDevice::handle_rpc_command(const std::string& topic, const std::
                     {"message", "Unsupported RPC method: " + method_str}
                 }}
             };
-            send_rpc_response(request_id, error_response.dump());
+            queue_rpc_response(request_id, error_response.dump());
         }
         
     } catch (const std::exception& e) {
@@ -330,24 +799,20 @@ void ThingsBoardDevice::handle_rpc_command(const std::string& topic, const std::
         };
         
         try {
-            std::string request_id = extract_request_id(topic);
-            if (!request_id.empty()) {
-                send_rpc_response(request_id, error_response.dump());
-            }
+            queue_rpc_response(request_id, error_response.dump());
         } catch (...) {
             LOG_ERROR("Failed to send error response");
         }
     }
 }
 
-std::string ThingsBoardDevice::extract_request_id(const std::string& rpc_topic) const {
-    // Topic format: v1/devices/me/rpc/request/{request_id}
-    const std::string prefix = "v1/devices/me/rpc/request/";
-    if (rpc_topic.find(prefix) != 0) {
-        return "";
+void ThingsBoardDevice::queue_rpc_response(const std::string& request_id, const std::string& response) {
+    // Publishing waits on the client, so keep it off the Paho and engine threads
+    if (!executor_->submit([this, request_id, response]() {
+            send_rpc_response(request_id, response);
+        })) {
+        send_rpc_response(request_id, response);
     }
-    
-    return rpc_topic.substr(prefix.length());
 }
 
 void ThingsBoardDevice::setThermalRPCHandler(std::shared_ptr<thermal::ThermalRPCHandler> handler) {
@@ -357,20 +822,12 @@ void ThingsBoardDevice::setThermalRPCHandler(std::shared_ptr<thermal::ThermalRPC
         // Set up response callback to route responses back through MQTT
         thermal_rpc_handler_->setResponseCallback(
             [this](const std::string& request_id, const nlohmann::json& response) {
-                // Use a separate thread to avoid blocking issues (same as subscription fix)
-                std::thread response_thread([this, request_id, response]() {
-                    try {
-                        std::string response_str = response.dump();
-                        this->send_rpc_response(request_id, response_str);
-                    } catch (const std::exception& e) {
-                        LOG_ERROR("Exception in RPC response thread: " << e.what());
-                    } catch (...) {
-                        LOG_ERROR("Unknown exception in RPC response thread");
-                    }
-                });
-                
-                // Detach the thread so it can run independently
-                response_thread.detach();
+                // A request that already timed out has had its answer
+                if (!rpc_engine_->claimResponse(request_id)) {
+                    LOG_WARN("Dropping late response for RPC request " << request_id);
+                    return;
+                }
+                queue_rpc_response(request_id, response.dump());
             }
         );
         
@@ -0,0 +1,128 @@
+#include "thingsboard/protobuf_encoder.h"
+#include "thermal/measurement_spot.h"
+#include "thermal/measurement_area.h"
+#include <cmath>
+#include <cstring>
+
+namespace thermal {
+
+constexpr int ProtobufTelemetryEncoder::FRAME_FIELD_BASE;
+constexpr int ProtobufTelemetryEncoder::AREA_FIELD_BASE;
+constexpr int ProtobufTelemetryEncoder::AREA_FIELD_STRIDE;
+
+static_assert(MAX_MEASUREMENT_SPOTS < static_cast<size_t>(ProtobufTelemetryEncoder::FRAME_FIELD_BASE),
+              "Spot field numbers must stay below the frame extremes fields");
+static_assert(ProtobufTelemetryEncoder::FRAME_FIELD_BASE + 6 < ProtobufTelemetryEncoder::AREA_FIELD_BASE,
+              "Frame extremes fields must stay below the area fields");
+
+namespace {
+
+enum WireType : std::uint32_t {
+    VARINT = 0,
+    FIXED64 = 1,
+    LENGTH_DELIMITED = 2
+};
+
+// TelemetryEntry and RpcResponseMsg field numbers
+constexpr std::uint32_t ENTRY_TS = 1;
+constexpr std::uint32_t ENTRY_VALUES = 2;
+constexpr std::uint32_t RPC_RESPONSE_PAYLOAD = 1;
+
+void append_varint(std::string& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+void append_tag(std::string& out, std::uint32_t field, WireType type) {
+    append_varint(out, (static_cast<std::uint64_t>(field) << 3) | type);
+}
+
+void append_double(std::string& out, std::uint32_t field, double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    append_tag(out, field, FIXED64);
+    for (int i = 0; i < 8; ++i) {
+        out += static_cast<char>(bits >> (8 * i));  // Little-endian on the wire
+    }
+}
+
+void append_int(std::string& out, std::uint32_t field, std::int64_t value) {
+    // int32/int64 fields sign-extend negative values to ten bytes
+    append_tag(out, field, VARINT);
+    append_varint(out, static_cast<std::uint64_t>(value));
+}
+
+} // namespace
+
+ProtobufTelemetryEncoder::ProtobufTelemetryEncoder() {
+    buffer_.reserve(TelemetryEncoder::DEFAULT_RESERVE_BYTES);
+    values_.reserve(TelemetryEncoder::DEFAULT_RESERVE_BYTES);
+}
+
+void ProtobufTelemetryEncoder::begin(std::int64_t timestamp_ms) {
+    timestamp_ms_ = timestamp_ms;
+    values_.clear();
+}
+
+void ProtobufTelemetryEncoder::addSpot(int spot_id, double temperature) {
+    if (spot_id < 1 || spot_id >= FRAME_FIELD_BASE || !std::isfinite(temperature)) {
+        return;
+    }
+    append_double(values_, static_cast<std::uint32_t>(spot_id), temperature);
+}
+
+void ProtobufTelemetryEncoder::addFrameExtremes(const FrameExtremes& extremes) {
+    const std::uint32_t base = FRAME_FIELD_BASE;
+    if (std::isfinite(extremes.max_temp)) {
+        append_double(values_, base + 1, extremes.max_temp);
+    }
+    append_int(values_, base + 2, extremes.max_location.x);
+    append_int(values_, base + 3, extremes.max_location.y);
+    if (std::isfinite(extremes.min_temp)) {
+        append_double(values_, base + 4, extremes.min_temp);
+    }
+    append_int(values_, base + 5, extremes.min_location.x);
+    append_int(values_, base + 6, extremes.min_location.y);
+}
+
+void ProtobufTelemetryEncoder::addArea(int area_id, const AreaStatistics& statistics) {
+    if (area_id < 1 || static_cast<size_t>(area_id) > MAX_MEASUREMENT_AREAS || !statistics.valid) {
+        return;
+    }
+
+    const std::uint32_t base = AREA_FIELD_BASE + (area_id - 1) * AREA_FIELD_STRIDE;
+    if (std::isfinite(statistics.max_temp)) {
+        append_double(values_, base + 1, statistics.max_temp);
+    }
+    append_int(values_, base + 2, statistics.hottest.x);
+    append_int(values_, base + 3, statistics.hottest.y);
+    if (std::isfinite(statistics.mean_temp)) {
+        append_double(values_, base + 4, statistics.mean_temp);
+    }
+    if (std::isfinite(statistics.min_temp)) {
+        append_double(values_, base + 5, statistics.min_temp);
+    }
+}
+
+const std::string& ProtobufTelemetryEncoder::finish() {
+    buffer_.clear();
+    append_int(buffer_, ENTRY_TS, timestamp_ms_);
+    append_tag(buffer_, ENTRY_VALUES, LENGTH_DELIMITED);
+    append_varint(buffer_, values_.size());
+    buffer_ += values_;
+    return buffer_;
+}
+
+std::string ProtobufTelemetryEncoder::encodeRpcResponse(const std::string& response) {
+    std::string message;
+    message.reserve(response.size() + 6);
+    append_tag(message, RPC_RESPONSE_PAYLOAD, LENGTH_DELIMITED);
+    append_varint(message, response.size());
+    message += response;
+    return message;
+}
+
+} // namespace thermal
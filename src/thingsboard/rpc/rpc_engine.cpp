@@ -0,0 +1,315 @@
+#include "thingsboard/rpc/rpc_engine.h"
+#include "thingsboard/rpc/rpc_timeout_manager.h"
+#include "common/logger.h"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <utility>
+
+namespace thermal {
+
+constexpr std::chrono::milliseconds RPCEngine::TIMER_TICK;
+constexpr size_t RPCEngine::TIMER_SLOTS;
+constexpr int RPCEngine::MIN_RETRY_AFTER_MS;
+constexpr int RPCEngine::MAX_RETRY_AFTER_MS;
+
+RPCEngine::RPCEngine(size_t workers, ExecuteFunction execute, TimeoutFunction on_timeout,
+                     const RPCAdmissionLimits& limits)
+    : execute_(std::move(execute))
+    , on_timeout_(std::move(on_timeout))
+    , limits_(limits)
+    , workers_(std::max<size_t>(workers, 1))
+    , tokens_(limits.burst)
+    , last_refill_(TimerWheel::Clock::now())
+    , wheel_(TIMER_TICK, TIMER_SLOTS)
+    , queue_depth_(MetricsRegistry::instance().gauge("rpc_queue_depth", "RPC commands accepted but not yet started"))
+    , executor_(std::make_unique<Executor>(workers, "rpc")) {
+    timer_thread_ = std::thread(&RPCEngine::timerLoop, this);
+}
+
+RPCEngine::~RPCEngine() {
+    shutdown();
+}
+
+bool RPCEngine::isReadOnly(RPCMethod method) {
+    return method == RPCMethod::LIST_SPOT_MEASUREMENTS || method == RPCMethod::GET_SPOT_TEMPERATURE;
+}
+
+std::string RPCEngine::laneKey(const RPCCommand& command) {
+    return command.spotId();
+}
+
+RPCAdmission RPCEngine::submit(RPCCommand command, int* retry_after_ms) {
+    bool wake_timer = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!accepting_) {
+            return RPCAdmission::REJECTED;
+        }
+        if (in_flight_.count(command.requestId)) {
+            LOG_WARN("RPC request " << command.requestId << " is already in flight, dropping duplicate");
+            return RPCAdmission::REJECTED;
+        }
+        
+        int retry_after = 0;
+        if (!admitLocked(command.method, retry_after)) {
+            rejected_busy_++;
+            if (retry_after_ms) {
+                *retry_after_ms = retry_after;
+            }
+            return RPCAdmission::BUSY;
+        }
+        queued_++;
+        queue_depth_.set(static_cast<std::int64_t>(queued_));
+        pending_[command.method]++;
+        
+        // Arm the deadline before the command can possibly respond
+        std::uint64_t token = next_token_++;
+        in_flight_[command.requestId] = {token, command.timeoutMs, command.method, TimerWheel::Clock::now()};
+        token_requests_[token] = command.requestId;
+        wake_timer = wheel_.empty();
+        wheel_.schedule(token, TimerWheel::Clock::now() + std::chrono::milliseconds(command.timeoutMs));
+        submitted_++;
+        
+        bool is_batch = command.method == RPCMethod::APPLY_SPOT_BATCH;
+        if (isReadOnly(command.method)) {
+            executor_->submit([this, command]() { run(command); });
+        } else if (batch_running_ || !held_.empty() || (is_batch && !lanes_.empty())) {
+            // Behind a spot batch, or a batch waiting for the lanes to drain
+            held_.push_back(std::move(command));
+        } else {
+            startLocked(std::move(command));
+        }
+    }
+    
+    if (wake_timer) {
+        timer_wake_.notify_one();  // Sleeps without a timeout while no deadline is armed
+    }
+    return RPCAdmission::ACCEPTED;
+}
+
+bool RPCEngine::admitLocked(RPCMethod method, int& retry_after_ms) {
+    // Refill the bucket for the time since the last command
+    auto now = TimerWheel::Clock::now();
+    if (limits_.rate_per_second > 0.0) {
+        double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+        tokens_ = std::min(limits_.burst, tokens_ + elapsed * limits_.rate_per_second);
+    }
+    last_refill_ = now;
+    
+    // Hints assume the backlog ahead drains at the observed execution rate
+    double run_ms = std::max(average_run_ms_, 1.0);
+    double wait_ms = 0.0;
+    if (limits_.rate_per_second > 0.0 && tokens_ < 1.0) {
+        wait_ms = (1.0 - tokens_) / limits_.rate_per_second * 1000.0;
+        LOG_DEBUG("RPC rate limit reached");
+    } else if (queued_ >= limits_.max_queue_depth) {
+        wait_ms = run_ms * static_cast<double>(queued_ + 1) / static_cast<double>(workers_);
+        LOG_DEBUG("RPC queue full (" << queued_ << " waiting)");
+    } else if (pending_[method] >= limits_.max_pending_per_method) {
+        wait_ms = run_ms * static_cast<double>(pending_[method]);
+        LOG_DEBUG("RPC limit reached for " << RPCCommand::methodToString(method));
+    } else {
+        if (limits_.rate_per_second > 0.0) {
+            tokens_ -= 1.0;
+        }
+        return true;
+    }
+    
+    retry_after_ms = std::clamp(static_cast<int>(std::ceil(wait_ms)), MIN_RETRY_AFTER_MS, MAX_RETRY_AFTER_MS);
+    return false;
+}
+
+bool RPCEngine::claimResponse(const std::string& request_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = in_flight_.find(request_id);
+    if (it == in_flight_.end()) {
+        return false;
+    }
+    
+    latencyLocked(it->second.method).recordDuration(TimerWheel::Clock::now() - it->second.submitted_at);
+    token_requests_.erase(it->second.token);
+    in_flight_.erase(it);
+    return true;
+}
+
+Histogram& RPCEngine::latencyLocked(RPCMethod method) {
+    Histogram*& histogram = latency_[method];
+    if (!histogram) {
+        histogram = &MetricsRegistry::instance().histogram(
+            "rpc_latency_microseconds", "Time from RPC arrival to its response",
+            {{"method", RPCCommand::methodToString(method)}});
+    }
+    return *histogram;
+}
+
+void RPCEngine::shutdown() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!accepting_) {
+            return;
+        }
+        accepting_ = false;
+        
+        // Held mutations are started from workers, which the executor refuses once shut down
+        released_.wait(lock, [this] { return held_.empty() && !batch_running_; });
+    }
+    
+    // Queued commands still run (and can still time out) before the timer stops
+    executor_->shutdown();
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        timer_running_ = false;
+    }
+    timer_wake_.notify_one();
+    if (timer_thread_.joinable()) {
+        timer_thread_.join();
+    }
+}
+
+RPCEngineStats RPCEngine::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    RPCEngineStats stats;
+    stats.in_flight = in_flight_.size();
+    stats.submitted = submitted_;
+    stats.completed = completed_;
+    stats.timed_out = timed_out_;
+    stats.skipped = skipped_;
+    stats.rejected_busy = rejected_busy_;
+    return stats;
+}
+
+void RPCEngine::startLocked(RPCCommand command) {
+    if (command.method == RPCMethod::APPLY_SPOT_BATCH) {
+        batch_running_ = true;
+        executor_->submit([this, command]() { runBatch(command); });
+        return;
+    }
+    
+    std::string key = laneKey(command);
+    RPCCommandQueue& lane = lanes_[key];
+    if (lane.isProcessing()) {
+        // Runs after the lane's current command
+        lane.enqueue(std::make_unique<RPCCommand>(std::move(command)));
+    } else {
+        lane.setProcessing(true);
+        executor_->submit([this, key, command]() { runLane(key, command); });
+    }
+}
+
+void RPCEngine::releaseHeldLocked() {
+    while (!batch_running_ && !held_.empty()) {
+        if (held_.front().method == RPCMethod::APPLY_SPOT_BATCH && !lanes_.empty()) {
+            return;  // Started by the last lane to drain
+        }
+        RPCCommand command = std::move(held_.front());
+        held_.pop_front();
+        startLocked(std::move(command));
+    }
+    if (held_.empty() && !batch_running_) {
+        released_.notify_all();
+    }
+}
+
+void RPCEngine::run(const RPCCommand& command) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queued_--;
+        queue_depth_.set(static_cast<std::int64_t>(queued_));
+        if (!in_flight_.count(command.requestId)) {
+            // Already answered with TIMEOUT; the caller must not see it applied
+            LOG_WARN("Skipping timed out RPC " << RPCCommand::methodToString(command.method)
+                     << " (request " << command.requestId << ")");
+            pending_[command.method]--;
+            skipped_++;
+            return;
+        }
+    }
+    
+    auto started = TimerWheel::Clock::now();
+    try {
+        execute_(command);
+    } catch (const std::exception& e) {
+        LOG_ERROR("Exception executing RPC request " << command.requestId << ": " << e.what());
+    }
+    double run_ms = std::chrono::duration<double, std::milli>(TimerWheel::Clock::now() - started).count();
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_[command.method]--;
+    average_run_ms_ = average_run_ms_ == 0.0 ? run_ms : 0.8 * average_run_ms_ + 0.2 * run_ms;
+    completed_++;
+}
+
+void RPCEngine::runLane(const std::string& key, RPCCommand command) {
+    for (;;) {
+        run(command);
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        RPCCommandQueue& lane = lanes_[key];
+        auto next = lane.dequeue();
+        if (!next) {
+            lanes_.erase(key);
+            releaseHeldLocked();
+            return;
+        }
+        command = std::move(*next);
+    }
+}
+
+void RPCEngine::runBatch(const RPCCommand& command) {
+    run(command);
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    batch_running_ = false;
+    releaseHeldLocked();
+}
+
+void RPCEngine::timerLoop() {
+    std::vector<std::uint64_t> expired;
+    std::vector<RPCResponse> responses;
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (timer_running_) {
+        if (wheel_.empty()) {
+            timer_wake_.wait(lock);
+        } else {
+            timer_wake_.wait_for(lock, wheel_.tick());
+        }
+        
+        expired.clear();
+        wheel_.advance(TimerWheel::Clock::now(), expired);
+        for (std::uint64_t token : expired) {
+            auto request = token_requests_.find(token);
+            if (request == token_requests_.end()) {
+                continue;  // Answered before its deadline
+            }
+            
+            auto it = in_flight_.find(request->second);
+            responses.push_back(RPCTimeoutManager::createTimeoutResponse(request->second, it->second.timeout_ms));
+            latencyLocked(it->second.method).recordDuration(TimerWheel::Clock::now() - it->second.submitted_at);
+            in_flight_.erase(it);
+            token_requests_.erase(request);
+            timed_out_++;
+        }
+        
+        if (responses.empty()) {
+            continue;
+        }
+        
+        lock.unlock();
+        for (const auto& response : responses) {
+            LOG_WARN("RPC request " << response.requestId << " timed out after "
+                     << response.responseTimeMs << " ms");
+            try {
+                on_timeout_(response);
+            } catch (const std::exception& e) {
+                LOG_ERROR("Exception sending RPC timeout response: " << e.what());
+            }
+        }
+        responses.clear();
+        lock.lock();
+    }
+}
+
+} // namespace thermal
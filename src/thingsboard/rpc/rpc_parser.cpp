@@ -1,48 +1,67 @@
 #include "thingsboard/rpc/rpc_parser.h"
+#include "thermal/measurement_spot.h"
 #include "common/logger.h"
-#include <regex>
 
 namespace thermal {
 
-RPCCommand RPCParser::parseCommand(const std::string& request_id, const std::string& json_payload) {
+const std::string RPCParser::INVALID_SPOT_ID_MESSAGE =
+    "Invalid spotId: must be an integer from 1 to " + std::to_string(MAX_MEASUREMENT_SPOTS);
+
+const size_t RPCParser::MAX_BATCH_OPERATIONS = 2 * MAX_MEASUREMENT_SPOTS;
+
+RPCCommand RPCParser::parseCommand(std::string_view request_id, std::string_view json_payload) {
     RPCCommand command;
-    command.requestId = request_id;
+    command.requestId = std::string(request_id);
     command.receivedAt = std::chrono::system_clock::now();
     command.status = RPCStatus::PENDING;
     
     nlohmann::json json_data;
-    if (!parseJsonSafely(json_payload, json_data)) {
+    if (!parseJsonSafely(json_payload, json_data) || !json_data.is_object()) {
         command.status = RPCStatus::ERROR;
+        command.error = "Invalid JSON payload";
         LOG_ERROR("Invalid JSON in RPC command: " << json_payload);
         return command;
     }
     
     // Parse method
-    if (!json_data.contains("method") || !json_data["method"].is_string()) {
+    auto method = json_data.find("method");
+    if (method == json_data.end() || !method->is_string()) {
         command.status = RPCStatus::ERROR;
+        command.error = "Missing or invalid 'method' field";
         LOG_ERROR("Missing or invalid 'method' field in RPC command");
         return command;
     }
     
-    std::string method_str = json_data["method"].get<std::string>();
+    const std::string& method_str = method->get_ref<const std::string&>();
     command.method = RPCCommand::parseMethod(method_str);
     
     if (command.method == RPCMethod::UNKNOWN) {
         command.status = RPCStatus::ERROR;
+        command.error = "Unknown RPC method";
         LOG_ERROR("Unknown RPC method: " << method_str);
         return command;
     }
     
-    // Parse parameters
-    if (json_data.contains("params")) {
-        command.parameters = json_data["params"];
-    } else {
-        command.parameters = nlohmann::json::object();
+    // Parse timeout (optional)
+    auto timeout = json_data.find("timeout");
+    if (timeout != json_data.end() && timeout->is_number_integer()) {
+        command.timeoutMs = timeout->get<int>();
+    }
+    if (!validateTimeout(command.timeoutMs)) {
+        command.status = RPCStatus::ERROR;
+        command.error = "Invalid timeout value: must be between 1000 and 30000 milliseconds";
+        return command;
     }
     
-    // Parse timeout (optional)
-    if (json_data.contains("timeout") && json_data["timeout"].is_number_integer()) {
-        command.timeoutMs = json_data["timeout"].get<int>();
+    // Parameters are extracted and validated once, into the method's typed arguments
+    static const nlohmann::json no_params = nlohmann::json::object();
+    auto params_it = json_data.find("params");
+    const nlohmann::json& params = params_it != json_data.end() ? *params_it : no_params;
+    command.error = parseArguments(command.method, params, command.arguments);
+    if (!command.error.empty()) {
+        command.status = RPCStatus::ERROR;
+        command.arguments = std::monostate{};
+        return command;
     }
     
     LOG_DEBUG("Parsed RPC command: method=" << method_str << ", requestId=" << request_id);
@@ -50,87 +69,114 @@ RPCCommand RPCParser::parseCommand(const std::string& request_id, const std::str
 }
 
 std::string RPCParser::validateCommand(const RPCCommand& command) {
-    // Validate timeout
-    if (!validateTimeout(command.timeoutMs)) {
-        return "Invalid timeout value: must be between 1000 and 30000 milliseconds";
+    if (!command.error.empty()) {
+        return command.error;
     }
-    
-    // Method-specific validation
-    switch (command.method) {
-        case RPCMethod::CREATE_SPOT_MEASUREMENT: {
-            std::string spotId;
-            int x, y;
-            return parseCreateSpotParams(command.parameters, spotId, x, y);
-        }
-        
-        case RPCMethod::MOVE_SPOT_MEASUREMENT: {
-            std::string spotId;
-            int x, y;
-            return parseMoveSpotParams(command.parameters, spotId, x, y);
-        }
-        
-        case RPCMethod::DELETE_SPOT_MEASUREMENT: {
-            std::string spotId;
-            return parseDeleteSpotParams(command.parameters, spotId);
-        }
-        
-        case RPCMethod::LIST_SPOT_MEASUREMENTS: {
+    if (std::holds_alternative<std::monostate>(command.arguments)) {
+        return "Unknown RPC method";
+    }
+    return "";
+}
+
+std::string RPCParser::parseArguments(RPCMethod method, const nlohmann::json& params, RPCArguments& arguments) {
+    switch (method) {
+        case RPCMethod::CREATE_SPOT_MEASUREMENT:
+            return parseCreateSpotParams(params, arguments.emplace<CreateSpotArgs>());
+        case RPCMethod::MOVE_SPOT_MEASUREMENT:
+            return parseMoveSpotParams(params, arguments.emplace<MoveSpotArgs>());
+        case RPCMethod::DELETE_SPOT_MEASUREMENT:
+            return parseDeleteSpotParams(params, arguments.emplace<DeleteSpotArgs>());
+        case RPCMethod::LIST_SPOT_MEASUREMENTS:
             // List command requires no parameters
+            arguments.emplace<ListSpotsArgs>();
             return "";
-        }
-        
+        case RPCMethod::GET_SPOT_TEMPERATURE:
+            return parseGetTemperatureParams(params, arguments.emplace<GetSpotTemperatureArgs>());
+        case RPCMethod::APPLY_SPOT_BATCH:
+            return parseSpotBatchParams(params, arguments.emplace<ApplySpotBatchArgs>());
         case RPCMethod::UNKNOWN:
         default:
+            arguments = std::monostate{};
             return "Unknown RPC method";
     }
 }
 
-std::string RPCParser::parseCreateSpotParams(const nlohmann::json& params, 
-                                           std::string& spotId, int& x, int& y) {
-    if (!extractStringParam(params, "spotId", spotId)) {
-        return "Missing or invalid 'spotId' parameter";
-    }
-    
-    if (!validateSpotId(spotId)) {
-        return "Invalid spotId: must be '1', '2', '3', '4', or '5'";
-    }
-    
-    if (!extractIntParam(params, "x", x)) {
-        return "Missing or invalid 'x' coordinate parameter";
-    }
-    
-    if (!extractIntParam(params, "y", y)) {
-        return "Missing or invalid 'y' coordinate parameter";
+std::string RPCParser::parseCreateSpotParams(const nlohmann::json& params, CreateSpotArgs& args) {
+    // spotId is optional on create; when omitted the manager assigns a free ID
+    args.spotId.clear();
+    if (params.is_object() && params.contains("spotId")) {
+        if (!extractStringParam(params, "spotId", args.spotId)) {
+            return "Missing or invalid 'spotId' parameter";
+        }
+        
+        if (!validateSpotId(args.spotId)) {
+            return INVALID_SPOT_ID_MESSAGE;
+        }
     }
     
-    if (!validateCoordinates(x, y)) {
-        return "Invalid coordinates: x must be 0-319, y must be 0-239";
+    return parseCoordinates(params, args.x, args.y);
+}
+
+std::string RPCParser::parseMoveSpotParams(const nlohmann::json& params, MoveSpotArgs& args) {
+    // Same validation as createSpot, except the spot must be named
+    std::string error = parseSpotId(params, args.spotId);
+    if (!error.empty()) {
+        return error;
     }
     
-    return ""; // Valid
+    return parseCoordinates(params, args.x, args.y);
 }
 
-std::string RPCParser::parseMoveSpotParams(const nlohmann::json& params,
-                                         std::string& spotId, int& x, int& y) {
-    // Same validation as createSpot
-    return parseCreateSpotParams(params, spotId, x, y);
+std::string RPCParser::parseDeleteSpotParams(const nlohmann::json& params, DeleteSpotArgs& args) {
+    return parseSpotId(params, args.spotId);
 }
 
-std::string RPCParser::parseDeleteSpotParams(const nlohmann::json& params,
-                                           std::string& spotId) {
-    if (!extractStringParam(params, "spotId", spotId)) {
-        return "Missing or invalid 'spotId' parameter";
-    }
-    
-    if (!validateSpotId(spotId)) {
-        return "Invalid spotId: must be '1', '2', '3', '4', or '5'";
+std::string RPCParser::parseGetTemperatureParams(const nlohmann::json& params, GetSpotTemperatureArgs& args) {
+    return parseSpotId(params, args.spotId);
+}
+
+std::string RPCParser::parseSpotBatchParams(const nlohmann::json& params, ApplySpotBatchArgs& args) {
+    args.operations.clear();
+    
+    auto operations = params.is_object() ? params.find("operations") : params.end();
+    if (operations == params.end() || !operations->is_array() || operations->empty()) {
+        return "Missing or invalid 'operations' parameter: must be a non-empty array";
+    }
+    if (operations->size() > MAX_BATCH_OPERATIONS) {
+        return "Too many operations: at most " + std::to_string(MAX_BATCH_OPERATIONS) + " per batch";
+    }
+    
+    args.operations.reserve(operations->size());
+    for (size_t i = 0; i < operations->size(); ++i) {
+        const nlohmann::json& operation = (*operations)[i];
+        std::string op;
+        std::string error;
+        if (!extractStringParam(operation, "op", op)) {
+            error = "Missing or invalid 'op' parameter";
+        } else if (op == "create") {
+            error = parseCreateSpotParams(operation, std::get<CreateSpotArgs>(
+                args.operations.emplace_back(std::in_place_type<CreateSpotArgs>)));
+        } else if (op == "move") {
+            error = parseMoveSpotParams(operation, std::get<MoveSpotArgs>(
+                args.operations.emplace_back(std::in_place_type<MoveSpotArgs>)));
+        } else if (op == "delete") {
+            error = parseDeleteSpotParams(operation, std::get<DeleteSpotArgs>(
+                args.operations.emplace_back(std::in_place_type<DeleteSpotArgs>)));
+        } else {
+            error = "Unknown op '" + op + "': must be create, move or delete";
+        }
+        
+        if (!error.empty()) {
+            args.operations.clear();
+            return "operations[" + std::to_string(i) + "]: " + error;
+        }
     }
     
     return ""; // Valid
 }
 
 bool RPCParser::validateSpotId(const std::string& spotId) {
-    return spotId == "1" || spotId == "2" || spotId == "3" || spotId == "4" || spotId == "5";
+    return parse_spot_id(spotId) != 0;
 }
 
 bool RPCParser::validateCoordinates(int x, int y) {
@@ -141,7 +187,7 @@ bool RPCParser::validateTimeout(int timeout_ms) {
     return timeout_ms >= 1000 && timeout_ms <= 30000;
 }
 
-bool RPCParser::parseJsonSafely(const std::string& json_str, nlohmann::json& result) {
+bool RPCParser::parseJsonSafely(std::string_view json_str, nlohmann::json& result) {
     try {
         result = nlohmann::json::parse(json_str);
         return true;
@@ -151,21 +197,57 @@ bool RPCParser::parseJsonSafely(const std::string& json_str, nlohmann::json& res
     }
 }
 
-bool RPCParser::extractStringParam(const nlohmann::json& params, const std::string& key, std::string& value) {
-    if (!params.contains(key) || !params[key].is_string()) {
+std::string RPCParser::parseSpotId(const nlohmann::json& params, std::string& spotId) {
+    if (!extractStringParam(params, "spotId", spotId)) {
+        return "Missing or invalid 'spotId' parameter";
+    }
+    
+    if (!validateSpotId(spotId)) {
+        return INVALID_SPOT_ID_MESSAGE;
+    }
+    
+    return ""; // Valid
+}
+
+std::string RPCParser::parseCoordinates(const nlohmann::json& params, int& x, int& y) {
+    if (!extractIntParam(params, "x", x)) {
+        return "Missing or invalid 'x' coordinate parameter";
+    }
+    
+    if (!extractIntParam(params, "y", y)) {
+        return "Missing or invalid 'y' coordinate parameter";
+    }
+    
+    if (!validateCoordinates(x, y)) {
+        return "Invalid coordinates: x must be 0-319, y must be 0-239";
+    }
+    
+    return ""; // Valid
+}
+
+bool RPCParser::extractStringParam(const nlohmann::json& params, const char* key, std::string& value) {
+    if (!params.is_object()) {
+        return false;
+    }
+    auto it = params.find(key);
+    if (it == params.end() || !it->is_string()) {
         return false;
     }
     
-    value = params[key].get<std::string>();
+    value = it->get<std::string>();
     return true;
 }
 
-bool RPCParser::extractIntParam(const nlohmann::json& params, const std::string& key, int& value) {
-    if (!params.contains(key) || !params[key].is_number_integer()) {
+bool RPCParser::extractIntParam(const nlohmann::json& params, const char* key, int& value) {
+    if (!params.is_object()) {
+        return false;
+    }
+    auto it = params.find(key);
+    if (it == params.end() || !it->is_number_integer()) {
         return false;
     }
     
-    value = params[key].get<int>();
+    value = it->get<int>();
     return true;
 }
 
@@ -1,5 +1,6 @@
 #include "thingsboard/rpc/rpc_types.h"
 #include <map>
+#include <type_traits>
 
 namespace thermal {
 
@@ -9,7 +10,8 @@ RPCMethod RPCCommand::parseMethod(const std::string& method_str) {
         {"moveSpotMeasurement", RPCMethod::MOVE_SPOT_MEASUREMENT},
         {"deleteSpotMeasurement", RPCMethod::DELETE_SPOT_MEASUREMENT},
         {"listSpotMeasurements", RPCMethod::LIST_SPOT_MEASUREMENTS},
-        {"getSpotTemperature", RPCMethod::GET_SPOT_TEMPERATURE}
+        {"getSpotTemperature", RPCMethod::GET_SPOT_TEMPERATURE},
+        {"applySpotBatch", RPCMethod::APPLY_SPOT_BATCH}
     };
     
     auto it = method_map.find(method_str);
@@ -28,12 +30,27 @@ std::string RPCCommand::methodToString(RPCMethod method) {
             return "listSpotMeasurements";
         case RPCMethod::GET_SPOT_TEMPERATURE:
             return "getSpotTemperature";
+        case RPCMethod::APPLY_SPOT_BATCH:
+            return "applySpotBatch";
         case RPCMethod::UNKNOWN:
         default:
             return "unknown";
     }
 }
 
+const std::string& RPCCommand::spotId() const {
+    static const std::string none;
+    return std::visit([](const auto& args) -> const std::string& {
+        using Args = std::decay_t<decltype(args)>;
+        if constexpr (std::is_same_v<Args, std::monostate> || std::is_same_v<Args, ListSpotsArgs> ||
+                      std::is_same_v<Args, ApplySpotBatchArgs>) {
+            return none;
+        } else {
+            return args.spotId;
+        }
+    }, arguments);
+}
+
 bool RPCCommand::isTimedOut() const {
     if (status == RPCStatus::COMPLETED || status == RPCStatus::ERROR || status == RPCStatus::TIMEOUT) {
         return false; // Already completed
@@ -0,0 +1,178 @@
+#include "thingsboard/telemetry_encoder.h"
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+
+namespace thermal {
+
+constexpr size_t TelemetryEncoder::DEFAULT_RESERVE_BYTES;
+
+namespace {
+
+// Room for any double or 64-bit integer
+constexpr size_t NUMBER_BUFFER_BYTES = 64;
+
+} // namespace
+
+TelemetryEncoder::TelemetryEncoder(size_t reserve_bytes) {
+    buffer_.reserve(reserve_bytes);
+    spots_.reserve(64);
+}
+
+const std::string& TelemetryEncoder::encodeReading(int spot_id, double temperature) {
+    buffer_.clear();
+    buffer_ += '{';
+    buffer_ += spotKey(spot_id);
+    appendDouble(temperature);
+    buffer_ += '}';
+    return buffer_;
+}
+
+void TelemetryEncoder::begin(std::int64_t timestamp_ms) {
+    timestamp_ms_ = timestamp_ms;
+    spots_.clear();
+    areas_.clear();
+    has_extremes_ = false;
+}
+
+void TelemetryEncoder::addSpot(int spot_id, double temperature) {
+    spots_.push_back({&spotKey(spot_id), temperature, spots_.size()});
+}
+
+void TelemetryEncoder::addFrameExtremes(const FrameExtremes& extremes) {
+    extremes_ = extremes;
+    has_extremes_ = true;
+}
+
+void TelemetryEncoder::addArea(int area_id, const AreaStatistics& statistics) {
+    if (statistics.valid) {
+        areas_.push_back({&areaPrefix(area_id), statistics, areas_.size()});
+    }
+}
+
+const std::string& TelemetryEncoder::finish() {
+    buffer_.clear();
+    buffer_ += "{\"ts\":";
+    appendInteger(timestamp_ms_);
+    buffer_ += ",\"values\":{";
+
+    // "area_*" sorts first; an area's five keys share its prefix, which ends in
+    // '_' and so orders areas exactly like their key names ("area_10_" before "area_1_")
+    bool first = true;
+    std::sort(areas_.begin(), areas_.end(), [](const AreaValue& a, const AreaValue& b) {
+        int order = a.prefix->compare(*b.prefix);
+        return order != 0 ? order < 0 : a.index < b.index;
+    });
+    for (size_t i = 0; i < areas_.size(); ++i) {
+        if (i + 1 < areas_.size() && areas_[i + 1].prefix == areas_[i].prefix) {
+            continue;  // Overwritten by a later value for the same area
+        }
+        if (!first) {
+            buffer_ += ',';
+        }
+        appendArea(areas_[i]);
+        first = false;
+    }
+
+    // "frame_*" sorts before "temperature_spot_*", and these six are already in order
+    if (has_extremes_) {
+        if (!first) {
+            buffer_ += ',';
+        }
+        buffer_ += "\"frame_max_temp\":";
+        appendDouble(extremes_.max_temp);
+        buffer_ += ",\"frame_max_x\":";
+        appendInteger(extremes_.max_location.x);
+        buffer_ += ",\"frame_max_y\":";
+        appendInteger(extremes_.max_location.y);
+        buffer_ += ",\"frame_min_temp\":";
+        appendDouble(extremes_.min_temp);
+        buffer_ += ",\"frame_min_x\":";
+        appendInteger(extremes_.min_location.x);
+        buffer_ += ",\"frame_min_y\":";
+        appendInteger(extremes_.min_location.y);
+        first = false;
+    }
+
+    // Cached keys end in '"', which sorts below every key character, so comparing
+    // them orders spots exactly like the key names ("..._10" before "..._2")
+    std::sort(spots_.begin(), spots_.end(), [](const SpotValue& a, const SpotValue& b) {
+        int order = a.key->compare(*b.key);
+        return order != 0 ? order < 0 : a.index < b.index;
+    });
+    for (size_t i = 0; i < spots_.size(); ++i) {
+        if (i + 1 < spots_.size() && spots_[i + 1].key == spots_[i].key) {
+            continue;  // Overwritten by a later value for the same spot
+        }
+        if (!first) {
+            buffer_ += ',';
+        }
+        buffer_ += *spots_[i].key;
+        appendDouble(spots_[i].value);
+        first = false;
+    }
+
+    buffer_ += "}}";
+    return buffer_;
+}
+
+const std::string& TelemetryEncoder::areaPrefix(int area_id) {
+    auto it = area_prefixes_.find(area_id);
+    if (it == area_prefixes_.end()) {
+        it = area_prefixes_.emplace(area_id, "\"area_" + std::to_string(area_id) + "_").first;
+    }
+    return it->second;
+}
+
+void TelemetryEncoder::appendArea(const AreaValue& area) {
+    // Suffixes in key order
+    const AreaStatistics& statistics = area.statistics;
+    buffer_ += *area.prefix;
+    buffer_ += "max_temp\":";
+    appendDouble(statistics.max_temp);
+    buffer_ += ',';
+    buffer_ += *area.prefix;
+    buffer_ += "max_x\":";
+    appendInteger(statistics.hottest.x);
+    buffer_ += ',';
+    buffer_ += *area.prefix;
+    buffer_ += "max_y\":";
+    appendInteger(statistics.hottest.y);
+    buffer_ += ',';
+    buffer_ += *area.prefix;
+    buffer_ += "mean_temp\":";
+    appendDouble(statistics.mean_temp);
+    buffer_ += ',';
+    buffer_ += *area.prefix;
+    buffer_ += "min_temp\":";
+    appendDouble(statistics.min_temp);
+}
+
+const std::string& TelemetryEncoder::spotKey(int spot_id) {
+    auto it = spot_keys_.find(spot_id);
+    if (it == spot_keys_.end()) {
+        it = spot_keys_.emplace(spot_id, "\"temperature_spot_" + std::to_string(spot_id) + "\":").first;
+    }
+    return it->second;
+}
+
+void TelemetryEncoder::appendDouble(double value) {
+    if (!std::isfinite(value)) {
+        buffer_ += "null";
+        return;
+    }
+    // nlohmann's own Grisu2 formatter, so output matches dump() byte for byte;
+    // std::to_chars picks a different shortest form for a few values
+    char number[NUMBER_BUFFER_BYTES];
+    char* end = nlohmann::detail::to_chars(number, number + sizeof(number), value);
+    buffer_.append(number, end);
+}
+
+void TelemetryEncoder::appendInteger(std::int64_t value) {
+    char number[NUMBER_BUFFER_BYTES];
+    auto result = std::to_chars(number, number + sizeof(number), value);
+    buffer_.append(number, result.ptr);
+}
+
+} // namespace thermal
@@ -0,0 +1,433 @@
+#include "thingsboard/telemetry_journal.h"
+#include "common/logger.h"
+#include "utils/file_utils.h"
+#include "utils/mapped_file.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace thermal {
+
+namespace {
+
+// Record layout: uint32 payload length, uint32 checksum, int64 timestamp, payload
+constexpr size_t RECORD_HEADER_BYTES = 16;
+constexpr size_t MAX_RECORD_PAYLOAD = 16 * 1024 * 1024;
+
+const char* const SEGMENT_PREFIX = "segment-";
+const char* const SEGMENT_SUFFIX = ".log";
+
+std::uint32_t recordChecksum(std::int64_t timestamp_ms, const char* payload, size_t length) {
+    // FNV-1a over the timestamp and payload bytes
+    std::uint32_t hash = 2166136261u;
+    auto mix = [&hash](const unsigned char* bytes, size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            hash ^= bytes[i];
+            hash *= 16777619u;
+        }
+    };
+    mix(reinterpret_cast<const unsigned char*>(&timestamp_ms), sizeof(timestamp_ms));
+    mix(reinterpret_cast<const unsigned char*>(payload), length);
+    return hash;
+}
+
+void encodeHeader(unsigned char* header, std::uint32_t length, std::uint32_t checksum, std::int64_t timestamp_ms) {
+    std::memcpy(header, &length, 4);
+    std::memcpy(header + 4, &checksum, 4);
+    std::memcpy(header + 8, &timestamp_ms, 8);
+}
+
+void decodeHeader(const unsigned char* header, std::uint32_t& length, std::uint32_t& checksum, std::int64_t& timestamp_ms) {
+    std::memcpy(&length, header, 4);
+    std::memcpy(&checksum, header + 4, 4);
+    std::memcpy(&timestamp_ms, header + 8, 8);
+}
+
+bool preadAll(int fd, void* buffer, size_t length, size_t offset) {
+    auto* out = static_cast<char*>(buffer);
+    while (length > 0) {
+        ssize_t n = ::pread(fd, out, length, static_cast<off_t>(offset));
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        out += n;
+        offset += static_cast<size_t>(n);
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool writeAll(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t n = ::write(fd, data, length);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+TelemetryJournal::TelemetryJournal(const JournalOptions& options)
+    : options_(options), last_sync_(std::chrono::steady_clock::now()) {
+    if (options_.directory.empty()) {
+        throw std::invalid_argument("Journal directory must be set");
+    }
+    if (options_.segment_bytes < RECORD_HEADER_BYTES || options_.max_bytes < options_.segment_bytes) {
+        throw std::invalid_argument("Journal size limit must be at least one segment");
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(options_.directory, ec);
+    if (ec) {
+        throw std::runtime_error("Cannot create journal directory " + options_.directory + ": " + ec.message());
+    }
+
+    recover();
+    if (!openNewSegment()) {
+        throw std::runtime_error("Cannot open journal segment in " + options_.directory);
+    }
+    releaseReplayedSegments();
+
+    if (!empty()) {
+        LOG_INFO("Telemetry journal holds " << pendingRecords() << " records to backfill ("
+                << disk_bytes_ << " bytes in " << segments_.size() << " segments)");
+    }
+}
+
+TelemetryJournal::~TelemetryJournal() {
+    sync();
+    if (write_fd_ >= 0) {
+        ::close(write_fd_);
+    }
+}
+
+bool TelemetryJournal::append(std::int64_t timestamp_ms, const std::string& payload) {
+    if (payload.size() > MAX_RECORD_PAYLOAD) {
+        LOG_ERROR("Telemetry payload of " << payload.size() << " bytes is too large to journal");
+        return false;
+    }
+
+    const size_t record_bytes = RECORD_HEADER_BYTES + payload.size();
+    if (segments_.back().records > 0 && segments_.back().bytes + record_bytes > options_.segment_bytes) {
+        if (!openNewSegment()) {
+            return false;
+        }
+    }
+
+    std::string record(RECORD_HEADER_BYTES, '\0');
+    encodeHeader(reinterpret_cast<unsigned char*>(&record[0]), static_cast<std::uint32_t>(payload.size()),
+                 recordChecksum(timestamp_ms, payload.data(), payload.size()), timestamp_ms);
+    record += payload;
+
+    Segment& segment = segments_.back();
+    if (!writeAll(write_fd_, record.data(), record.size())) {
+        LOG_ERROR("Failed to write telemetry journal " << segment.path << ": " << std::strerror(errno));
+        // Drop a partial record so the next append starts on a boundary
+        if (::ftruncate(write_fd_, static_cast<off_t>(segment.bytes)) == 0) {
+            ::lseek(write_fd_, static_cast<off_t>(segment.bytes), SEEK_SET);
+        }
+        return false;
+    }
+
+    segment.bytes += record_bytes;
+    segment.records++;
+    disk_bytes_ += record_bytes;
+
+    while (disk_bytes_ > options_.max_bytes && segments_.size() > 1) {
+        dropOldestSegment();
+    }
+
+    if (++unsynced_records_ >= options_.sync_every_records ||
+        std::chrono::steady_clock::now() - last_sync_ >= options_.sync_interval) {
+        sync();
+    }
+    return true;
+}
+
+void TelemetryJournal::sync() {
+    if (unsynced_records_ > 0 && write_fd_ >= 0) {
+        if (::fdatasync(write_fd_) != 0) {
+            LOG_WARN("Failed to sync telemetry journal: " << std::strerror(errno));
+        }
+        unsynced_records_ = 0;
+    }
+    if (cursor_dirty_) {
+        saveCursor();
+    }
+    last_sync_ = std::chrono::steady_clock::now();
+}
+
+size_t TelemetryJournal::peek(size_t max_records, size_t max_bytes, std::vector<JournalRecord>& records) {
+    records.clear();
+    size_t payload_bytes = 0;
+
+    for (size_t s = 0; s < segments_.size() && records.size() < max_records; ++s) {
+        const Segment& segment = segments_[s];
+        size_t offset = (s == 0) ? read_offset_ : 0;
+        size_t remaining = segment.records - ((s == 0) ? read_records_ : 0);
+        if (remaining == 0) {
+            continue;
+        }
+
+        int fd = ::open(segment.path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            LOG_ERROR("Cannot read telemetry journal " << segment.path << ": " << std::strerror(errno));
+            break;
+        }
+
+        bool stop = false;
+        for (; remaining > 0 && records.size() < max_records; --remaining) {
+            unsigned char header[RECORD_HEADER_BYTES];
+            std::uint32_t length = 0;
+            std::uint32_t checksum = 0;
+            JournalRecord record;
+            if (!preadAll(fd, header, RECORD_HEADER_BYTES, offset)) {
+                stop = true;
+                break;
+            }
+            decodeHeader(header, length, checksum, record.timestamp_ms);
+
+            if (!records.empty() && payload_bytes + length > max_bytes) {
+                stop = true;
+                break;
+            }
+
+            record.payload.resize(length);
+            if (!preadAll(fd, &record.payload[0], length, offset + RECORD_HEADER_BYTES)) {
+                stop = true;
+                break;
+            }
+            offset += RECORD_HEADER_BYTES + length;
+            payload_bytes += length;
+            records.push_back(std::move(record));
+        }
+        ::close(fd);
+
+        if (stop) {
+            break;
+        }
+    }
+
+    return records.size();
+}
+
+void TelemetryJournal::consume(size_t count) {
+    while (count > 0 && !segments_.empty()) {
+        Segment& front = segments_.front();
+        if (read_records_ >= front.records) {
+            if (segments_.size() == 1) {
+                break;
+            }
+            releaseReplayedSegments();
+            continue;
+        }
+
+        int fd = ::open(front.path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            LOG_ERROR("Cannot read telemetry journal " << front.path << ": " << std::strerror(errno));
+            return;
+        }
+        for (; count > 0 && read_records_ < front.records; --count) {
+            unsigned char header[RECORD_HEADER_BYTES];
+            std::uint32_t length = 0;
+            std::uint32_t checksum = 0;
+            std::int64_t timestamp_ms = 0;
+            if (!preadAll(fd, header, RECORD_HEADER_BYTES, read_offset_)) {
+                LOG_ERROR("Failed to read telemetry journal " << front.path);
+                ::close(fd);
+                return;
+            }
+            decodeHeader(header, length, checksum, timestamp_ms);
+            read_offset_ += RECORD_HEADER_BYTES + length;
+            read_records_++;
+        }
+        ::close(fd);
+        cursor_dirty_ = true;
+
+        releaseReplayedSegments();
+    }
+}
+
+size_t TelemetryJournal::pendingRecords() const {
+    size_t total = 0;
+    for (const auto& segment : segments_) {
+        total += segment.records;
+    }
+    return total - read_records_;
+}
+
+void TelemetryJournal::recover() {
+    std::vector<std::uint64_t> sequences;
+    const std::string prefix = SEGMENT_PREFIX;
+    const std::string suffix = SEGMENT_SUFFIX;
+    for (const auto& entry : std::filesystem::directory_iterator(options_.directory)) {
+        std::string name = entry.path().filename().string();
+        if (name.size() <= prefix.size() + suffix.size() || name.compare(0, prefix.size(), prefix) != 0 ||
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+            continue;
+        }
+        try {
+            sequences.push_back(std::stoull(name.substr(prefix.size(), name.size() - prefix.size() - suffix.size())));
+        } catch (const std::exception&) {
+            LOG_WARN("Ignoring unexpected file in telemetry journal: " << name);
+        }
+    }
+    std::sort(sequences.begin(), sequences.end());
+
+    for (std::uint64_t sequence : sequences) {
+        Segment segment;
+        segment.sequence = sequence;
+        segment.path = segmentPath(sequence);
+        scanSegment(segment);
+        disk_bytes_ += segment.bytes;
+        segments_.push_back(segment);
+    }
+
+    loadCursor();
+}
+
+void TelemetryJournal::scanSegment(Segment& segment) {
+    utils::MappedFile file;
+    if (!file.open(segment.path)) {
+        LOG_WARN("Cannot map telemetry journal segment " << segment.path);
+        return;
+    }
+
+    size_t offset = 0;
+    while (offset + RECORD_HEADER_BYTES <= file.size()) {
+        std::uint32_t length = 0;
+        std::uint32_t checksum = 0;
+        std::int64_t timestamp_ms = 0;
+        decodeHeader(file.data() + offset, length, checksum, timestamp_ms);
+        if (offset + RECORD_HEADER_BYTES + length > file.size() ||
+            recordChecksum(timestamp_ms, reinterpret_cast<const char*>(file.data() + offset + RECORD_HEADER_BYTES),
+                           length) != checksum) {
+            break;
+        }
+        offset += RECORD_HEADER_BYTES + length;
+        segment.records++;
+    }
+    segment.bytes = offset;
+
+    if (offset < file.size()) {
+        LOG_WARN("Truncating torn tail of telemetry journal segment " << segment.path << " at byte " << offset);
+        file.close();
+        if (::truncate(segment.path.c_str(), static_cast<off_t>(offset)) != 0) {
+            LOG_ERROR("Failed to truncate " << segment.path << ": " << std::strerror(errno));
+        }
+    }
+}
+
+void TelemetryJournal::loadCursor() {
+    std::ifstream cursor_file(cursorPath());
+    std::uint64_t sequence = 0;
+    size_t offset = 0;
+    size_t records = 0;
+    if (!(cursor_file >> sequence >> offset >> records)) {
+        return;
+    }
+
+    // Segments before the cursor were fully replayed before the restart
+    while (!segments_.empty() && segments_.front().sequence < sequence) {
+        std::filesystem::remove(segments_.front().path);
+        disk_bytes_ -= segments_.front().bytes;
+        segments_.pop_front();
+    }
+
+    if (!segments_.empty() && segments_.front().sequence == sequence &&
+        offset <= segments_.front().bytes && records <= segments_.front().records) {
+        read_offset_ = offset;
+        read_records_ = records;
+    }
+}
+
+void TelemetryJournal::saveCursor() {
+    std::uint64_t sequence = segments_.empty() ? 0 : segments_.front().sequence;
+    std::string content = std::to_string(sequence) + " " + std::to_string(read_offset_) + " " +
+                          std::to_string(read_records_) + "\n";
+    if (utils::FileUtils::atomicFileUpdate(cursorPath(), content)) {
+        cursor_dirty_ = false;
+    } else {
+        LOG_WARN("Failed to save telemetry journal cursor");
+    }
+}
+
+bool TelemetryJournal::openNewSegment() {
+    if (write_fd_ >= 0) {
+        if (unsynced_records_ > 0) {
+            ::fdatasync(write_fd_);
+            unsynced_records_ = 0;
+        }
+        ::close(write_fd_);
+        write_fd_ = -1;
+    }
+
+    Segment segment;
+    segment.sequence = segments_.empty() ? 1 : segments_.back().sequence + 1;
+    segment.path = segmentPath(segment.sequence);
+
+    write_fd_ = ::open(segment.path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (write_fd_ < 0) {
+        LOG_ERROR("Cannot create telemetry journal segment " << segment.path << ": " << std::strerror(errno));
+        return false;
+    }
+
+    segments_.push_back(segment);
+    return true;
+}
+
+void TelemetryJournal::dropOldestSegment() {
+    const Segment& front = segments_.front();
+    size_t lost = front.records - read_records_;
+    dropped_records_ += lost;
+    LOG_WARN("Telemetry journal over " << options_.max_bytes << " bytes, dropping " << lost
+            << " oldest records");
+
+    std::filesystem::remove(front.path);
+    disk_bytes_ -= front.bytes;
+    segments_.pop_front();
+    read_offset_ = 0;
+    read_records_ = 0;
+    cursor_dirty_ = true;
+}
+
+void TelemetryJournal::releaseReplayedSegments() {
+    // The segment being written stays even when fully replayed
+    while (segments_.size() > 1 && read_records_ >= segments_.front().records) {
+        std::filesystem::remove(segments_.front().path);
+        disk_bytes_ -= segments_.front().bytes;
+        segments_.pop_front();
+        read_offset_ = 0;
+        read_records_ = 0;
+        cursor_dirty_ = true;
+    }
+}
+
+std::string TelemetryJournal::segmentPath(std::uint64_t sequence) const {
+    char name[48];
+    std::snprintf(name, sizeof(name), "%s%020llu%s", SEGMENT_PREFIX,
+                  static_cast<unsigned long long>(sequence), SEGMENT_SUFFIX);
+    return (std::filesystem::path(options_.directory) / name).string();
+}
+
+std::string TelemetryJournal::cursorPath() const {
+    return (std::filesystem::path(options_.directory) / "cursor").string();
+}
+
+} // namespace thermal
@@ -0,0 +1,142 @@
+#include "thingsboard/telemetry_publisher.h"
+#include "common/logger.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <utility>
+
+namespace thermal {
+
+std::string overflowPolicyToString(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::DROP_OLDEST: return "drop_oldest";
+        case OverflowPolicy::DROP_NEWEST: return "drop_newest";
+        case OverflowPolicy::BLOCK: return "block";
+    }
+    return "drop_oldest";
+}
+
+OverflowPolicy overflowPolicyFromString(const std::string& policy) {
+    if (policy == "drop_oldest") return OverflowPolicy::DROP_OLDEST;
+    if (policy == "drop_newest") return OverflowPolicy::DROP_NEWEST;
+    if (policy == "block") return OverflowPolicy::BLOCK;
+    throw std::invalid_argument("Unknown publish overflow policy: " + policy);
+}
+
+TelemetryPublisher::TelemetryPublisher(size_t capacity, OverflowPolicy policy, PublishFunction publish)
+    : queue_(capacity)
+    , policy_(policy)
+    , publish_(std::move(publish))
+    , queue_depth_(MetricsRegistry::instance().gauge("telemetry_publish_queue_depth",
+                                                     "Encoded telemetry messages waiting to be published")) {
+    if (!publish_) {
+        throw std::invalid_argument("Publisher needs a publish function");
+    }
+    thread_ = std::thread(&TelemetryPublisher::run, this);
+}
+
+TelemetryPublisher::~TelemetryPublisher() {
+    stop();
+}
+
+bool TelemetryPublisher::enqueue(std::string payload, std::int64_t timestamp_ms) {
+    Message message{std::move(payload), timestamp_ms};
+
+    while (!queue_.tryPush(message)) {
+        if (policy_ == OverflowPolicy::DROP_NEWEST) {
+            dropped_newest_++;
+            return false;
+        }
+
+        if (policy_ == OverflowPolicy::DROP_OLDEST) {
+            Message oldest;
+            if (queue_.tryPop(oldest)) {
+                dropped_oldest_++;
+            }
+            continue;
+        }
+
+        // BLOCK: wait until the publisher thread frees a slot
+        if (!running_) {
+            dropped_newest_++;
+            return false;
+        }
+        blocked_producers_++;
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            space_ready_.wait_for(lock, std::chrono::milliseconds(10));
+        }
+        blocked_producers_--;
+    }
+
+    enqueued_++;
+    queue_depth_.set(static_cast<std::int64_t>(queue_.size()));
+
+    // Only pay for the lock when the publisher thread may be asleep
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (publisher_idle_) {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        data_ready_.notify_one();
+    }
+    return true;
+}
+
+void TelemetryPublisher::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        running_ = false;
+    }
+    data_ready_.notify_one();
+    space_ready_.notify_all();
+    thread_.join();
+}
+
+PublisherStats TelemetryPublisher::getStats() const {
+    PublisherStats stats;
+    stats.depth = queue_.size();
+    stats.enqueued = enqueued_;
+    stats.published = published_;
+    stats.failed = failed_;
+    stats.dropped_oldest = dropped_oldest_;
+    stats.dropped_newest = dropped_newest_;
+    return stats;
+}
+
+void TelemetryPublisher::run() {
+    Message message;
+    for (;;) {
+        if (queue_.tryPop(message)) {
+            queue_depth_.set(static_cast<std::int64_t>(queue_.size()));
+            if (blocked_producers_ > 0) {
+                space_ready_.notify_all();
+            }
+            try {
+                if (publish_(message.payload, message.timestamp_ms)) {
+                    published_++;
+                } else {
+                    failed_++;
+                }
+            } catch (const std::exception& e) {
+                failed_++;
+                LOG_ERROR("Telemetry publish threw: " << e.what());
+            }
+            continue;
+        }
+
+        // Queue drained; exit only once asked to and nothing is left
+        if (!running_) {
+            break;
+        }
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        publisher_idle_ = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        data_ready_.wait_for(lock, std::chrono::milliseconds(100),
+                             [this] { return !running_ || !queue_.empty(); });
+        publisher_idle_ = false;
+    }
+}
+
+} // namespace thermal
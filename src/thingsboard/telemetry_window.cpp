@@ -0,0 +1,62 @@
+#include "thingsboard/telemetry_window.h"
+#include <utility>
+
+namespace thermal {
+
+TelemetryWindow::TelemetryWindow(std::chrono::milliseconds window, size_t max_payload_bytes)
+    : window_(window), max_payload_bytes_(max_payload_bytes) {
+}
+
+void TelemetryWindow::configure(std::chrono::milliseconds window, size_t max_payload_bytes) {
+    window_ = window;
+    max_payload_bytes_ = max_payload_bytes;
+}
+
+bool TelemetryWindow::add(const std::string& entry, Clock::time_point now) {
+    if (entry_count_ == 0) {
+        window_start_ = now;
+    }
+
+    // "," + entry + "]" must still fit, otherwise this array is done
+    if (!open_.empty() && open_.size() + entry.size() + 2 > max_payload_bytes_) {
+        closeOpenPayload();
+    }
+
+    if (open_.empty()) {
+        open_.reserve(max_payload_bytes_);
+        open_ += '[';
+    } else {
+        open_ += ',';
+    }
+    open_ += entry;
+    ++entry_count_;
+
+    return due(now);
+}
+
+bool TelemetryWindow::due(Clock::time_point now) const {
+    if (entry_count_ == 0) {
+        return false;
+    }
+    return !closed_.empty() || now - window_start_ >= window_;
+}
+
+std::vector<std::string> TelemetryWindow::takePayloads() {
+    closeOpenPayload();
+
+    std::vector<std::string> payloads;
+    payloads.swap(closed_);
+    entry_count_ = 0;
+    return payloads;
+}
+
+void TelemetryWindow::closeOpenPayload() {
+    if (open_.empty()) {
+        return;
+    }
+    open_ += ']';
+    closed_.push_back(std::move(open_));
+    open_.clear();
+}
+
+} // namespace thermal
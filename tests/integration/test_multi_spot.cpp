@@ -2,6 +2,7 @@
 #include "config/configuration.h"
 #include "thingsboard/device.h"
 #include "thermal/measurement_spot.h"
+#include "thermal/measurement_area.h"
 #include "common/logger.h"
 #include <nlohmann/json.hpp>
 #include <chrono>
@@ -223,34 +224,86 @@ TEST_F(MultiSpotIntegrationTest, DuplicateSpotIdValidationFails) {
     EXPECT_THROW(config_.validate(), std::invalid_argument);
 }
 
+// Test temperature source selection, including file replay
+TEST_F(MultiSpotIntegrationTest, TemperatureSourceConfiguration) {
+    nlohmann::json config_json = config_.to_json();
+    config_json["temperature_source"] = {
+        {"type", "file_replay"}, {"replay_file", "/data/frames.raw"}, {"replay_fps", 9.0}, {"replay_loop", false}};
+    
+    thermal::Configuration replay_config;
+    replay_config.from_json(config_json);
+    EXPECT_EQ(replay_config.source_config.type, "file_replay");
+    EXPECT_EQ(replay_config.source_config.replay_file, "/data/frames.raw");
+    EXPECT_DOUBLE_EQ(replay_config.source_config.replay_fps, 9.0);
+    EXPECT_FALSE(replay_config.source_config.replay_loop);
+    
+    // Replay needs a recording; unknown types are rejected
+    config_.source_config.type = "file_replay";
+    EXPECT_THROW(config_.validate(), std::invalid_argument);
+    config_.source_config.replay_file = "/data/frames.raw";
+    EXPECT_TRUE(config_.validate());
+    config_.source_config.replay_fps = -1.0;
+    EXPECT_THROW(config_.validate(), std::invalid_argument);
+    config_.source_config.type = "camera";
+    EXPECT_THROW(config_.validate(), std::invalid_argument);
+}
+
+// Test measurement areas in the telemetry section
+TEST_F(MultiSpotIntegrationTest, MeasurementAreaConfiguration) {
+    nlohmann::json config_json = config_.to_json();
+    config_json["telemetry"]["measurement_areas"] = {
+        {{"id", 1}, {"name", "Motor"}, {"shape", "box"}, {"x", 10}, {"y", 20}, {"width", 30}, {"height", 40}},
+        {{"id", 2}, {"name", "Bearing"}, {"shape", "polygon"},
+         {"vertices", {{{"x", 1}, {"y", 1}}, {{"x", 9}, {"y", 1}}, {{"x", 5}, {"y", 8}}}}}};
+    
+    thermal::Configuration area_config;
+    area_config.from_json(config_json);
+    const auto& areas = area_config.telemetry_config.measurement_areas;
+    ASSERT_EQ(areas.size(), 2u);
+    EXPECT_EQ(areas[0].width, 30);
+    EXPECT_EQ(areas[1].shape, thermal::AreaShape::POLYGON);
+    
+    thermal::Configuration reloaded;
+    reloaded.from_json(area_config.to_json());
+    ASSERT_EQ(reloaded.telemetry_config.measurement_areas.size(), 2u);
+    EXPECT_EQ(reloaded.telemetry_config.measurement_areas[1].vertices.size(), 3u);
+    
+    // Duplicate IDs and invalid areas are rejected
+    area_config.telemetry_config.measurement_areas[1].id = 1;
+    EXPECT_THROW(area_config.validate(), std::invalid_argument);
+    area_config.telemetry_config.measurement_areas[1].id = static_cast<int>(thermal::MAX_MEASUREMENT_AREAS) + 1;
+    EXPECT_THROW(area_config.validate(), std::invalid_argument);
+    area_config.telemetry_config.measurement_areas[1].id = 2;
+    area_config.telemetry_config.measurement_areas[0].width = 0;
+    EXPECT_THROW(area_config.validate(), std::invalid_argument);
+}
+
 // Test maximum spots limit
 TEST_F(MultiSpotIntegrationTest, MaximumSpotsLimit) {
-    // Add one more spot to exceed the 5-spot limit
-    thermal::MeasurementSpot extra_spot;
-    extra_spot.id = 5;
-    extra_spot.name = "Extra Spot";
-    extra_spot.x = 400;
-    extra_spot.y = 300;
-    extra_spot.min_temp = 30.0;
-    extra_spot.max_temp = 90.0;
-    extra_spot.noise_factor = 0.1;
-    extra_spot.enabled = true;
-    
-    config_.telemetry_config.measurement_spots.push_back(extra_spot);
-    
-    thermal::MeasurementSpot sixth_spot;
-    sixth_spot.id = 6;
-    sixth_spot.name = "Sixth Spot";
-    sixth_spot.x = 500;
-    sixth_spot.y = 400;
-    sixth_spot.min_temp = 40.0;
-    sixth_spot.max_temp = 100.0;
-    sixth_spot.noise_factor = 0.1;
-    sixth_spot.enabled = true;
-    
-    config_.telemetry_config.measurement_spots.push_back(sixth_spot);
-    
-    // Should fail validation with 6 spots
+    // Fill up to the MAX_MEASUREMENT_SPOTS limit
+    auto& spots = config_.telemetry_config.measurement_spots;
+    for (int id = static_cast<int>(spots.size()) + 1;
+         static_cast<size_t>(id) <= thermal::MAX_MEASUREMENT_SPOTS; ++id) {
+        thermal::MeasurementSpot extra_spot;
+        extra_spot.id = id;
+        extra_spot.name = "Extra Spot " + std::to_string(id);
+        extra_spot.x = id % 320;
+        extra_spot.y = id / 320;
+        extra_spot.min_temp = 30.0;
+        extra_spot.max_temp = 90.0;
+        extra_spot.noise_factor = 0.1;
+        extra_spot.enabled = true;
+        spots.push_back(extra_spot);
+    }
+    ASSERT_EQ(spots.size(), thermal::MAX_MEASUREMENT_SPOTS);
+    EXPECT_NO_THROW(config_.validate());
+    
+    // One more spot exceeds the limit
+    thermal::MeasurementSpot overflow_spot = spots.back();
+    overflow_spot.id = static_cast<int>(thermal::MAX_MEASUREMENT_SPOTS) + 1;
+    overflow_spot.name = "Overflow Spot";
+    spots.push_back(overflow_spot);
+    
     EXPECT_THROW(config_.validate(), std::invalid_argument);
 }
 
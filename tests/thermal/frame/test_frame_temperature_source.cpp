@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "thermal/temperature_source/frame_temperature_source.h"
+#include "thermal/spot_manager/thermal_spot_manager.h"
+#include <filesystem>
+
+namespace thermal {
+namespace test {
+
+TEST(FrameTemperatureSourceTest, CaptureAdvancesSequence) {
+    FrameTemperatureSource source;
+    EXPECT_EQ(source.getCurrentFrame(), nullptr);
+    
+    ASSERT_TRUE(source.captureFrame());
+    const ThermalFrame* frame = source.getCurrentFrame();
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(frame->sequence, 1u);
+    EXPECT_EQ(frame->width, 320);
+    EXPECT_EQ(frame->height, 240);
+    
+    ASSERT_TRUE(source.captureFrame());
+    EXPECT_EQ(source.getCurrentFrame()->sequence, 2u);
+}
+
+TEST(FrameTemperatureSourceTest, ReadsComeFromCurrentFrame) {
+    FrameTemperatureSource source;
+    ASSERT_TRUE(source.captureFrame());
+    const ThermalFrame* frame = source.getCurrentFrame();
+    
+    // Repeated reads within one cycle are identical
+    EXPECT_FLOAT_EQ(source.getTemperature(10, 20), frame->at(10, 20));
+    EXPECT_FLOAT_EQ(source.getTemperature(10, 20), source.getTemperature(10, 20));
+}
+
+TEST(FrameTemperatureSourceTest, FrameFollowsDistanceModel) {
+    FrameTemperatureSource source;
+    ASSERT_TRUE(source.captureFrame());
+    const ThermalFrame* frame = source.getCurrentFrame();
+    
+    for (int y = 0; y < frame->height; y += 7) {
+        for (int x = 0; x < frame->width; x += 11) {
+            float base = source.getBaseTemperature(x, y);
+            EXPECT_NEAR(frame->at(x, y), base, 0.5f);
+        }
+    }
+    EXPECT_NEAR(source.getBaseTemperature(160, 120), 20.0f, 0.01f);
+    EXPECT_NEAR(source.getBaseTemperature(0, 0), 50.0f, 0.1f);
+}
+
+TEST(FrameTemperatureSourceTest, InvalidCoordinates) {
+    FrameTemperatureSource source;
+    EXPECT_FALSE(source.validateCoordinates(-1, 0));
+    EXPECT_FALSE(source.validateCoordinates(320, 0));
+    EXPECT_FALSE(source.validateCoordinates(0, 240));
+    EXPECT_TRUE(source.validateCoordinates(319, 239));
+}
+
+TEST(FrameTemperatureSourceTest, SpotManagerSamplesOneFrame) {
+    const std::string path = "/tmp/test_frame_source_spots.json";
+    std::filesystem::remove(path);
+    {
+        auto source = std::make_unique<FrameTemperatureSource>();
+        auto* raw_source = source.get();
+        ThermalSpotManager manager(std::move(source), path);
+        ASSERT_TRUE(manager.createSpot("1", 10, 10));
+        ASSERT_TRUE(manager.createSpot("2", 160, 120));
+        
+        auto readings = manager.sampleSpots();
+        ASSERT_EQ(readings.size(), 2u);
+        
+        const ThermalFrame* frame = raw_source->getCurrentFrame();
+        ASSERT_NE(frame, nullptr);
+        EXPECT_EQ(readings[0].timestamp, frame->captured_at);
+        EXPECT_EQ(readings[1].timestamp, frame->captured_at);
+        EXPECT_FLOAT_EQ(static_cast<float>(readings[0].temperature), frame->at(10, 10));
+        EXPECT_FLOAT_EQ(static_cast<float>(readings[1].temperature), frame->at(160, 120));
+    }
+    std::filesystem::remove(path);
+}
+
+} // namespace test
+} // namespace thermal
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "thermal/frame/hotspot_finder.h"
+#include "thermal/spot_manager/thermal_spot_manager.h"
+#include "thermal/temperature_source/coordinate_based_source.h"
+#include "thermal/temperature_source/frame_temperature_source.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace thermal {
+namespace test {
+
+TEST(HotspotFinderTest, FindsExtremesAndLocations) {
+    // Odd width exercises the scalar tail of the SIMD row scan
+    ThermalFrame frame(37, 11);
+    std::fill(frame.pixels.begin(), frame.pixels.end(), 25.0f);
+    frame.at(36, 4) = 180.5f;
+    frame.at(2, 9) = -12.0f;
+    frame.sequence = 7;
+
+    FrameExtremes extremes = HotspotFinder::find(frame);
+    ASSERT_TRUE(extremes.valid);
+    EXPECT_EQ(extremes.sequence, 7u);
+    EXPECT_FLOAT_EQ(extremes.max_temp, 180.5f);
+    EXPECT_EQ(extremes.max_location.x, 36);
+    EXPECT_EQ(extremes.max_location.y, 4);
+    EXPECT_FLOAT_EQ(extremes.min_temp, -12.0f);
+    EXPECT_EQ(extremes.min_location.x, 2);
+    EXPECT_EQ(extremes.min_location.y, 9);
+}
+
+TEST(HotspotFinderTest, MatchesScalarReductionOnSimulatedFrame) {
+    FrameTemperatureSource source;
+    ASSERT_TRUE(source.captureFrame());
+    const ThermalFrame& frame = *source.getCurrentFrame();
+
+    FrameExtremes extremes = HotspotFinder::find(frame);
+    auto [lo, hi] = std::minmax_element(frame.pixels.begin(), frame.pixels.end());
+    EXPECT_FLOAT_EQ(extremes.max_temp, *hi);
+    EXPECT_FLOAT_EQ(extremes.min_temp, *lo);
+    EXPECT_FLOAT_EQ(frame.at(extremes.max_location.x, extremes.max_location.y), *hi);
+    EXPECT_FLOAT_EQ(frame.at(extremes.min_location.x, extremes.min_location.y), *lo);
+}
+
+TEST(HotspotFinderTest, EmptyFrameIsInvalid) {
+    EXPECT_FALSE(HotspotFinder::find(ThermalFrame()).valid);
+}
+
+TEST(HotspotFinderTest, SpotManagerTracksExtremesPerCapture) {
+    const std::string path = "/tmp/test_hotspot_spots.json";
+    std::filesystem::remove(path);
+    {
+        ThermalSpotManager frame_manager(std::make_unique<FrameTemperatureSource>(), path);
+        frame_manager.sampleSpots();
+        EXPECT_TRUE(frame_manager.getFrameExtremes().valid);
+        EXPECT_EQ(frame_manager.getFrameExtremes().sequence, 1u);
+        frame_manager.sampleSpots();
+        EXPECT_EQ(frame_manager.getFrameExtremes().sequence, 2u);
+
+        ThermalSpotManager pixel_manager(std::make_unique<CoordinateBasedTemperatureSource>(), path);
+        pixel_manager.sampleSpots();
+        EXPECT_FALSE(pixel_manager.getFrameExtremes().valid);
+    }
+    std::filesystem::remove(path);
+}
+
+} // namespace test
+} // namespace thermal
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include "thermal/frame/radiometric_converter.h"
+#include "thermal/spot_manager/spot_store.h"
+#include <cmath>
+#include <vector>
+
+namespace thermal {
+namespace test {
+
+TEST(RadiometricConverterTest, LinearCalibration) {
+    RadiometricConverter converter;
+    EXPECT_NEAR(converter.toCelsius(27315), 0.0f, 1e-3);
+    EXPECT_NEAR(converter.toCelsius(30000), 26.85f, 1e-3);
+
+    std::vector<std::uint16_t> counts = {27315, 29315, 37315};
+    std::vector<float> celsius(counts.size());
+    converter.convert(counts.data(), counts.size(), celsius.data());
+    EXPECT_NEAR(celsius[1], 20.0f, 1e-3);
+    EXPECT_NEAR(celsius[2], 100.0f, 1e-3);
+}
+
+TEST(RadiometricConverterTest, PlanckCalibrationMatchesFormula) {
+    RadiometricCalibration calibration;
+    calibration.planck_r = 16556.0;
+    calibration.planck_b = 1428.0;
+    calibration.planck_f = 1.0;
+    calibration.planck_o = -342.0;
+    RadiometricConverter converter(calibration);
+
+    for (std::uint16_t count : {1000, 8000, 15000, 40000}) {
+        double kelvin = calibration.planck_b /
+                        std::log(calibration.planck_r / (count - calibration.planck_o) + calibration.planck_f);
+        EXPECT_NEAR(converter.toCelsius(count), kelvin - 273.15, 1e-3);
+    }
+}
+
+TEST(RadiometricConverterTest, CompensationInvertsEmissivityModel) {
+    const double emissivity = 0.8;
+    const double reflected = 30.0;
+    const double object = 85.0;
+
+    // Measured apparent temperature for the linearized model
+    const double measured = emissivity * (object + 273.15) + (1.0 - emissivity) * (reflected + 273.15) - 273.15;
+
+    float gain = 0.0f;
+    float offset = 0.0f;
+    RadiometricConverter::compensationCoefficients(emissivity, reflected, gain, offset);
+    EXPECT_NEAR(gain * measured + offset, object, 1e-3);
+
+    RadiometricConverter::compensationCoefficients(1.0, reflected, gain, offset);
+    EXPECT_FLOAT_EQ(gain, 1.0f);
+    EXPECT_FLOAT_EQ(offset, 0.0f);
+}
+
+TEST(RadiometricConverterTest, ApplyCompensationHandlesTail) {
+    std::vector<float> in = {1, 2, 3, 4, 5, 6, 7};
+    std::vector<float> gain = {1, 2, 1, 2, 1, 2, 1};
+    std::vector<float> offset = {0, 0, 1, 1, 0, 0, -1};
+    RadiometricConverter::applyCompensation(in.data(), gain.data(), offset.data(), in.size(), in.data());
+    EXPECT_EQ(in, (std::vector<float>{1, 4, 4, 9, 5, 12, 6}));
+}
+
+TEST(RadiometricConverterTest, SpotStoreKeepsCompensationColumns) {
+    SpotStore store(4);
+    MeasurementSpot spot;
+    spot.id = 2;
+    spot.name = "panel";
+    spot.emissivity = 0.5;
+    spot.reflected_temp = 20.0;
+    ASSERT_TRUE(store.insert(spot));
+
+    int slot = store.slotOf(2);
+    EXPECT_FLOAT_EQ(store.compensationGains()[slot], 2.0f);
+    EXPECT_NEAR(store.compensationOffsets()[slot], -20.0f, 1e-3);  // (273.15 - 0.5 * 293.15) / 0.5 - 273.15
+    EXPECT_DOUBLE_EQ(store.toSpot(slot).emissivity, 0.5);
+}
+
+} // namespace test
+} // namespace thermal
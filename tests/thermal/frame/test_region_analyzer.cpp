@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "thermal/frame/region_analyzer.h"
+#include "thermal/measurement_area.h"
+#include "thermal/spot_manager/thermal_spot_manager.h"
+#include "thermal/temperature_source/coordinate_based_source.h"
+#include "thermal/temperature_source/frame_temperature_source.h"
+#include <filesystem>
+
+namespace thermal {
+namespace test {
+
+namespace {
+
+// Frame where every pixel encodes its position: t = x + 1000 * y
+ThermalFrame makeGradientFrame(int width, int height) {
+    ThermalFrame frame(width, height);
+    frame.sequence = 1;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            frame.at(x, y) = static_cast<float>(x + 1000 * y) / 1000.0f;
+        }
+    }
+    return frame;
+}
+
+double bruteForceMean(const ThermalFrame& frame, int x, int y, int w, int h) {
+    double sum = 0.0;
+    for (int row = y; row < y + h; ++row) {
+        for (int col = x; col < x + w; ++col) {
+            sum += frame.at(col, row);
+        }
+    }
+    return sum / (w * h);
+}
+
+} // namespace
+
+TEST(IntegralImageTest, RectangleSumsMatchBruteForce) {
+    ThermalFrame frame = makeGradientFrame(37, 23);
+    IntegralImage integral;
+    integral.build(frame);
+
+    EXPECT_EQ(integral.sequence(), 1u);
+    EXPECT_NEAR(integral.sum(0, 0, 37, 23) / (37 * 23), bruteForceMean(frame, 0, 0, 37, 23), 1e-9);
+    EXPECT_NEAR(integral.sum(5, 3, 11, 7) / (11 * 7), bruteForceMean(frame, 5, 3, 11, 7), 1e-9);
+    EXPECT_NEAR(integral.sum(36, 22, 1, 1), frame.at(36, 22), 1e-9);
+}
+
+TEST(RegionAnalyzerTest, BoxStatistics) {
+    ThermalFrame frame = makeGradientFrame(40, 30);
+    frame.at(12, 8) = 99.0f;
+    RegionAnalyzer analyzer;
+    analyzer.update(frame);
+
+    AreaStatistics stats = analyzer.measureBox(10, 5, 9, 6);
+    ASSERT_TRUE(stats.valid);
+    EXPECT_EQ(stats.pixel_count, 54u);
+    EXPECT_FLOAT_EQ(stats.min_temp, frame.at(10, 5));
+    EXPECT_FLOAT_EQ(stats.max_temp, 99.0f);
+    EXPECT_EQ(stats.hottest.x, 12);
+    EXPECT_EQ(stats.hottest.y, 8);
+    EXPECT_NEAR(stats.mean_temp, bruteForceMean(frame, 10, 5, 9, 6), 1e-6);
+}
+
+TEST(RegionAnalyzerTest, BoxIsClippedToFrame) {
+    ThermalFrame frame = makeGradientFrame(20, 10);
+    RegionAnalyzer analyzer;
+    analyzer.update(frame);
+
+    AreaStatistics stats = analyzer.measureBox(15, 8, 10, 10);
+    ASSERT_TRUE(stats.valid);
+    EXPECT_EQ(stats.pixel_count, 10u);
+    EXPECT_EQ(stats.hottest.x, 19);
+    EXPECT_EQ(stats.hottest.y, 9);
+
+    EXPECT_FALSE(analyzer.measureBox(25, 0, 5, 5).valid);
+}
+
+TEST(RegionAnalyzerTest, PolygonTracingBoxMatchesBox) {
+    ThermalFrame frame = makeGradientFrame(32, 24);
+    RegionAnalyzer analyzer;
+    analyzer.update(frame);
+
+    MeasurementArea area;
+    area.shape = AreaShape::POLYGON;
+    area.vertices = {{4, 3}, {14, 3}, {14, 9}, {4, 9}};
+
+    AreaStatistics polygon = analyzer.measure(area);
+    AreaStatistics box = analyzer.measureBox(4, 3, 10, 6);
+    ASSERT_TRUE(polygon.valid);
+    EXPECT_EQ(polygon.pixel_count, box.pixel_count);
+    EXPECT_FLOAT_EQ(polygon.min_temp, box.min_temp);
+    EXPECT_FLOAT_EQ(polygon.max_temp, box.max_temp);
+    EXPECT_NEAR(polygon.mean_temp, box.mean_temp, 1e-9);
+}
+
+TEST(RegionAnalyzerTest, TrianglePolygon) {
+    ThermalFrame frame = makeGradientFrame(16, 16);
+    RegionAnalyzer analyzer;
+    analyzer.update(frame);
+
+    // Centers on the hypotenuse are outside, so rows cover 7 + 6 + ... + 1 pixels
+    AreaStatistics stats = analyzer.measurePolygon({{0, 0}, {8, 0}, {0, 8}});
+    ASSERT_TRUE(stats.valid);
+    EXPECT_EQ(stats.pixel_count, 28u);
+    EXPECT_FLOAT_EQ(stats.min_temp, frame.at(0, 0));
+    EXPECT_EQ(stats.hottest.x, 0);
+    EXPECT_EQ(stats.hottest.y, 6);
+}
+
+TEST(MeasurementAreaTest, JsonRoundTrip) {
+    MeasurementArea area;
+    area.id = 3;
+    area.name = "bearing";
+    area.shape = AreaShape::POLYGON;
+    area.vertices = {{1, 2}, {10, 2}, {5, 9}};
+
+    MeasurementArea loaded;
+    loaded.from_json(area.to_json());
+    EXPECT_TRUE(loaded.validate());
+    EXPECT_EQ(loaded.shape, AreaShape::POLYGON);
+    ASSERT_EQ(loaded.vertices.size(), 3u);
+    EXPECT_EQ(loaded.vertices[2].y, 9);
+
+    loaded.vertices.pop_back();
+    EXPECT_THROW(loaded.validate(), std::invalid_argument);
+}
+
+TEST(RegionAnalyzerTest, SpotManagerMeasuresAreasPerCapture) {
+    const std::string path = "/tmp/test_region_areas_spots.json";
+    std::filesystem::remove(path);
+    {
+        MeasurementArea whole_frame;
+        whole_frame.id = 1;
+        whole_frame.name = "frame";
+        whole_frame.width = ThermalFrame::DEFAULT_WIDTH;
+        whole_frame.height = ThermalFrame::DEFAULT_HEIGHT;
+        MeasurementArea disabled = whole_frame;
+        disabled.id = 2;
+        disabled.enabled = false;
+
+        ThermalSpotManager frame_manager(std::make_unique<FrameTemperatureSource>(), path);
+        frame_manager.sampleSpots();
+        EXPECT_TRUE(frame_manager.getAreaReadings().empty());
+
+        frame_manager.setAreas({whole_frame, disabled});
+        frame_manager.sampleSpots();
+        const auto& readings = frame_manager.getAreaReadings();
+        ASSERT_EQ(readings.size(), 1u);
+        EXPECT_EQ(readings[0].area_id, 1);
+        const AreaStatistics& stats = readings[0].statistics;
+        ASSERT_TRUE(stats.valid);
+        EXPECT_EQ(stats.pixel_count, static_cast<size_t>(ThermalFrame::DEFAULT_WIDTH * ThermalFrame::DEFAULT_HEIGHT));
+        EXPECT_FLOAT_EQ(stats.max_temp, frame_manager.getFrameExtremes().max_temp);
+        EXPECT_FLOAT_EQ(stats.min_temp, frame_manager.getFrameExtremes().min_temp);
+        EXPECT_GE(stats.mean_temp, stats.min_temp);
+        EXPECT_LE(stats.mean_temp, stats.max_temp);
+
+        // Sources without frames have nothing to measure
+        ThermalSpotManager pixel_manager(std::make_unique<CoordinateBasedTemperatureSource>(), path);
+        pixel_manager.setAreas({whole_frame});
+        pixel_manager.sampleSpots();
+        EXPECT_TRUE(pixel_manager.getAreaReadings().empty());
+    }
+    std::filesystem::remove(path);
+}
+
+} // namespace test
+} // namespace thermal
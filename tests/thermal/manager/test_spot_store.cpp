@@ -0,0 +1,330 @@
+#include <gtest/gtest.h>
+#include "thermal/spot_manager/spot_store.h"
+#include "thermal/spot_manager/thermal_spot_manager.h"
+#include "thermal/spot_manager/spot_persistence.h"
+#include "thermal/temperature_source/coordinate_based_source.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace thermal {
+namespace test {
+
+namespace {
+
+MeasurementSpot makeSpot(int id, int x, int y) {
+    MeasurementSpot spot;
+    spot.id = id;
+    spot.name = "spot_" + std::to_string(id);
+    spot.x = x;
+    spot.y = y;
+    spot.min_temp = 20.0;
+    spot.max_temp = 21.0;
+    return spot;
+}
+
+} // namespace
+
+TEST(SpotStoreTest, InsertAndLookup) {
+    SpotStore store(16);
+    ASSERT_TRUE(store.insert(makeSpot(3, 10, 20)));
+    ASSERT_TRUE(store.insert(makeSpot(7, 30, 40)));
+    
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_TRUE(store.contains(3));
+    EXPECT_FALSE(store.contains(4));
+    EXPECT_EQ(store.positions()[store.slotOf(7)].x, 30);
+    EXPECT_EQ(store.toSpot(store.slotOf(3)).name, "spot_3");
+}
+
+TEST(SpotStoreTest, RejectsDuplicateAndOutOfRangeIds) {
+    SpotStore store(4);
+    ASSERT_TRUE(store.insert(makeSpot(1, 0, 0)));
+    EXPECT_FALSE(store.insert(makeSpot(1, 5, 5)));
+    EXPECT_FALSE(store.insert(makeSpot(0, 5, 5)));
+    EXPECT_FALSE(store.insert(makeSpot(5, 5, 5)));
+}
+
+TEST(SpotStoreTest, EraseKeepsColumnsDense) {
+    SpotStore store(8);
+    for (int id = 1; id <= 4; ++id) {
+        ASSERT_TRUE(store.insert(makeSpot(id, id * 10, id)));
+    }
+    
+    ASSERT_TRUE(store.erase(2));
+    EXPECT_EQ(store.size(), 3u);
+    EXPECT_FALSE(store.contains(2));
+    
+    // Remaining spots are still reachable with their own data
+    for (int id : {1, 3, 4}) {
+        int slot = store.slotOf(id);
+        ASSERT_GE(slot, 0);
+        EXPECT_EQ(store.ids()[slot], id);
+        EXPECT_EQ(store.positions()[slot].x, id * 10);
+    }
+}
+
+TEST(SpotStoreTest, AllocateIdReusesReleasedIds) {
+    SpotStore store(3);
+    EXPECT_EQ(store.allocateId(), 1);
+    ASSERT_TRUE(store.insert(makeSpot(1, 0, 0)));
+    ASSERT_TRUE(store.insert(makeSpot(2, 0, 0)));
+    EXPECT_EQ(store.allocateId(), 3);
+    ASSERT_TRUE(store.insert(makeSpot(3, 0, 0)));
+    EXPECT_EQ(store.allocateId(), 0);
+    
+    ASSERT_TRUE(store.erase(2));
+    EXPECT_EQ(store.allocateId(), 2);
+}
+
+TEST(SpotStoreTest, ExplicitIdChurnKeepsAllocationCorrect) {
+    SpotStore store(4);
+    ASSERT_TRUE(store.insert(makeSpot(1, 0, 0)));
+    ASSERT_TRUE(store.insert(makeSpot(2, 0, 0)));
+    
+    // Releasing an ID that is still queued must not queue it again
+    for (int i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(store.erase(2));
+        ASSERT_TRUE(store.insert(makeSpot(2, 0, 0)));
+    }
+    ASSERT_TRUE(store.erase(2));
+    EXPECT_EQ(store.allocateId(), 2);
+    ASSERT_TRUE(store.insert(makeSpot(2, 0, 0)));
+    EXPECT_EQ(store.allocateId(), 3);
+    
+    ASSERT_TRUE(store.insert(makeSpot(3, 0, 0)));
+    ASSERT_TRUE(store.insert(makeSpot(4, 0, 0)));
+    EXPECT_EQ(store.allocateId(), 0);
+    ASSERT_TRUE(store.erase(1));
+    EXPECT_EQ(store.allocateId(), 1);
+}
+
+TEST(SpotStoreTest, UpdateMovesSpot) {
+    SpotStore store(2);
+    ASSERT_TRUE(store.insert(makeSpot(1, 0, 0)));
+    ASSERT_TRUE(store.update(1, 5, 6, 30.0, 31.0));
+    EXPECT_FALSE(store.update(2, 5, 6, 30.0, 31.0));
+    
+    auto spot = store.toSpot(store.slotOf(1));
+    EXPECT_EQ(spot.x, 5);
+    EXPECT_EQ(spot.y, 6);
+    EXPECT_DOUBLE_EQ(spot.min_temp, 30.0);
+}
+
+TEST(SpotStoreTest, ManagerSupportsManySpots) {
+    const std::string path = "/tmp/test_spot_store_manager.json";
+    std::filesystem::remove(path);
+    {
+        ThermalSpotManager manager(std::make_unique<CoordinateBasedTemperatureSource>(), path);
+        for (int i = 1; i <= 50; ++i) {
+            ASSERT_TRUE(manager.createSpot(std::to_string(i), i, i));
+        }
+        EXPECT_EQ(manager.getActiveSpotCount(), 50u);
+        EXPECT_EQ(manager.sampleSpots().size(), 50u);
+        
+        ASSERT_TRUE(manager.deleteSpot("10"));
+        EXPECT_EQ(manager.createSpot(100, 100), "10");
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(SpotStoreTest, KeepsReportByExceptionOverrides) {
+    SpotStore store(4);
+    MeasurementSpot spot = makeSpot(1, 0, 0);
+    spot.deadband_celsius = 0.5;
+    spot.heartbeat_seconds = 60;
+    ASSERT_TRUE(store.insert(spot));
+    MeasurementSpot other = makeSpot(2, 0, 0);
+    other.deadband_percent = 2.0;
+    ASSERT_TRUE(store.insert(other));
+    
+    // Spot 2 is swapped into spot 1's slot
+    ASSERT_TRUE(store.erase(1));
+    auto moved = store.toSpot(store.slotOf(2));
+    EXPECT_FALSE(moved.deadband_celsius.has_value());
+    EXPECT_EQ(moved.deadband_percent, std::optional<double>(2.0));
+    EXPECT_FALSE(moved.heartbeat_seconds.has_value());
+    
+    ASSERT_TRUE(store.insert(spot));
+    auto restored = store.toSpot(store.slotOf(1));
+    EXPECT_EQ(restored.deadband_celsius, std::optional<double>(0.5));
+    EXPECT_FALSE(restored.deadband_percent.has_value());
+    EXPECT_EQ(restored.heartbeat_seconds, std::optional<int>(60));
+}
+
+TEST(SpotStoreTest, ManagerPersistsReportByExceptionOverrides) {
+    const std::string path = "/tmp/test_spot_store_overrides.json";
+    std::filesystem::remove(path);
+    {
+        MeasurementSpot spot = makeSpot(3, 10, 20);
+        spot.deadband_celsius = 0.25;
+        spot.deadband_percent = 1.5;
+        spot.heartbeat_seconds = 300;
+        std::vector<std::unique_ptr<MeasurementSpot>> spots;
+        spots.push_back(std::make_unique<MeasurementSpot>(spot));
+        ASSERT_TRUE(SpotPersistence(path).saveSpots(spots));
+    }
+    {
+        // Loads the file, then rewrites it from the store
+        ThermalSpotManager manager(std::make_unique<CoordinateBasedTemperatureSource>(), path);
+        ASSERT_TRUE(manager.createSpot("4", 5, 5));
+        ASSERT_TRUE(manager.saveSpots());
+    }
+    
+    std::vector<std::unique_ptr<MeasurementSpot>> loaded;
+    ASSERT_TRUE(SpotPersistence(path).loadSpots(loaded));
+    ASSERT_EQ(loaded.size(), 2u);
+    const MeasurementSpot& spot = loaded[0]->id == 3 ? *loaded[0] : *loaded[1];
+    EXPECT_EQ(spot.deadband_celsius, std::optional<double>(0.25));
+    EXPECT_EQ(spot.deadband_percent, std::optional<double>(1.5));
+    EXPECT_EQ(spot.heartbeat_seconds, std::optional<int>(300));
+    std::filesystem::remove(path);
+}
+
+TEST(SpotStoreTest, ManagerCreatesConfiguredSpot) {
+    const std::string path = "/tmp/test_spot_store_configured.json";
+    std::filesystem::remove(path);
+    {
+        ThermalSpotManager manager(std::make_unique<CoordinateBasedTemperatureSource>(), path);
+        MeasurementSpot config = makeSpot(5, 30, 40);
+        config.emissivity = 0.9;
+        config.deadband_celsius = 0.5;
+        config.heartbeat_seconds = 0;
+        ASSERT_TRUE(manager.createSpot(config));
+        EXPECT_FALSE(manager.createSpot(config));
+        
+        MeasurementSpot spot;
+        ASSERT_TRUE(manager.getSpot(5, spot));
+        EXPECT_EQ(spot.x, 30);
+        EXPECT_DOUBLE_EQ(spot.emissivity, 0.9);
+        EXPECT_EQ(spot.deadband_celsius, std::optional<double>(0.5));
+        EXPECT_EQ(spot.heartbeat_seconds, std::optional<int>(0));
+        EXPECT_FALSE(manager.getSpot(6, spot));
+        
+        config.id = static_cast<int>(ThermalSpotManager::MAX_SPOTS) + 1;
+        EXPECT_FALSE(manager.createSpot(config));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(SpotStoreTest, ManagerReportsChangedSpots) {
+    const std::string path = "/tmp/test_spot_store_changed.json";
+    std::filesystem::remove(path);
+    {
+        ThermalSpotManager manager(std::make_unique<CoordinateBasedTemperatureSource>(), path);
+        EXPECT_TRUE(manager.takeChangedSpots().empty());
+        
+        ASSERT_TRUE(manager.createSpot("1", 10, 10));
+        ASSERT_TRUE(manager.createSpot("2", 20, 20));
+        ASSERT_TRUE(manager.moveSpot("1", 15, 15));  // Listed once
+        EXPECT_EQ(manager.takeChangedSpots(), (std::vector<int>{1, 2}));
+        EXPECT_TRUE(manager.takeChangedSpots().empty());
+        
+        // A deleted ID handed out again is reported, so stale per-spot state can be dropped
+        ASSERT_TRUE(manager.deleteSpot("2"));
+        EXPECT_EQ(manager.createSpot(30, 30), "2");
+        EXPECT_EQ(manager.takeChangedSpots(), (std::vector<int>{2}));
+        
+        // Failed changes and rejected batches report nothing
+        EXPECT_FALSE(manager.moveSpot("1", 400, 0));
+        std::vector<SpotChangeResult> results;
+        EXPECT_FALSE(manager.applySpotChanges({{SpotChange::Type::DELETE, "1", 0, 0},
+                                               {SpotChange::Type::DELETE, "9", 0, 0}}, results));
+        EXPECT_TRUE(manager.takeChangedSpots().empty());
+        
+        ASSERT_TRUE(manager.applySpotChanges({{SpotChange::Type::DELETE, "1", 0, 0},
+                                              {SpotChange::Type::CREATE, "", 5, 5}}, results));
+        EXPECT_EQ(manager.takeChangedSpots(), (std::vector<int>{1}));
+        
+        // Reloading reports the spots dropped and the spots loaded
+        ASSERT_TRUE(manager.createSpot("3", 40, 40));
+        ASSERT_TRUE(manager.saveSpots());
+        manager.takeChangedSpots();
+        ASSERT_TRUE(manager.loadSpots());
+        auto changed = manager.takeChangedSpots();
+        std::sort(changed.begin(), changed.end());
+        EXPECT_EQ(changed, (std::vector<int>{1, 2, 3}));
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(SpotStoreTest, ManagerAppliesSpotBatch) {
+    const std::string path = "/tmp/test_spot_store_batch.json";
+    std::filesystem::remove(path);
+    {
+        ThermalSpotManager manager(std::make_unique<CoordinateBasedTemperatureSource>(), path);
+        ASSERT_TRUE(manager.createSpot("1", 10, 10));
+        
+        std::vector<SpotChange> changes = {
+            {SpotChange::Type::CREATE, "", 20, 20},
+            {SpotChange::Type::MOVE, "2", 30, 30},  // Spot created earlier in the batch
+            {SpotChange::Type::DELETE, "1", 0, 0},
+            {SpotChange::Type::CREATE, "7", 40, 40},
+        };
+        std::vector<SpotChangeResult> results;
+        ASSERT_TRUE(manager.applySpotChanges(changes, results));
+        ASSERT_EQ(results.size(), 4u);
+        for (const auto& result : results) {
+            EXPECT_EQ(result.status, SpotChangeStatus::APPLIED);
+        }
+        EXPECT_EQ(results[0].spotId, "2");
+        
+        auto spots = manager.listSpots();
+        ASSERT_EQ(spots.size(), 2u);
+        EXPECT_EQ(spots[0].id, 2);
+        EXPECT_EQ(spots[0].x, 30);
+        EXPECT_EQ(spots[1].id, 7);
+    }
+    
+    // Written once with the final state
+    ThermalSpotManager reloaded(std::make_unique<CoordinateBasedTemperatureSource>(), path);
+    EXPECT_EQ(reloaded.getActiveSpotCount(), 2u);
+    EXPECT_TRUE(reloaded.spotExists("7"));
+    std::filesystem::remove(path);
+}
+
+TEST(SpotStoreTest, ManagerRejectsFailingSpotBatch) {
+    const std::string path = "/tmp/test_spot_store_batch_rejected.json";
+    std::filesystem::remove(path);
+    {
+        ThermalSpotManager manager(std::make_unique<CoordinateBasedTemperatureSource>(), path);
+        ASSERT_TRUE(manager.createSpot("1", 10, 10));
+        
+        std::vector<SpotChange> changes = {
+            {SpotChange::Type::MOVE, "1", 50, 50},
+            {SpotChange::Type::CREATE, "", 20, 20},
+            {SpotChange::Type::CREATE, "1", 20, 20},
+            {SpotChange::Type::DELETE, "9", 0, 0},
+            {SpotChange::Type::MOVE, "1", 400, 0},
+        };
+        std::vector<SpotChangeResult> results;
+        EXPECT_FALSE(manager.applySpotChanges(changes, results));
+        ASSERT_EQ(results.size(), 5u);
+        EXPECT_EQ(results[0].status, SpotChangeStatus::NOT_APPLIED);
+        EXPECT_EQ(results[1].status, SpotChangeStatus::NOT_APPLIED);
+        EXPECT_EQ(results[1].spotId, "");
+        EXPECT_EQ(results[2].status, SpotChangeStatus::SPOT_EXISTS);
+        EXPECT_EQ(results[3].status, SpotChangeStatus::SPOT_NOT_FOUND);
+        EXPECT_EQ(results[4].status, SpotChangeStatus::INVALID_COORDINATES);
+        
+        // Nothing changed, including the move that preceded the failures
+        auto spots = manager.listSpots();
+        ASSERT_EQ(spots.size(), 1u);
+        EXPECT_EQ(spots[0].x, 10);
+        EXPECT_EQ(manager.createSpot(5, 5), "2");
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(SpotStoreTest, SpotIdValidation) {
+    EXPECT_TRUE(ThermalSpotManager::validateSpotId("1"));
+    EXPECT_TRUE(ThermalSpotManager::validateSpotId(std::to_string(ThermalSpotManager::MAX_SPOTS)));
+    EXPECT_FALSE(ThermalSpotManager::validateSpotId(std::to_string(ThermalSpotManager::MAX_SPOTS + 1)));
+    EXPECT_FALSE(ThermalSpotManager::validateSpotId("0"));
+    EXPECT_FALSE(ThermalSpotManager::validateSpotId("01"));
+    EXPECT_FALSE(ThermalSpotManager::validateSpotId("-1"));
+    EXPECT_FALSE(ThermalSpotManager::validateSpotId("abc"));
+    EXPECT_FALSE(ThermalSpotManager::validateSpotId(""));
+}
+
+} // namespace test
+} // namespace thermal
@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "thermal/temperature_source/coordinate_based_source.h"
+#include "thermal/temperature_source/frame_temperature_source.h"
+#include "thermal/frame/thermal_frame.h"
+#include <vector>
+
+namespace thermal {
+namespace test {
+
+TEST(BatchedTemperaturesTest, CoordinateBatchMatchesScalarModel) {
+    CoordinateBasedTemperatureSource source;
+    
+    // 7 points exercises both the full-width kernel and the padded tail
+    std::vector<Point> points = {
+        {160, 120}, {0, 0}, {319, 239}, {80, 60}, {200, 10}, {5, 230}, {160, 0}
+    };
+    std::vector<float> temperatures(points.size());
+    source.getTemperatures(points.data(), points.size(), temperatures.data());
+    
+    for (size_t i = 0; i < points.size(); ++i) {
+        float base = source.getBaseTemperature(points[i].x, points[i].y);
+        EXPECT_NEAR(temperatures[i], base, 0.5f + 1e-3f) << "point " << i;
+    }
+}
+
+TEST(BatchedTemperaturesTest, CoordinateBatchInvalidPointsUseDefault) {
+    CoordinateBasedTemperatureSource source;
+    std::vector<Point> points = {{-1, 0}, {320, 10}, {10, 240}, {10, 10}, {400, 400}};
+    std::vector<float> temperatures(points.size());
+    source.getTemperatures(points.data(), points.size(), temperatures.data());
+    
+    EXPECT_FLOAT_EQ(temperatures[0], 20.0f);
+    EXPECT_FLOAT_EQ(temperatures[1], 20.0f);
+    EXPECT_FLOAT_EQ(temperatures[2], 20.0f);
+    EXPECT_NE(temperatures[3], 20.0f);
+    EXPECT_FLOAT_EQ(temperatures[4], 20.0f);
+}
+
+TEST(BatchedTemperaturesTest, EmptyBatchIsNoOp) {
+    CoordinateBasedTemperatureSource source;
+    source.getTemperatures(nullptr, 0, nullptr);
+}
+
+TEST(BatchedTemperaturesTest, FrameBatchGathersFromCurrentFrame) {
+    FrameTemperatureSource source;
+    ASSERT_TRUE(source.captureFrame());
+    const ThermalFrame* frame = source.getCurrentFrame();
+    
+    std::vector<Point> points = {{1, 2}, {300, 200}, {160, 120}};
+    std::vector<float> temperatures(points.size());
+    source.getTemperatures(points.data(), points.size(), temperatures.data());
+    
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_FLOAT_EQ(temperatures[i], frame->at(points[i].x, points[i].y));
+    }
+}
+
+} // namespace test
+} // namespace thermal
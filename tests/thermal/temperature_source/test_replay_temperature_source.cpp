@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "thermal/temperature_source/replay_temperature_source.h"
+#include "thermal/temperature_source/temperature_source_factory.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace thermal {
+namespace test {
+
+class ReplayTemperatureSourceTest : public ::testing::Test {
+protected:
+    static constexpr int WIDTH = 8;
+    static constexpr int HEIGHT = 4;
+    static constexpr int FRAMES = 3;
+
+    std::string path_ = "/tmp/test_replay_frames.raw";
+
+    void SetUp() override {
+        // Frame f holds (300 K + f + pixel index / 100) in 0.01 K counts
+        std::vector<std::uint16_t> counts;
+        for (int f = 0; f < FRAMES; ++f) {
+            for (int i = 0; i < WIDTH * HEIGHT; ++i) {
+                counts.push_back(static_cast<std::uint16_t>(30000 + f * 100 + i));
+            }
+        }
+        std::ofstream out(path_, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(counts.data()), counts.size() * sizeof(std::uint16_t));
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+
+    ReplayOptions options(bool loop = true) const {
+        ReplayOptions opts;
+        opts.file_path = path_;
+        opts.width = WIDTH;
+        opts.height = HEIGHT;
+        opts.loop = loop;
+        return opts;
+    }
+};
+
+TEST_F(ReplayTemperatureSourceTest, ConvertsCountsToCelsius) {
+    ReplayTemperatureSource source(options());
+    EXPECT_EQ(source.getFrameCount(), 3u);
+    EXPECT_EQ(source.getCurrentRawFrame(), nullptr);
+
+    ASSERT_TRUE(source.captureFrame());
+    EXPECT_EQ(source.getCurrentRawFrame()[1], 30001);
+    EXPECT_NEAR(source.getTemperature(0, 0), 300.0 - 273.15, 1e-3);
+    EXPECT_NEAR(source.getTemperature(1, 0), 300.01 - 273.15, 1e-3);
+}
+
+TEST_F(ReplayTemperatureSourceTest, AsFastAsPossibleAdvancesOneFramePerCapture) {
+    ReplayTemperatureSource source(options());
+    for (int capture = 0; capture < 5; ++capture) {
+        ASSERT_TRUE(source.captureFrame());
+        EXPECT_EQ(source.getCurrentFrameIndex(), static_cast<size_t>(capture % FRAMES));
+        EXPECT_EQ(source.getCurrentRawFrame()[0], 30000 + (capture % FRAMES) * 100);
+    }
+}
+
+TEST_F(ReplayTemperatureSourceTest, StopsAtEndWithoutLoop) {
+    ReplayTemperatureSource source(options(false));
+    for (int capture = 0; capture < FRAMES; ++capture) {
+        ASSERT_TRUE(source.captureFrame());
+    }
+    EXPECT_FALSE(source.captureFrame());
+    EXPECT_EQ(source.getCurrentFrame()->sequence, 3u);
+}
+
+TEST_F(ReplayTemperatureSourceTest, RejectsMissingOrShortFile) {
+    ReplayOptions missing = options();
+    missing.file_path = "/tmp/does_not_exist_replay.raw";
+    EXPECT_THROW(ReplayTemperatureSource source(missing), std::runtime_error);
+
+    ReplayOptions too_large = options();
+    too_large.width = 1024;
+    EXPECT_THROW(ReplayTemperatureSource source(too_large), std::runtime_error);
+}
+
+TEST_F(ReplayTemperatureSourceTest, FactoryCreatesReplaySource) {
+    EXPECT_EQ(TemperatureSourceFactory::parseSourceType("file_replay"),
+              TemperatureSourceFactory::SourceType::FILE_REPLAY);
+
+    auto source = TemperatureSourceFactory::createReplaySource(options());
+    ASSERT_NE(source, nullptr);
+    EXPECT_EQ(source->getSourceName(), "ReplayTemperatureSource");
+    EXPECT_TRUE(source->captureFrame());
+}
+
+} // namespace test
+} // namespace thermal
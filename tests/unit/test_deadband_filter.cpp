@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "thermal/deadband_filter.h"
+#include <vector>
+
+using namespace thermal;
+
+namespace {
+
+TemperatureReading makeReading(int spot_id, double temperature,
+                               std::chrono::time_point<std::chrono::system_clock> timestamp) {
+    TemperatureReading reading(spot_id, temperature);
+    reading.timestamp = timestamp;
+    return reading;
+}
+
+} // namespace
+
+class DeadbandFilterTest : public ::testing::Test {
+protected:
+    std::chrono::time_point<std::chrono::system_clock> t0_ = std::chrono::system_clock::now();
+};
+
+// Test that without a deadband every reading passes
+TEST_F(DeadbandFilterTest, InactiveSettingsPassEverything) {
+    DeadbandFilter filter;
+    EXPECT_TRUE(filter.shouldPublish(makeReading(1, 25.0, t0_)));
+    EXPECT_TRUE(filter.shouldPublish(makeReading(1, 25.0, t0_)));
+    EXPECT_EQ(filter.getSuppressedCount(), 0u);
+}
+
+// Test absolute deadband: only changes above the threshold pass
+TEST_F(DeadbandFilterTest, AbsoluteDeadband) {
+    DeadbandSettings settings;
+    settings.deadband_celsius = 0.5;
+    DeadbandFilter filter(settings);
+
+    EXPECT_TRUE(filter.shouldPublish(makeReading(1, 25.0, t0_)));   // First reading
+    EXPECT_FALSE(filter.shouldPublish(makeReading(1, 25.4, t0_)));
+    EXPECT_FALSE(filter.shouldPublish(makeReading(1, 24.6, t0_)));
+    EXPECT_TRUE(filter.shouldPublish(makeReading(1, 25.6, t0_)));
+    // Compared against the last sent value, not the last sampled one
+    EXPECT_FALSE(filter.shouldPublish(makeReading(1, 26.0, t0_)));
+    EXPECT_EQ(filter.getPublishedCount(), 2u);
+    EXPECT_EQ(filter.getSuppressedCount(), 3u);
+}
+
+// Test relative deadband in percent of the last sent value
+TEST_F(DeadbandFilterTest, PercentDeadband) {
+    DeadbandSettings settings;
+    settings.deadband_percent = 10.0;
+    DeadbandFilter filter(settings);
+
+    EXPECT_TRUE(filter.shouldPublish(makeReading(1, 50.0, t0_)));
+    EXPECT_FALSE(filter.shouldPublish(makeReading(1, 54.0, t0_)));
+    EXPECT_TRUE(filter.shouldPublish(makeReading(1, 44.0, t0_)));
+}
+
+// Test that the heartbeat republishes an unchanged value
+TEST_F(DeadbandFilterTest, HeartbeatForcesPublish) {
+    DeadbandSettings settings;
+    settings.deadband_celsius = 1.0;
+    settings.heartbeat_seconds = 60;
+    DeadbandFilter filter(settings);
+
+    EXPECT_TRUE(filter.shouldPublish(makeReading(1, 30.0, t0_)));
+    EXPECT_FALSE(filter.shouldPublish(makeReading(1, 30.0, t0_ + std::chrono::seconds(59))));
+    EXPECT_TRUE(filter.shouldPublish(makeReading(1, 30.0, t0_ + std::chrono::seconds(60))));
+    EXPECT_FALSE(filter.shouldPublish(makeReading(1, 30.0, t0_ + std::chrono::seconds(90))));
+}
+
+// Test per-spot settings, overrides and in-place compaction
+TEST_F(DeadbandFilterTest, PerSpotSettingsAndFilter) {
+    DeadbandSettings defaults;
+    defaults.deadband_celsius = 2.0;
+    DeadbandFilter filter(defaults);
+
+    MeasurementSpot sensitive;
+    sensitive.id = 2;
+    sensitive.deadband_celsius = 0.1;
+    DeadbandSettings spot_settings = defaults.withOverrides(sensitive);
+    EXPECT_DOUBLE_EQ(spot_settings.deadband_celsius, 0.1);
+    filter.setSpotSettings(2, spot_settings);
+
+    std::vector<TemperatureReading> first = {makeReading(1, 20.0, t0_), makeReading(2, 20.0, t0_)};
+    EXPECT_EQ(filter.filter(first.data(), first.size()), 2u);
+
+    std::vector<TemperatureReading> second = {makeReading(1, 20.5, t0_), makeReading(2, 20.5, t0_),
+                                              makeReading(3, 40.0, t0_)};
+    size_t kept = filter.filter(second.data(), second.size());
+    ASSERT_EQ(kept, 2u);
+    EXPECT_EQ(second[0].spot_id, 2);
+    EXPECT_EQ(second[1].spot_id, 3);
+
+    // A reset spot publishes its next reading again
+    filter.resetSpot(1);
+    EXPECT_TRUE(filter.shouldPublish(makeReading(1, 20.5, t0_)));
+}
+
+// Test JSON round trip of spot overrides
+TEST(DeadbandSpotJsonTest, OverridesRoundTrip) {
+    MeasurementSpot spot;
+    spot.id = 1;
+    spot.name = "Spot";
+    EXPECT_FALSE(spot.to_json().contains("deadband_celsius"));
+
+    spot.deadband_percent = 5.0;
+    spot.heartbeat_seconds = 300;
+    MeasurementSpot loaded;
+    loaded.from_json(spot.to_json());
+    EXPECT_FALSE(loaded.deadband_celsius.has_value());
+    ASSERT_TRUE(loaded.deadband_percent.has_value());
+    EXPECT_DOUBLE_EQ(*loaded.deadband_percent, 5.0);
+    EXPECT_EQ(loaded.heartbeat_seconds.value_or(0), 300);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "common/executor.h"
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using thermal::Executor;
+
+// Test that every submitted task runs before shutdown returns
+TEST(ExecutorTest, ShutdownDrainsQueuedTasks) {
+    std::atomic<int> counter{0};
+    Executor executor(3);
+    EXPECT_EQ(executor.workerCount(), 3u);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(executor.submit([&counter] {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            counter++;
+        }));
+    }
+    executor.shutdown();
+    EXPECT_EQ(counter.load(), 100);
+    EXPECT_EQ(executor.pending(), 0u);
+}
+
+// Test that tasks are rejected once shut down
+TEST(ExecutorTest, RejectsAfterShutdown) {
+    Executor executor(1);
+    executor.shutdown();
+    EXPECT_FALSE(executor.submit([] {}));
+    executor.shutdown();  // Idempotent
+}
+
+// Test that a throwing task does not take its worker down
+TEST(ExecutorTest, SurvivesThrowingTask) {
+    std::atomic<bool> ran{false};
+    Executor executor(1);
+    executor.submit([] { throw std::runtime_error("boom"); });
+    executor.submit([&ran] { ran = true; });
+    executor.shutdown();
+    EXPECT_TRUE(ran);
+}
+
+// Test that a task cannot shut down its own executor, and the owner still can
+TEST(ExecutorTest, ShutdownFromTaskIsIgnored) {
+    std::atomic<bool> ran{false};
+    Executor executor(1);
+    ASSERT_TRUE(executor.submit([&executor] { executor.shutdown(); }));
+    ASSERT_TRUE(executor.submit([&ran] { ran = true; }));
+    executor.shutdown();
+    EXPECT_TRUE(ran);
+    EXPECT_FALSE(executor.submit([] {}));
+}
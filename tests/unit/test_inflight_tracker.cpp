@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "mqtt/inflight_tracker.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using thermal::DeliveryResult;
+using thermal::InFlightTracker;
+
+// Test that an acknowledgement completes the publish once and records its latency
+TEST(InFlightTrackerTest, DeliveryCompletesOnce) {
+    InFlightTracker tracker;
+    auto& latency = thermal::MetricsRegistry::instance().histogram(
+        "mqtt_publish_delivery_microseconds", "", {{"topic_class", "telemetry"}});
+    auto recorded = latency.snapshot().count;
+
+    std::vector<DeliveryResult> results;
+    auto sent_at = InFlightTracker::Clock::now() - std::chrono::milliseconds(5);
+    ASSERT_TRUE(tracker.track(7, "v1/devices/me/telemetry", sent_at,
+                              [&results](DeliveryResult result) { results.push_back(result); }));
+    EXPECT_EQ(tracker.getStats().in_flight, 1u);
+    EXPECT_GE(tracker.getStats().oldest_age, std::chrono::milliseconds(5));
+
+    tracker.complete(7, DeliveryResult::DELIVERED);
+    tracker.complete(7, DeliveryResult::DELIVERED);  // Duplicate acknowledgement is ignored
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], DeliveryResult::DELIVERED);
+
+    auto stats = tracker.getStats();
+    EXPECT_EQ(stats.in_flight, 0u);
+    EXPECT_EQ(stats.delivered, 1u);
+    EXPECT_EQ(latency.snapshot().count, recorded + 1);
+    EXPECT_GE(latency.snapshot().max, 5000u);
+}
+
+// Test an acknowledgement that arrives before track() and a stale one for a reused token
+TEST(InFlightTrackerTest, EarlyAndStaleOutcomes) {
+    InFlightTracker tracker;
+    std::vector<DeliveryResult> results;
+    auto on_complete = [&results](DeliveryResult result) { results.push_back(result); };
+
+    auto sent_at = InFlightTracker::Clock::now();
+    tracker.complete(3, DeliveryResult::FAILED);
+    ASSERT_TRUE(tracker.track(3, "v1/devices/me/rpc/response/1", sent_at, on_complete));
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0], DeliveryResult::FAILED);
+    EXPECT_EQ(tracker.getStats().in_flight, 0u);
+
+    // Outcome recorded before the send belongs to an earlier message with the same ID
+    tracker.complete(4, DeliveryResult::DELIVERED);
+    auto later = InFlightTracker::Clock::now() + std::chrono::milliseconds(1);
+    ASSERT_TRUE(tracker.track(4, "v1/devices/me/telemetry", later, on_complete));
+    EXPECT_EQ(results.size(), 1u);
+    EXPECT_EQ(tracker.getStats().in_flight, 1u);
+}
+
+// Test that a lost connection fails every pending publish and clear() drops callbacks
+TEST(InFlightTrackerTest, FailAllAndClear) {
+    InFlightTracker tracker(2);
+    int lost = 0;
+    auto on_complete = [&lost](DeliveryResult result) {
+        if (result == DeliveryResult::CONNECTION_LOST) {
+            lost++;
+        }
+    };
+
+    auto now = InFlightTracker::Clock::now();
+    EXPECT_TRUE(tracker.track(1, "v1/devices/me/telemetry", now, on_complete));
+    EXPECT_TRUE(tracker.track(2, "v1/devices/me/telemetry", now, on_complete));
+    EXPECT_FALSE(tracker.track(3, "v1/devices/me/telemetry", now, on_complete));  // Full
+    tracker.failAll();
+    EXPECT_EQ(lost, 2);
+    EXPECT_EQ(tracker.getStats().connection_lost, 2u);
+
+    EXPECT_TRUE(tracker.track(5, "v1/devices/me/telemetry", now, on_complete));
+    tracker.clear();
+    tracker.complete(5, DeliveryResult::DELIVERED);
+    EXPECT_EQ(lost, 2);
+    EXPECT_EQ(tracker.getStats().in_flight, 0u);
+}
+
+// Test that clear() returns only after a callback already running has finished
+TEST(InFlightTrackerTest, ClearWaitsForRunningCallback) {
+    InFlightTracker tracker;
+    std::atomic<bool> started{false};
+    std::atomic<bool> finished{false};
+    auto now = InFlightTracker::Clock::now();
+    ASSERT_TRUE(tracker.track(9, "v1/devices/me/telemetry", now, [&](DeliveryResult) {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    }));
+
+    std::thread paho([&tracker]() { tracker.complete(9, DeliveryResult::FAILED); });
+    while (!started) {
+        std::this_thread::yield();
+    }
+    tracker.clear();
+    EXPECT_TRUE(finished);
+    paho.join();
+}
+
+// Test the latency label derived from the topic
+TEST(InFlightTrackerTest, TopicClass) {
+    EXPECT_EQ(InFlightTracker::topicClass("v1/devices/me/telemetry"), "telemetry");
+    EXPECT_EQ(InFlightTracker::topicClass("v1/devices/me/attributes"), "attributes");
+    EXPECT_EQ(InFlightTracker::topicClass("v1/devices/me/rpc/response/42"), "rpc_response");
+    EXPECT_EQ(InFlightTracker::topicClass("v1/devices/me/rpc/request/42"), "other");
+    EXPECT_EQ(InFlightTracker::topicClass("v1/dev"), "other");
+}
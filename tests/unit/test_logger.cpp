@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "common/logger.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace thermal;
+
+class LoggerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() / "thermal_logger_test";
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+        log_file_ = (directory_ / "test.log").string();
+    }
+
+    void TearDown() override {
+        Logger::initialize(LogLevel::INFO, "console");
+        std::filesystem::remove_all(directory_);
+    }
+
+    static std::string readFile(const std::string& path) {
+        std::ifstream file(path);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    std::filesystem::path directory_;
+    std::string log_file_;
+};
+
+// Test that messages from several threads all reach the file after flush()
+TEST_F(LoggerTest, WritesFileAfterFlush) {
+    Logger::initialize(LogLevel::INFO, "file", log_file_);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t] {
+            for (int i = 0; i < 100; ++i) {
+                LOG_INFO("thread " << t << " message " << i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    LOG_DEBUG("filtered out");
+    Logger::instance().flush();
+
+    std::string contents = readFile(log_file_);
+    size_t lines = 0;
+    std::istringstream stream(contents);
+    for (std::string line; std::getline(stream, line);) {
+        EXPECT_NE(line.find("] [INFO ] thread "), std::string::npos) << line;
+        lines++;
+    }
+    EXPECT_EQ(lines + Logger::instance().get_dropped_count(), 400u);
+    EXPECT_EQ(contents.find("filtered out"), std::string::npos);
+}
+
+// Test the lock-free level check
+TEST_F(LoggerTest, LevelCheck) {
+    Logger& logger = Logger::instance();
+    logger.set_level(LogLevel::WARN);
+    EXPECT_FALSE(logger.is_enabled(LogLevel::INFO));
+    EXPECT_TRUE(logger.is_enabled(LogLevel::ERROR));
+    EXPECT_EQ(Logger::level_from_string("debug"), LogLevel::DEBUG);
+    EXPECT_THROW(Logger::level_from_string("verbose"), std::invalid_argument);
+}
+
+// Test that the file rotates at the size limit and keeps max_files backups
+TEST_F(LoggerTest, RotatesFile) {
+    Logger::initialize(LogLevel::INFO, "file", log_file_, 1024, 2);
+
+    const std::string payload(100, 'x');
+    for (int i = 0; i < 50; ++i) {
+        LOG_INFO(payload);
+    }
+    Logger::instance().flush();
+
+    EXPECT_TRUE(std::filesystem::exists(log_file_ + ".1"));
+    EXPECT_TRUE(std::filesystem::exists(log_file_ + ".2"));
+    EXPECT_FALSE(std::filesystem::exists(log_file_ + ".3"));
+    EXPECT_LE(std::filesystem::file_size(log_file_), 1024u);
+    EXPECT_LE(std::filesystem::file_size(log_file_ + ".1"), 1024u);
+}
+
+// Test the per-call-site rate limits and their suppressed counts
+TEST(LogRateLimitTest, EveryNAndFirstN) {
+    LogRateLimit every;
+    std::vector<int> passed;
+    std::uint64_t suppressed = 0;
+    for (int i = 0; i < 10; ++i) {
+        if (every.every_n(4, suppressed)) {
+            passed.push_back(i);
+            EXPECT_EQ(suppressed, i == 0 ? 0u : 3u);
+        }
+    }
+    EXPECT_EQ(passed, (std::vector<int>{0, 4, 8}));
+
+    LogRateLimit first;
+    int first_passed = 0;
+    for (int i = 0; i < 100; ++i) {
+        first_passed += first.first_n(3, suppressed) ? 1 : 0;
+    }
+    EXPECT_EQ(first_passed, 3);  // The summary is not due for a minute
+}
+
+TEST(LogRateLimitTest, EveryMs) {
+    LogRateLimit limit;
+    std::uint64_t suppressed = 0;
+    EXPECT_TRUE(limit.every_ms(50, suppressed));
+    EXPECT_FALSE(limit.every_ms(50, suppressed));
+    EXPECT_FALSE(limit.every_ms(50, suppressed));
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    EXPECT_TRUE(limit.every_ms(50, suppressed));
+    EXPECT_EQ(suppressed, 2u);
+}
+
+// Test that the macro appends the suppressed count
+TEST_F(LoggerTest, RateLimitedMacroReportsSuppressed) {
+    Logger::initialize(LogLevel::INFO, "file", log_file_);
+    for (int i = 0; i < 5; ++i) {
+        LOG_WARN_EVERY_N(3, "storm " << i);
+    }
+    Logger::instance().flush();
+
+    std::string contents = readFile(log_file_);
+    EXPECT_NE(contents.find("storm 0\n"), std::string::npos);
+    EXPECT_NE(contents.find("storm 3 [2 similar messages suppressed]"), std::string::npos);
+    EXPECT_EQ(contents.find("storm 1"), std::string::npos);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "thermal/measurement_spot.h"
+#include <limits>
 #include <nlohmann/json.hpp>
 #include <stdexcept>
 
@@ -97,6 +98,30 @@ TEST_F(MeasurementSpotTest, ValidateNoiseFactor) {
     EXPECT_TRUE(valid_spot_.validate());
 }
 
+TEST_F(MeasurementSpotTest, ValidateRadiometricParameters) {
+    // Emissivity must be in (0, 1]
+    valid_spot_.emissivity = 0.0;
+    EXPECT_THROW(valid_spot_.validate(), std::invalid_argument);
+    valid_spot_.emissivity = 1.0;
+    EXPECT_TRUE(valid_spot_.validate());
+    
+    // Reflected temperature shares the -100°C to 500°C limits
+    valid_spot_.reflected_temp = -100.1;
+    EXPECT_THROW(valid_spot_.validate(), std::invalid_argument);
+    
+    valid_spot_.reflected_temp = 500.1;
+    EXPECT_THROW(valid_spot_.validate(), std::invalid_argument);
+    
+    valid_spot_.reflected_temp = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_THROW(valid_spot_.validate(), std::invalid_argument);
+    
+    valid_spot_.reflected_temp = -100.0;
+    EXPECT_TRUE(valid_spot_.validate());
+    
+    valid_spot_.reflected_temp = 500.0;
+    EXPECT_TRUE(valid_spot_.validate());
+}
+
 // Test JSON serialization and deserialization
 TEST_F(MeasurementSpotTest, JsonSerialization) {
     nlohmann::json json_data = valid_spot_.to_json();
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include "common/metrics.h"
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using thermal::Histogram;
+using thermal::MetricsRegistry;
+using thermal::MetricType;
+
+// Test that counters and gauges keep their values
+TEST(MetricsTest, CounterAndGauge) {
+    thermal::Counter counter;
+    counter.increment();
+    counter.increment(4);
+    EXPECT_EQ(counter.value(), 5u);
+    counter.reset();
+    EXPECT_EQ(counter.value(), 0u);
+
+    thermal::Gauge gauge;
+    gauge.set(10);
+    gauge.add(-3);
+    EXPECT_EQ(gauge.value(), 7);
+}
+
+// Test that every value lands in a bucket whose bounds contain it
+TEST(MetricsTest, HistogramBucketsContainValues) {
+    std::vector<std::uint64_t> values = {0, 1, 15, 16, 17, 31, 32, 33, 1000, 123456, 1ULL << 39};
+    for (std::uint64_t value : values) {
+        size_t index = Histogram::bucketIndex(value);
+        ASSERT_LT(index, Histogram::BUCKET_COUNT);
+        EXPECT_GE(Histogram::bucketUpperBound(index), value) << value;
+        if (index > 0) {
+            EXPECT_LT(Histogram::bucketUpperBound(index - 1), value) << value;
+        }
+    }
+    EXPECT_EQ(Histogram::bucketIndex(1ULL << 50), Histogram::BUCKET_COUNT - 1);
+}
+
+// Test that percentiles stay within the histogram's relative precision
+TEST(MetricsTest, HistogramPercentiles) {
+    Histogram histogram;
+    for (std::uint64_t value = 1; value <= 10000; ++value) {
+        histogram.record(value);
+    }
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 10000u);
+    EXPECT_EQ(snapshot.min, 1u);
+    EXPECT_EQ(snapshot.max, 10000u);
+    EXPECT_DOUBLE_EQ(snapshot.mean(), 5000.5);
+
+    const double tolerance = 1.0 / Histogram::SUB_BUCKETS;
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(0.5)), 5000.0, 5000.0 * tolerance);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(0.99)), 9900.0, 9900.0 * tolerance);
+    EXPECT_EQ(snapshot.percentile(1.0), 10000u);
+    EXPECT_EQ(snapshot.percentile(0.0), 1u);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.snapshot().count, 0u);
+    EXPECT_EQ(histogram.snapshot().percentile(0.5), 0u);
+}
+
+// Test that concurrent recording loses no samples
+TEST(MetricsTest, HistogramConcurrentRecord) {
+    Histogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram] {
+            for (int i = 0; i < 10000; ++i) {
+                histogram.record(static_cast<std::uint64_t>(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(histogram.snapshot().count, 40000u);
+}
+
+// Test that the registry returns the same series for the same name and labels
+TEST(MetricsTest, RegistryIdentityAndLabels) {
+    auto& registry = MetricsRegistry::instance();
+    auto& a = registry.counter("test_registry_total", "Test counter", {{"method", "a"}});
+    auto& again = registry.counter("test_registry_total", "", {{"method", "a"}});
+    auto& b = registry.counter("test_registry_total", "", {{"method", "b"}});
+    EXPECT_EQ(&a, &again);
+    EXPECT_NE(&a, &b);
+
+    a.increment(2);
+    b.increment(3);
+    int found = 0;
+    for (const auto& metric : registry.snapshot()) {
+        if (metric.name != "test_registry_total") {
+            continue;
+        }
+        found++;
+        EXPECT_EQ(metric.type, MetricType::COUNTER);
+        EXPECT_EQ(metric.help, "Test counter");
+        EXPECT_EQ(metric.value, metric.labels.at("method") == "a" ? 2 : 3);
+    }
+    EXPECT_EQ(found, 2);
+
+    EXPECT_THROW(registry.gauge("test_registry_total", "", {{"method", "a"}}), std::invalid_argument);
+    EXPECT_THROW(registry.histogram("test_registry_total"), std::invalid_argument);
+}
+
+// Test that reset zeroes counters and histograms but keeps gauges
+TEST(MetricsTest, RegistryReset) {
+    auto& registry = MetricsRegistry::instance();
+    auto& counter = registry.counter("test_reset_total");
+    auto& gauge = registry.gauge("test_reset_depth");
+    auto& histogram = registry.histogram("test_reset_microseconds");
+    counter.increment();
+    gauge.set(5);
+    {
+        thermal::ScopedLatency latency(histogram);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_GE(histogram.snapshot().min, 1000u);
+
+    registry.reset();
+    EXPECT_EQ(counter.value(), 0u);
+    EXPECT_EQ(gauge.value(), 5);
+    EXPECT_EQ(histogram.snapshot().count, 0u);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "common/metrics_exporter.h"
+#include <arpa/inet.h>
+#include <filesystem>
+#include <fstream>
+#include <netinet/in.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using thermal::MetricSnapshot;
+using thermal::MetricType;
+using thermal::MetricsExporter;
+
+namespace {
+
+// Sends one request to the exporter and returns the raw response
+std::string http_request(int port, const std::string& request) {
+    int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port));
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        ::close(fd);
+        return "";
+    }
+    ::send(fd, request.data(), request.size(), 0);
+
+    std::string response;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<size_t>(n));
+    }
+    ::close(fd);
+    return response;
+}
+
+} // namespace
+
+// Test counter and gauge lines with HELP, TYPE and escaped labels
+TEST(MetricsExporterTest, FormatsCountersAndGauges) {
+    std::vector<MetricSnapshot> metrics;
+    metrics.push_back(thermal::makeMetricSnapshot(MetricType::GAUGE, "queue_depth", "Queue depth", 3));
+    metrics.push_back(thermal::makeMetricSnapshot(MetricType::COUNTER, "requests_total", "Requests\nby method", 7,
+                                                  {{"method", "say \"hi\""}}));
+    metrics.push_back(thermal::makeMetricSnapshot(MetricType::COUNTER, "requests_total", "", 2, {{"method", "b"}}));
+
+    EXPECT_EQ(thermal::formatPrometheusText(metrics),
+              "# HELP queue_depth Queue depth\n"
+              "# TYPE queue_depth gauge\n"
+              "queue_depth 3\n"
+              "# HELP requests_total Requests\\nby method\n"
+              "# TYPE requests_total counter\n"
+              "requests_total{method=\"say \\\"hi\\\"\"} 7\n"
+              "requests_total{method=\"b\"} 2\n");
+}
+
+// Test that histogram buckets are cumulative at power-of-two bounds
+TEST(MetricsExporterTest, FormatsHistograms) {
+    thermal::Histogram histogram;
+    histogram.record(1);
+    histogram.record(5);
+    histogram.record(6);
+
+    MetricSnapshot metric;
+    metric.name = "latency_microseconds";
+    metric.type = MetricType::HISTOGRAM;
+    metric.labels = {{"method", "get"}};
+    metric.histogram = histogram.snapshot();
+
+    EXPECT_EQ(thermal::formatPrometheusText({metric}),
+              "# TYPE latency_microseconds histogram\n"
+              "latency_microseconds_bucket{method=\"get\",le=\"0\"} 0\n"
+              "latency_microseconds_bucket{method=\"get\",le=\"1\"} 1\n"
+              "latency_microseconds_bucket{method=\"get\",le=\"3\"} 1\n"
+              "latency_microseconds_bucket{method=\"get\",le=\"7\"} 3\n"
+              "latency_microseconds_bucket{method=\"get\",le=\"+Inf\"} 3\n"
+              "latency_microseconds_sum{method=\"get\"} 12\n"
+              "latency_microseconds_count{method=\"get\"} 3\n");
+}
+
+// Test that the textfile is replaced with registry and collector metrics
+TEST(MetricsExporterTest, WritesTextfile) {
+    auto path = std::filesystem::temp_directory_path() / "thermal_metrics_test.prom";
+    thermal::MetricsRegistry::instance().counter("exporter_test_total", "Exporter test").increment();
+
+    MetricsExporter exporter([](std::vector<MetricSnapshot>& metrics) {
+        metrics.push_back(thermal::makeMetricSnapshot(MetricType::GAUGE, "exporter_collected", "", 42));
+    });
+    exporter.writeTextfile(path.string(), std::chrono::milliseconds(50));
+    exporter.stop();
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_NE(content.str().find("# TYPE exporter_test_total counter\nexporter_test_total "), std::string::npos);
+    EXPECT_NE(content.str().find("exporter_collected 42\n"), std::string::npos);
+    std::filesystem::remove(path);
+}
+
+// Test GET /metrics and the error responses of the HTTP listener
+TEST(MetricsExporterTest, ServesHttp) {
+    MetricsExporter exporter([](std::vector<MetricSnapshot>& metrics) {
+        metrics.push_back(thermal::makeMetricSnapshot(MetricType::GAUGE, "exporter_http_gauge", "", 5));
+    });
+    exporter.serveHttp("127.0.0.1", 0);
+    ASSERT_GT(exporter.port(), 0);
+    EXPECT_THROW(exporter.serveHttp("127.0.0.1", 0), std::runtime_error);
+
+    std::string response = http_request(exporter.port(), "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    EXPECT_EQ(response.rfind("HTTP/1.0 200 OK\r\n", 0), 0u);
+    EXPECT_NE(response.find("text/plain; version=0.0.4"), std::string::npos);
+    EXPECT_NE(response.find("exporter_http_gauge 5\n"), std::string::npos);
+
+    response = http_request(exporter.port(), "GET /other HTTP/1.1\r\n\r\n");
+    EXPECT_EQ(response.rfind("HTTP/1.0 404", 0), 0u);
+    response = http_request(exporter.port(), "POST /metrics HTTP/1.1\r\n\r\n");
+    EXPECT_EQ(response.rfind("HTTP/1.0 405", 0), 0u);
+
+    exporter.stop();
+    EXPECT_EQ(exporter.port(), 0);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "thingsboard/protobuf_encoder.h"
+#include "thermal/measurement_area.h"
+#include <limits>
+
+using thermal::AreaStatistics;
+using thermal::FrameExtremes;
+using thermal::ProtobufTelemetryEncoder;
+using thermal::TelemetryEncoder;
+
+namespace {
+
+std::string bytes(std::initializer_list<unsigned char> values) {
+    return std::string(values.begin(), values.end());
+}
+
+} // namespace
+
+// Test the wire bytes of a TelemetryEntry with one spot
+TEST(ProtobufEncoderTest, EncodesSpot) {
+    ProtobufTelemetryEncoder encoder;
+    encoder.begin(1);
+    encoder.addSpot(1, 25.5);  // 0x4039800000000000
+
+    // ts = 1, then values (9 bytes): field 1 fixed64
+    EXPECT_EQ(encoder.finish(), bytes({0x08, 0x01, 0x12, 0x09,
+                                       0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x39, 0x40}));
+}
+
+// Test repeated, invalid and non-finite spots and the frame extremes fields
+TEST(ProtobufEncoderTest, EncodesExtremesAndSkipsUnencodableSpots) {
+    ProtobufTelemetryEncoder encoder;
+    encoder.begin(0);
+    encoder.addSpot(0, 20.0);
+    encoder.addSpot(ProtobufTelemetryEncoder::FRAME_FIELD_BASE, 20.0);
+    encoder.addSpot(2, std::numeric_limits<double>::quiet_NaN());
+    EXPECT_EQ(encoder.finish(), bytes({0x08, 0x00, 0x12, 0x00}));
+
+    encoder.begin(300);
+    encoder.addSpot(2, 0.0);
+    encoder.addSpot(2, 0.0);  // Written twice; parsers keep the last
+    FrameExtremes extremes;
+    extremes.valid = true;
+    extremes.max_temp = 2.0f;   // 0x4000000000000000
+    extremes.max_location = {1, 2};
+    extremes.min_temp = 0.0f;
+    extremes.min_location = {-1, 0};
+    encoder.addFrameExtremes(extremes);
+
+    std::string zero_spot = bytes({0x11, 0, 0, 0, 0, 0, 0, 0, 0});
+    std::string expected_values = zero_spot + zero_spot
+        + bytes({0x89, 0xF1, 0x04, 0, 0, 0, 0, 0, 0, 0, 0x40})                          // 10001 frame_max_temp
+        + bytes({0x90, 0xF1, 0x04, 0x01})                                               // 10002 frame_max_x
+        + bytes({0x98, 0xF1, 0x04, 0x02})                                               // 10003 frame_max_y
+        + bytes({0xA1, 0xF1, 0x04, 0, 0, 0, 0, 0, 0, 0, 0})                             // 10004 frame_min_temp
+        + bytes({0xA8, 0xF1, 0x04, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01})  // 10005 = -1
+        + bytes({0xB0, 0xF1, 0x04, 0x00});                                              // 10006 frame_min_y
+    EXPECT_EQ(encoder.finish(), bytes({0x08, 0xAC, 0x02, 0x12, static_cast<unsigned char>(expected_values.size())})
+                                    + expected_values);
+}
+
+// Test the area fields and the skipped out-of-range or invalid areas
+TEST(ProtobufEncoderTest, EncodesAreas) {
+    ProtobufTelemetryEncoder encoder;
+    AreaStatistics stats;
+    stats.valid = true;
+    stats.max_temp = 2.0f;     // 0x4000000000000000
+    stats.hottest = {1, 2};
+    stats.mean_temp = 0.5;     // 0x3FE0000000000000
+    stats.min_temp = 0.0f;
+
+    encoder.begin(0);
+    encoder.addArea(0, stats);
+    encoder.addArea(static_cast<int>(thermal::MAX_MEASUREMENT_AREAS) + 1, stats);
+    encoder.addArea(2, AreaStatistics());
+    EXPECT_EQ(encoder.finish(), bytes({0x08, 0x00, 0x12, 0x00}));
+
+    encoder.begin(0);
+    encoder.addArea(2, stats);
+    std::string expected_values = bytes({0xD9, 0xE2, 0x09, 0, 0, 0, 0, 0, 0, 0, 0x40})   // 20011 area_2_max_temp
+        + bytes({0xE0, 0xE2, 0x09, 0x01})                                               // 20012 area_2_max_x
+        + bytes({0xE8, 0xE2, 0x09, 0x02})                                               // 20013 area_2_max_y
+        + bytes({0xF1, 0xE2, 0x09, 0, 0, 0, 0, 0, 0, 0xE0, 0x3F})                       // 20014 area_2_mean_temp
+        + bytes({0xF9, 0xE2, 0x09, 0, 0, 0, 0, 0, 0, 0, 0});                            // 20015 area_2_min_temp
+    EXPECT_EQ(encoder.finish(), bytes({0x08, 0x00, 0x12, static_cast<unsigned char>(expected_values.size())})
+                                    + expected_values);
+}
+
+// Test the RpcResponseMsg wrapper, including a multi-byte length
+TEST(ProtobufEncoderTest, EncodesRpcResponse) {
+    EXPECT_EQ(ProtobufTelemetryEncoder::encodeRpcResponse("{}"), bytes({0x0A, 0x02, '{', '}'}));
+
+    std::string response(200, 'x');
+    EXPECT_EQ(ProtobufTelemetryEncoder::encodeRpcResponse(response), bytes({0x0A, 0xC8, 0x01}) + response);
+}
+
+// Test that a typical batch is well under half the size of its JSON form
+TEST(ProtobufEncoderTest, SmallerThanJson) {
+    ProtobufTelemetryEncoder protobuf;
+    TelemetryEncoder json;
+    protobuf.begin(1700000000000);
+    json.begin(1700000000000);
+    for (int spot = 1; spot <= 10; ++spot) {
+        protobuf.addSpot(spot, 20.0 + spot * 1.37);
+        json.addSpot(spot, 20.0 + spot * 1.37);
+    }
+    EXPECT_LT(protobuf.finish().size() * 2, json.finish().size());
+}
@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+#include "thingsboard/rpc/rpc_engine.h"
+#include "common/timer_wheel.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace thermal;
+using namespace std::chrono_literals;
+
+namespace {
+
+RPCCommand makeCommand(const std::string& request_id, RPCMethod method, const std::string& spot_id,
+                       int timeout_ms = 5000) {
+    RPCCommand command;
+    command.requestId = request_id;
+    command.method = method;
+    switch (method) {
+        case RPCMethod::CREATE_SPOT_MEASUREMENT: command.arguments = CreateSpotArgs{spot_id, 0, 0}; break;
+        case RPCMethod::MOVE_SPOT_MEASUREMENT: command.arguments = MoveSpotArgs{spot_id, 0, 0}; break;
+        case RPCMethod::DELETE_SPOT_MEASUREMENT: command.arguments = DeleteSpotArgs{spot_id}; break;
+        case RPCMethod::GET_SPOT_TEMPERATURE: command.arguments = GetSpotTemperatureArgs{spot_id}; break;
+        default: command.arguments = ListSpotsArgs{}; break;
+    }
+    command.timeoutMs = timeout_ms;
+    return command;
+}
+
+} // namespace
+
+// Test that timers fire on the first tick at or after their deadline, across rounds
+TEST(TimerWheelTest, ExpiresAtDeadline) {
+    auto start = TimerWheel::Clock::time_point();
+    TimerWheel wheel(10ms, 4, start);
+    wheel.schedule(1, start + 25ms);
+    wheel.schedule(2, start + 95ms);  // More than one turn of the wheel
+    EXPECT_EQ(wheel.size(), 2u);
+
+    std::vector<std::uint64_t> expired;
+    EXPECT_EQ(wheel.advance(start + 29ms, expired), 0u);
+    EXPECT_EQ(wheel.advance(start + 30ms, expired), 1u);
+    EXPECT_EQ(expired, std::vector<std::uint64_t>{1});
+
+    expired.clear();
+    EXPECT_EQ(wheel.advance(start + 90ms, expired), 0u);
+    EXPECT_EQ(wheel.advance(start + 100ms, expired), 1u);
+    EXPECT_EQ(expired, std::vector<std::uint64_t>{2});
+    EXPECT_TRUE(wheel.empty());
+
+    // Past deadlines fire on the next tick
+    wheel.schedule(3, start);
+    expired.clear();
+    EXPECT_EQ(wheel.advance(start + 110ms, expired), 1u);
+}
+
+// Test that read-only commands run concurrently
+TEST(RPCEngineTest, ReadOnlyCommandsRunInParallel) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    int running = 0;
+    bool overlapped = false;
+
+    RPCEngine engine(2, [&](const RPCCommand&) {
+        std::unique_lock<std::mutex> lock(mutex);
+        running++;
+        cv.notify_all();
+        overlapped = cv.wait_for(lock, 2s, [&] { return running == 2; });
+    }, [](const RPCResponse&) {});
+
+    ASSERT_EQ(engine.submit(makeCommand("1", RPCMethod::GET_SPOT_TEMPERATURE, "1")), RPCAdmission::ACCEPTED);
+    ASSERT_EQ(engine.submit(makeCommand("2", RPCMethod::LIST_SPOT_MEASUREMENTS, "")), RPCAdmission::ACCEPTED);
+    engine.shutdown();
+    EXPECT_TRUE(overlapped);
+}
+
+// Test that mutations of one spot run one at a time in arrival order
+TEST(RPCEngineTest, MutationsSerializedPerSpot) {
+    std::mutex mutex;
+    std::vector<std::string> order;
+    std::atomic<int> active{0};
+    std::atomic<bool> overlapped{false};
+
+    RPCEngine engine(4, [&](const RPCCommand& command) {
+        if (active.fetch_add(1) != 0) {
+            overlapped = true;
+        }
+        std::this_thread::sleep_for(2ms);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(command.requestId);
+        }
+        active--;
+    }, [](const RPCResponse&) {});
+
+    EXPECT_EQ(engine.submit(makeCommand("1", RPCMethod::CREATE_SPOT_MEASUREMENT, "3")), RPCAdmission::ACCEPTED);
+    EXPECT_EQ(engine.submit(makeCommand("2", RPCMethod::MOVE_SPOT_MEASUREMENT, "3")), RPCAdmission::ACCEPTED);
+    EXPECT_EQ(engine.submit(makeCommand("3", RPCMethod::DELETE_SPOT_MEASUREMENT, "3")), RPCAdmission::ACCEPTED);
+    engine.shutdown();
+
+    EXPECT_FALSE(overlapped);
+    EXPECT_EQ(order, (std::vector<std::string>{"1", "2", "3"}));
+    EXPECT_EQ(engine.getStats().completed, 3u);
+}
+
+// Test that a spot batch waits for running mutations and holds back later ones
+TEST(RPCEngineTest, SpotBatchOrderedAcrossLanes) {
+    std::mutex mutex;
+    std::vector<std::string> events;
+
+    RPCEngine engine(4, [&](const RPCCommand& command) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            events.push_back("+" + command.requestId);
+        }
+        std::this_thread::sleep_for(10ms);
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back("-" + command.requestId);
+    }, [](const RPCResponse&) {});
+
+    RPCCommand batch = makeCommand("2", RPCMethod::APPLY_SPOT_BATCH, "");
+    batch.arguments = ApplySpotBatchArgs{};
+    EXPECT_EQ(engine.submit(makeCommand("1", RPCMethod::MOVE_SPOT_MEASUREMENT, "1")), RPCAdmission::ACCEPTED);
+    EXPECT_EQ(engine.submit(batch), RPCAdmission::ACCEPTED);
+    EXPECT_EQ(engine.submit(makeCommand("3", RPCMethod::MOVE_SPOT_MEASUREMENT, "2")), RPCAdmission::ACCEPTED);
+    engine.shutdown();
+
+    EXPECT_EQ(events, (std::vector<std::string>{"+1", "-1", "+2", "-2", "+3", "-3"}));
+    EXPECT_EQ(engine.getStats().completed, 3u);
+}
+
+// Test that an expired deadline sends TIMEOUT, drops the late response and skips queued work
+TEST(RPCEngineTest, TimeoutAnswersOnce) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool released = false;
+    std::vector<RPCResponse> timeouts;
+    std::vector<std::string> executed;
+    RPCEngine* engine_ptr = nullptr;
+    std::vector<bool> claims;
+
+    RPCEngine engine(2, [&](const RPCCommand& command) {
+        std::unique_lock<std::mutex> lock(mutex);
+        executed.push_back(command.requestId);
+        cv.wait(lock, [&] { return released; });
+        claims.push_back(engine_ptr->claimResponse(command.requestId));
+    }, [&](const RPCResponse& response) {
+        std::lock_guard<std::mutex> lock(mutex);
+        timeouts.push_back(response);
+        cv.notify_all();
+    });
+    engine_ptr = &engine;
+
+    // "2" waits behind "1" on spot 5's lane and times out while queued
+    ASSERT_EQ(engine.submit(makeCommand("1", RPCMethod::MOVE_SPOT_MEASUREMENT, "5", 50)), RPCAdmission::ACCEPTED);
+    ASSERT_EQ(engine.submit(makeCommand("2", RPCMethod::DELETE_SPOT_MEASUREMENT, "5", 50)), RPCAdmission::ACCEPTED);
+    EXPECT_EQ(engine.submit(makeCommand("1", RPCMethod::MOVE_SPOT_MEASUREMENT, "5")), RPCAdmission::REJECTED);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, 2s, [&] { return timeouts.size() == 2; }));
+        released = true;
+        cv.notify_all();
+    }
+    engine.shutdown();
+
+    for (const auto& response : timeouts) {
+        EXPECT_EQ(response.errorCode, RPCErrorCodes::TIMEOUT);
+        EXPECT_EQ(response.responseTimeMs, 50);
+    }
+    EXPECT_EQ(executed, std::vector<std::string>{"1"});
+    EXPECT_EQ(claims, std::vector<bool>{false});
+
+    auto stats = engine.getStats();
+    EXPECT_EQ(stats.timed_out, 2u);
+    EXPECT_EQ(stats.skipped, 1u);
+    EXPECT_EQ(stats.in_flight, 0u);
+}
+
+// Test that a prompt response is claimed and no TIMEOUT follows
+TEST(RPCEngineTest, ClaimedResponseCancelsTimeout) {
+    std::atomic<int> timeouts{0};
+    std::atomic<bool> claimed{false};
+    RPCEngine* engine_ptr = nullptr;
+
+    RPCEngine engine(1, [&](const RPCCommand& command) {
+        claimed = engine_ptr->claimResponse(command.requestId);
+    }, [&](const RPCResponse&) { timeouts++; });
+    engine_ptr = &engine;
+
+    ASSERT_EQ(engine.submit(makeCommand("7", RPCMethod::GET_SPOT_TEMPERATURE, "1", 30)), RPCAdmission::ACCEPTED);
+    std::this_thread::sleep_for(100ms);
+    engine.shutdown();
+
+    EXPECT_TRUE(claimed);
+    EXPECT_EQ(timeouts.load(), 0);
+    EXPECT_FALSE(engine.claimResponse("7"));
+}
+
+// Test that each admission limit refuses with a retry hint instead of queuing
+TEST(RPCEngineTest, AdmissionLimits) {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool released = false;
+    auto blocking = [&](const RPCCommand&) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [&] { return released; });
+    };
+    auto release = [&] {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+        cv.notify_all();
+    };
+
+    // Per-method limit: the third move is refused while two are pending
+    {
+        RPCAdmissionLimits limits;
+        limits.max_pending_per_method = 2;
+        limits.rate_per_second = 0.0;
+        released = false;
+        RPCEngine engine(1, blocking, [](const RPCResponse&) {}, limits);
+        EXPECT_EQ(engine.submit(makeCommand("1", RPCMethod::MOVE_SPOT_MEASUREMENT, "1")), RPCAdmission::ACCEPTED);
+        EXPECT_EQ(engine.submit(makeCommand("2", RPCMethod::MOVE_SPOT_MEASUREMENT, "2")), RPCAdmission::ACCEPTED);
+        int retry_after_ms = 0;
+        EXPECT_EQ(engine.submit(makeCommand("3", RPCMethod::MOVE_SPOT_MEASUREMENT, "3"), &retry_after_ms),
+                  RPCAdmission::BUSY);
+        EXPECT_GE(retry_after_ms, RPCEngine::MIN_RETRY_AFTER_MS);
+        EXPECT_EQ(engine.submit(makeCommand("4", RPCMethod::LIST_SPOT_MEASUREMENTS, "")), RPCAdmission::ACCEPTED);
+        release();
+        engine.shutdown();
+        EXPECT_EQ(engine.getStats().rejected_busy, 1u);
+        EXPECT_EQ(engine.getStats().completed, 3u);
+    }
+
+    // Queue depth: only one command may wait behind the running one
+    {
+        RPCAdmissionLimits limits;
+        limits.max_queue_depth = 1;
+        limits.rate_per_second = 0.0;
+        released = false;
+        std::atomic<bool> started{false};
+        RPCEngine engine(1, [&](const RPCCommand& command) {
+            started = true;
+            blocking(command);
+        }, [](const RPCResponse&) {}, limits);
+        EXPECT_EQ(engine.submit(makeCommand("1", RPCMethod::GET_SPOT_TEMPERATURE, "1")), RPCAdmission::ACCEPTED);
+        while (!started) {
+            std::this_thread::yield();
+        }
+        EXPECT_EQ(engine.submit(makeCommand("2", RPCMethod::GET_SPOT_TEMPERATURE, "1")), RPCAdmission::ACCEPTED);
+        EXPECT_EQ(engine.submit(makeCommand("3", RPCMethod::GET_SPOT_TEMPERATURE, "1")), RPCAdmission::BUSY);
+        release();
+        engine.shutdown();
+    }
+
+    // Token bucket: a burst of 2 at 1/s refuses the third with a ~1 s hint
+    {
+        RPCAdmissionLimits limits;
+        limits.rate_per_second = 1.0;
+        limits.burst = 2.0;
+        RPCEngine engine(1, [](const RPCCommand&) {}, [](const RPCResponse&) {}, limits);
+        EXPECT_EQ(engine.submit(makeCommand("1", RPCMethod::GET_SPOT_TEMPERATURE, "1")), RPCAdmission::ACCEPTED);
+        EXPECT_EQ(engine.submit(makeCommand("2", RPCMethod::GET_SPOT_TEMPERATURE, "1")), RPCAdmission::ACCEPTED);
+        int retry_after_ms = 0;
+        EXPECT_EQ(engine.submit(makeCommand("3", RPCMethod::GET_SPOT_TEMPERATURE, "1"), &retry_after_ms),
+                  RPCAdmission::BUSY);
+        EXPECT_GT(retry_after_ms, 900);
+        EXPECT_LE(retry_after_ms, 1000);
+        engine.shutdown();
+    }
+}
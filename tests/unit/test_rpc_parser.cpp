@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "thingsboard/rpc/rpc_parser.h"
+
+using namespace thermal;
+
+// Test that each method's parameters end up in its typed arguments
+TEST(RPCParserTest, ParsesTypedArguments) {
+    auto create = RPCParser::parseCommand("1", R"({"method":"createSpotMeasurement","params":{"x":10,"y":20}})");
+    EXPECT_EQ(RPCParser::validateCommand(create), "");
+    ASSERT_TRUE(std::holds_alternative<CreateSpotArgs>(create.arguments));
+    EXPECT_EQ(std::get<CreateSpotArgs>(create.arguments).spotId, "");
+    EXPECT_EQ(std::get<CreateSpotArgs>(create.arguments).x, 10);
+    EXPECT_EQ(std::get<CreateSpotArgs>(create.arguments).y, 20);
+    EXPECT_EQ(create.requestId, "1");
+    EXPECT_EQ(create.status, RPCStatus::PENDING);
+
+    auto move = RPCParser::parseCommand(
+        "2", R"({"method":"moveSpotMeasurement","params":{"spotId":"3","x":319,"y":239},"timeout":2000})");
+    ASSERT_TRUE(std::holds_alternative<MoveSpotArgs>(move.arguments));
+    EXPECT_EQ(std::get<MoveSpotArgs>(move.arguments).spotId, "3");
+    EXPECT_EQ(move.spotId(), "3");
+    EXPECT_EQ(move.timeoutMs, 2000);
+
+    auto get = RPCParser::parseCommand("3", R"({"method":"getSpotTemperature","params":{"spotId":"7"}})");
+    EXPECT_EQ(RPCParser::validateCommand(get), "");
+    EXPECT_EQ(get.spotId(), "7");
+
+    auto list = RPCParser::parseCommand("4", R"({"method":"listSpotMeasurements"})");
+    EXPECT_TRUE(std::holds_alternative<ListSpotsArgs>(list.arguments));
+    EXPECT_EQ(list.spotId(), "");
+}
+
+// Test that invalid commands carry their error and no arguments
+TEST(RPCParserTest, RecordsValidationErrors) {
+    struct Case {
+        const char* payload;
+        std::string error;
+    };
+    const Case cases[] = {
+        {"{not json", "Invalid JSON payload"},
+        {R"({"params":{}})", "Missing or invalid 'method' field"},
+        {R"({"method":"rebootCamera"})", "Unknown RPC method"},
+        {R"({"method":"listSpotMeasurements","timeout":100})",
+         "Invalid timeout value: must be between 1000 and 30000 milliseconds"},
+        {R"({"method":"createSpotMeasurement","params":{"x":10}})", "Missing or invalid 'y' coordinate parameter"},
+        {R"({"method":"createSpotMeasurement","params":{"spotId":"0","x":1,"y":1}})",
+         RPCParser::INVALID_SPOT_ID_MESSAGE},
+        {R"({"method":"moveSpotMeasurement","params":{"spotId":"1","x":320,"y":0}})",
+         "Invalid coordinates: x must be 0-319, y must be 0-239"},
+        {R"({"method":"deleteSpotMeasurement","params":{"spotId":5}})", "Missing or invalid 'spotId' parameter"},
+        {R"({"method":"getSpotTemperature","params":"5"})", "Missing or invalid 'spotId' parameter"},
+    };
+
+    for (const auto& test_case : cases) {
+        auto command = RPCParser::parseCommand("9", test_case.payload);
+        EXPECT_EQ(command.status, RPCStatus::ERROR) << test_case.payload;
+        EXPECT_EQ(RPCParser::validateCommand(command), test_case.error) << test_case.payload;
+        EXPECT_TRUE(std::holds_alternative<std::monostate>(command.arguments)) << test_case.payload;
+    }
+}
+
+// Test that batch operations parse in order into their typed arguments
+TEST(RPCParserTest, ParsesSpotBatch) {
+    auto batch = RPCParser::parseCommand("5", R"({"method":"applySpotBatch","params":{"operations":[
+        {"op":"create","x":1,"y":2},
+        {"op":"move","spotId":"4","x":3,"y":4},
+        {"op":"delete","spotId":"4"}]}})");
+    EXPECT_EQ(RPCParser::validateCommand(batch), "");
+    EXPECT_EQ(batch.spotId(), "");
+    ASSERT_TRUE(std::holds_alternative<ApplySpotBatchArgs>(batch.arguments));
+    const auto& operations = std::get<ApplySpotBatchArgs>(batch.arguments).operations;
+    ASSERT_EQ(operations.size(), 3u);
+    EXPECT_EQ(std::get<CreateSpotArgs>(operations[0]).y, 2);
+    EXPECT_EQ(std::get<MoveSpotArgs>(operations[1]).x, 3);
+    EXPECT_EQ(std::get<DeleteSpotArgs>(operations[2]).spotId, "4");
+}
+
+// Test that one invalid operation rejects the whole batch, naming its index
+TEST(RPCParserTest, RejectsInvalidSpotBatch) {
+    struct Case {
+        const char* params;
+        std::string error;
+    };
+    const Case cases[] = {
+        {R"({})", "Missing or invalid 'operations' parameter: must be a non-empty array"},
+        {R"({"operations":[]})", "Missing or invalid 'operations' parameter: must be a non-empty array"},
+        {R"({"operations":[{"op":"delete","spotId":"1"},{"x":1,"y":1}]})",
+         "operations[1]: Missing or invalid 'op' parameter"},
+        {R"({"operations":[{"op":"rename","spotId":"1"}]})",
+         "operations[0]: Unknown op 'rename': must be create, move or delete"},
+        {R"({"operations":[{"op":"create","x":1,"y":1},{"op":"move","spotId":"1","x":-1,"y":1}]})",
+         "operations[1]: Invalid coordinates: x must be 0-319, y must be 0-239"},
+    };
+
+    for (const auto& test_case : cases) {
+        auto command = RPCParser::parseCommand(
+            "9", std::string(R"({"method":"applySpotBatch","params":)") + test_case.params + "}");
+        EXPECT_EQ(RPCParser::validateCommand(command), test_case.error) << test_case.params;
+        EXPECT_TRUE(std::holds_alternative<std::monostate>(command.arguments)) << test_case.params;
+    }
+
+    nlohmann::json too_many = {{"method", "applySpotBatch"}, {"params", {{"operations", nlohmann::json::array()}}}};
+    for (size_t i = 0; i <= RPCParser::MAX_BATCH_OPERATIONS; ++i) {
+        too_many["params"]["operations"].push_back({{"op", "delete"}, {"spotId", "1"}});
+    }
+    auto command = RPCParser::parseCommand("10", too_many.dump());
+    EXPECT_EQ(RPCParser::validateCommand(command),
+              "Too many operations: at most " + std::to_string(RPCParser::MAX_BATCH_OPERATIONS) + " per batch");
+}
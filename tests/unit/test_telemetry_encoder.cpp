@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include "thingsboard/telemetry_encoder.h"
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using thermal::AreaStatistics;
+using thermal::FrameExtremes;
+using thermal::TelemetryEncoder;
+
+namespace {
+
+// The nlohmann::json payload the encoder replaces
+std::string json_payload(std::int64_t ts, const std::vector<std::pair<int, double>>& spots,
+                         const FrameExtremes* extremes) {
+    nlohmann::json ts_data;
+    ts_data["ts"] = ts;
+    nlohmann::json& values = ts_data["values"];
+    values = nlohmann::json::object();
+    for (const auto& spot : spots) {
+        values["temperature_spot_" + std::to_string(spot.first)] = spot.second;
+    }
+    if (extremes) {
+        values["frame_max_temp"] = extremes->max_temp;
+        values["frame_max_x"] = extremes->max_location.x;
+        values["frame_max_y"] = extremes->max_location.y;
+        values["frame_min_temp"] = extremes->min_temp;
+        values["frame_min_x"] = extremes->min_location.x;
+        values["frame_min_y"] = extremes->min_location.y;
+    }
+    return ts_data.dump();
+}
+
+std::string encoded_payload(TelemetryEncoder& encoder, std::int64_t ts,
+                            const std::vector<std::pair<int, double>>& spots, const FrameExtremes* extremes) {
+    encoder.begin(ts);
+    for (const auto& spot : spots) {
+        encoder.addSpot(spot.first, spot.second);
+    }
+    if (extremes) {
+        encoder.addFrameExtremes(*extremes);
+    }
+    return encoder.finish();
+}
+
+FrameExtremes make_extremes(float max_temp, float min_temp) {
+    FrameExtremes extremes;
+    extremes.valid = true;
+    extremes.max_temp = max_temp;
+    extremes.max_location = {12, 7};
+    extremes.min_temp = min_temp;
+    extremes.min_location = {0, 143};
+    return extremes;
+}
+
+} // namespace
+
+// Test the single reading payload without a timestamp
+TEST(TelemetryEncoderTest, EncodesReading) {
+    TelemetryEncoder encoder;
+    EXPECT_EQ(encoder.encodeReading(3, 25.5), "{\"temperature_spot_3\":25.5}");
+
+    for (double temperature : {25.0, -0.0, 0.1, -40.25, 36.6, 1e-7, 123456789.125}) {
+        nlohmann::json telemetry;
+        telemetry["temperature_spot_12"] = temperature;
+        EXPECT_EQ(encoder.encodeReading(12, temperature), telemetry.dump()) << temperature;
+    }
+}
+
+// Test key order, overwritten duplicates, extremes and non-finite values
+TEST(TelemetryEncoderTest, MatchesJsonKeyOrderAndDuplicates) {
+    TelemetryEncoder encoder;
+    FrameExtremes extremes = make_extremes(36.7f, -5.3f);
+    std::vector<std::pair<int, double>> spots = {
+        {2, 21.5}, {10, 22.0}, {1, 20.75}, {2, 23.125}, {-4, 19.0}, {100, 18.5}};
+
+    EXPECT_EQ(encoded_payload(encoder, 1700000000123, spots, &extremes),
+              json_payload(1700000000123, spots, &extremes));
+    EXPECT_EQ(encoded_payload(encoder, 0, spots, nullptr), json_payload(0, spots, nullptr));
+    EXPECT_EQ(encoded_payload(encoder, 5, {}, &extremes), json_payload(5, {}, &extremes));
+    EXPECT_EQ(encoded_payload(encoder, 5, {}, nullptr), "{\"ts\":5,\"values\":{}}");
+
+    std::vector<std::pair<int, double>> special = {
+        {1, std::numeric_limits<double>::quiet_NaN()},
+        {2, std::numeric_limits<double>::infinity()},
+        {3, -0.0}};
+    EXPECT_EQ(encoded_payload(encoder, -1, special, nullptr), json_payload(-1, special, nullptr));
+}
+
+// Test area keys alongside spots and extremes, including duplicates and invalid areas
+TEST(TelemetryEncoderTest, MatchesJsonWithAreas) {
+    TelemetryEncoder encoder;
+    FrameExtremes extremes = make_extremes(36.7f, -5.3f);
+    auto make_area = [](float max_temp, double mean_temp, float min_temp) {
+        AreaStatistics stats;
+        stats.valid = true;
+        stats.max_temp = max_temp;
+        stats.hottest = {17, 4};
+        stats.mean_temp = mean_temp;
+        stats.min_temp = min_temp;
+        return stats;
+    };
+    std::vector<std::pair<int, AreaStatistics>> areas = {
+        {10, make_area(41.25f, 30.123456789, 22.5f)},
+        {1, make_area(25.5f, 24.0, 23.1f)},
+        {2, AreaStatistics()},                      // Not valid, left out
+        {1, make_area(26.5f, 24.5, 23.3f)}};        // Replaces the first area 1
+
+    encoder.begin(1700000000123);
+    encoder.addSpot(3, 21.5);
+    for (const auto& area : areas) {
+        encoder.addArea(area.first, area.second);
+    }
+    encoder.addFrameExtremes(extremes);
+
+    nlohmann::json expected = nlohmann::json::parse(json_payload(1700000000123, {{3, 21.5}}, &extremes));
+    nlohmann::json& values = expected["values"];
+    for (const auto& area : areas) {
+        if (!area.second.valid) {
+            continue;
+        }
+        const std::string prefix = "area_" + std::to_string(area.first) + "_";
+        values[prefix + "max_temp"] = area.second.max_temp;
+        values[prefix + "max_x"] = area.second.hottest.x;
+        values[prefix + "max_y"] = area.second.hottest.y;
+        values[prefix + "mean_temp"] = area.second.mean_temp;
+        values[prefix + "min_temp"] = area.second.min_temp;
+    }
+    EXPECT_EQ(encoder.finish(), expected.dump());
+
+    // Areas alone
+    encoder.begin(5);
+    encoder.addArea(7, make_area(1.0f, 0.5, 0.0f));
+    EXPECT_EQ(encoder.finish(), "{\"ts\":5,\"values\":{\"area_7_max_temp\":1.0,\"area_7_max_x\":17,"
+                                "\"area_7_max_y\":4,\"area_7_mean_temp\":0.5,\"area_7_min_temp\":0.0}}");
+}
+
+// Test byte-for-byte equivalence over many random batches
+TEST(TelemetryEncoderTest, MatchesJsonForRandomBatches) {
+    TelemetryEncoder encoder(16);  // Small start so the buffer has to grow
+    std::mt19937_64 rng(20240611);
+    std::uniform_real_distribution<double> temperature(-100.0, 500.0);
+    std::uniform_int_distribution<int> spot_id(0, 40);
+    std::uniform_int_distribution<int> spot_count(0, 24);
+
+    for (int round = 0; round < 2000; ++round) {
+        std::vector<std::pair<int, double>> spots;
+        int count = spot_count(rng);
+        for (int i = 0; i < count; ++i) {
+            double value = temperature(rng);
+            switch (i % 3) {
+                case 0: value = std::round(value * 100.0) / 100.0; break;   // Typical 2-decimal reading
+                case 1: value = static_cast<float>(value); break;           // Float sensor value
+                default: break;                                             // Full precision
+            }
+            spots.push_back({spot_id(rng), value});
+        }
+
+        FrameExtremes extremes = make_extremes(static_cast<float>(temperature(rng)),
+                                               static_cast<float>(temperature(rng)));
+        const FrameExtremes* with_extremes = (round % 2 == 0) ? &extremes : nullptr;
+        std::int64_t ts = 1700000000000 + round;
+        ASSERT_EQ(encoded_payload(encoder, ts, spots, with_extremes), json_payload(ts, spots, with_extremes));
+    }
+}
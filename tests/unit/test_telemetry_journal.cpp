@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "thingsboard/telemetry_journal.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace thermal;
+
+class TelemetryJournalTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::filesystem::remove_all(dir_);
+        options_.directory = dir_;
+        options_.segment_bytes = 256;
+        options_.max_bytes = 4096;
+        options_.sync_every_records = 4;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    static std::string payload(int i) {
+        return "{\"ts\":" + std::to_string(1000 + i) + ",\"values\":{\"temperature_spot_1\":" +
+               std::to_string(20 + i) + "}}";
+    }
+
+    size_t segmentFiles() const {
+        size_t count = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(dir_)) {
+            if (entry.path().extension() == ".log") {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    std::string dir_ = "/tmp/test_telemetry_journal";
+    JournalOptions options_;
+};
+
+// Test that records come back oldest first, across segment boundaries
+TEST_F(TelemetryJournalTest, ReplaysInOrderAcrossSegments) {
+    TelemetryJournal journal(options_);
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(journal.append(1000 + i, payload(i)));
+    }
+    EXPECT_EQ(journal.pendingRecords(), 20u);
+    EXPECT_GT(segmentFiles(), 1u);
+
+    std::vector<JournalRecord> records;
+    int next = 0;
+    while (!journal.empty()) {
+        size_t n = journal.peek(3, 1 << 20, records);
+        ASSERT_GT(n, 0u);
+        for (const auto& record : records) {
+            EXPECT_EQ(record.timestamp_ms, 1000 + next);
+            EXPECT_EQ(record.payload, payload(next));
+            ++next;
+        }
+        journal.consume(n);
+    }
+    EXPECT_EQ(next, 20);
+    // Replayed segments are deleted, only the one being written remains
+    EXPECT_EQ(segmentFiles(), 1u);
+}
+
+// Test that peek honors the byte budget but always returns one record
+TEST_F(TelemetryJournalTest, PeekRespectsByteBudget) {
+    TelemetryJournal journal(options_);
+    for (int i = 0; i < 5; ++i) {
+        journal.append(i, payload(i));
+    }
+
+    std::vector<JournalRecord> records;
+    EXPECT_EQ(journal.peek(10, 1, records), 1u);
+    EXPECT_EQ(journal.peek(10, payload(0).size() * 2, records), 2u);
+    EXPECT_EQ(journal.pendingRecords(), 5u);
+}
+
+// Test that the replay position survives a restart
+TEST_F(TelemetryJournalTest, ResumesAfterReopen) {
+    {
+        TelemetryJournal journal(options_);
+        for (int i = 0; i < 10; ++i) {
+            journal.append(1000 + i, payload(i));
+        }
+        journal.consume(4);
+    }
+
+    TelemetryJournal reopened(options_);
+    EXPECT_EQ(reopened.pendingRecords(), 6u);
+    std::vector<JournalRecord> records;
+    ASSERT_EQ(reopened.peek(1, 1 << 20, records), 1u);
+    EXPECT_EQ(records[0].timestamp_ms, 1004);
+}
+
+// Test that a torn record at the end of a segment is cut off on reopen
+TEST_F(TelemetryJournalTest, DiscardsTornTail) {
+    options_.segment_bytes = 4096;
+    {
+        TelemetryJournal journal(options_);
+        journal.append(1, payload(1));
+        journal.append(2, payload(2));
+    }
+
+    std::filesystem::path segment;
+    for (const auto& entry : std::filesystem::directory_iterator(dir_)) {
+        if (entry.path().extension() == ".log" && std::filesystem::file_size(entry.path()) > 0) {
+            segment = entry.path();
+        }
+    }
+    ASSERT_FALSE(segment.empty());
+    std::filesystem::resize_file(segment, std::filesystem::file_size(segment) - 5);
+
+    TelemetryJournal reopened(options_);
+    EXPECT_EQ(reopened.pendingRecords(), 1u);
+    std::vector<JournalRecord> records;
+    ASSERT_EQ(reopened.peek(10, 1 << 20, records), 1u);
+    EXPECT_EQ(records[0].payload, payload(1));
+}
+
+// Test that the disk budget drops the oldest segments
+TEST_F(TelemetryJournalTest, BoundsDiskUsage) {
+    options_.max_bytes = 1024;
+    TelemetryJournal journal(options_);
+    for (int i = 0; i < 100; ++i) {
+        journal.append(1000 + i, payload(i));
+    }
+
+    EXPECT_LE(journal.diskBytes(), options_.max_bytes);
+    EXPECT_GT(journal.droppedRecords(), 0u);
+    EXPECT_EQ(journal.pendingRecords() + journal.droppedRecords(), 100u);
+
+    // What is left is the newest data
+    std::vector<JournalRecord> records;
+    journal.peek(1000, 1 << 20, records);
+    ASSERT_FALSE(records.empty());
+    EXPECT_EQ(records.back().timestamp_ms, 1099);
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "thingsboard/telemetry_publisher.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace thermal;
+
+// Test FIFO order and capacity rounding of the ring buffer
+TEST(BoundedQueueTest, FifoAndCapacity) {
+    BoundedQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8u);
+
+    for (int i = 0; i < 8; ++i) {
+        int value = i;
+        EXPECT_TRUE(queue.tryPush(value));
+    }
+    int overflow = 99;
+    EXPECT_FALSE(queue.tryPush(overflow));
+    EXPECT_EQ(queue.size(), 8u);
+
+    for (int i = 0; i < 8; ++i) {
+        int value = -1;
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    int value = -1;
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+// Test that concurrent producers lose nothing
+TEST(BoundedQueueTest, ConcurrentProducers) {
+    BoundedQueue<int> queue(1024);
+    const int per_producer = 10000;
+    std::atomic<long long> sum{0};
+    std::atomic<int> popped{0};
+
+    std::thread consumer([&] {
+        int value = 0;
+        while (popped < 4 * per_producer) {
+            if (queue.tryPop(value)) {
+                sum += value;
+                popped++;
+            }
+        }
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&] {
+            for (int i = 1; i <= per_producer; ++i) {
+                int value = i;
+                while (!queue.tryPush(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    consumer.join();
+
+    EXPECT_EQ(sum.load(), 4LL * per_producer * (per_producer + 1) / 2);
+}
+
+// Test policy string conversion
+TEST(TelemetryPublisherTest, PolicyStrings) {
+    EXPECT_EQ(overflowPolicyFromString("drop_oldest"), OverflowPolicy::DROP_OLDEST);
+    EXPECT_EQ(overflowPolicyFromString("drop_newest"), OverflowPolicy::DROP_NEWEST);
+    EXPECT_EQ(overflowPolicyFromString("block"), OverflowPolicy::BLOCK);
+    EXPECT_EQ(overflowPolicyToString(OverflowPolicy::BLOCK), "block");
+    EXPECT_THROW(overflowPolicyFromString("drop_all"), std::invalid_argument);
+}
+
+class TelemetryPublisherOverflowTest : public ::testing::Test {
+protected:
+    // The publish function holds the publisher thread until released
+    TelemetryPublisher::PublishFunction gatedPublish() {
+        return [this](const std::string& payload, std::int64_t) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            in_publish_ = true;
+            cv_.notify_all();
+            cv_.wait(lock, [this] { return released_; });
+            published_.push_back(payload);
+            return true;
+        };
+    }
+
+    void waitUntilPublishing() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return in_publish_; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released_ = true;
+        cv_.notify_all();
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool in_publish_ = false;
+    bool released_ = false;
+    std::vector<std::string> published_;
+};
+
+// Test that drop-oldest keeps the newest messages
+TEST_F(TelemetryPublisherOverflowTest, DropOldest) {
+    TelemetryPublisher publisher(2, OverflowPolicy::DROP_OLDEST, gatedPublish());
+    publisher.enqueue("m0", 0);
+    waitUntilPublishing();  // m0 is taken; the queue is empty again
+
+    for (int i = 1; i <= 4; ++i) {
+        EXPECT_TRUE(publisher.enqueue("m" + std::to_string(i), i));
+    }
+    auto stats = publisher.getStats();
+    EXPECT_EQ(stats.depth, 2u);
+    EXPECT_EQ(stats.dropped_oldest, 2u);
+
+    release();
+    publisher.stop();
+    EXPECT_EQ(published_, (std::vector<std::string>{"m0", "m3", "m4"}));
+    EXPECT_EQ(publisher.getStats().published, 3u);
+}
+
+// Test that drop-newest rejects messages while full
+TEST_F(TelemetryPublisherOverflowTest, DropNewest) {
+    TelemetryPublisher publisher(2, OverflowPolicy::DROP_NEWEST, gatedPublish());
+    publisher.enqueue("m0", 0);
+    waitUntilPublishing();
+
+    EXPECT_TRUE(publisher.enqueue("m1", 1));
+    EXPECT_TRUE(publisher.enqueue("m2", 2));
+    EXPECT_FALSE(publisher.enqueue("m3", 3));
+    EXPECT_EQ(publisher.getStats().dropped_newest, 1u);
+
+    release();
+    publisher.stop();
+    EXPECT_EQ(published_, (std::vector<std::string>{"m0", "m1", "m2"}));
+}
+
+// Test that block waits for room instead of dropping
+TEST_F(TelemetryPublisherOverflowTest, BlockWaitsForRoom) {
+    TelemetryPublisher publisher(2, OverflowPolicy::BLOCK, gatedPublish());
+    publisher.enqueue("m0", 0);
+    waitUntilPublishing();
+    publisher.enqueue("m1", 1);
+    publisher.enqueue("m2", 2);
+
+    std::atomic<bool> done{false};
+    std::thread producer([&] {
+        publisher.enqueue("m3", 3);
+        done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(done);
+
+    release();
+    producer.join();
+    publisher.stop();
+    EXPECT_EQ(published_, (std::vector<std::string>{"m0", "m1", "m2", "m3"}));
+    EXPECT_EQ(publisher.getStats().dropped_newest, 0u);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "thingsboard/telemetry_window.h"
+#include <nlohmann/json.hpp>
+#include <string>
+
+using thermal::TelemetryWindow;
+
+namespace {
+
+std::string makeEntry(long long ts, double temperature) {
+    nlohmann::json entry;
+    entry["ts"] = ts;
+    entry["values"]["temperature_spot_1"] = temperature;
+    return entry.dump();
+}
+
+} // namespace
+
+// Test that a disabled window reports so and never becomes due on its own
+TEST(TelemetryWindowTest, DisabledByDefault) {
+    TelemetryWindow window;
+    EXPECT_FALSE(window.enabled());
+    EXPECT_TRUE(window.empty());
+    EXPECT_FALSE(window.due());
+    EXPECT_TRUE(window.takePayloads().empty());
+}
+
+// Test that entries accumulate until the window elapses and come out as one array
+TEST(TelemetryWindowTest, FlushesOnceWindowElapses) {
+    TelemetryWindow window(std::chrono::seconds(60));
+    auto start = TelemetryWindow::Clock::now();
+
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_FALSE(window.add(makeEntry(1000 + i * 1000, 25.0 + i), start + std::chrono::seconds(i)));
+    }
+    EXPECT_EQ(window.entryCount(), 5u);
+    EXPECT_FALSE(window.due(start + std::chrono::seconds(59)));
+    EXPECT_TRUE(window.due(start + std::chrono::seconds(60)));
+
+    auto payloads = window.takePayloads();
+    ASSERT_EQ(payloads.size(), 1u);
+
+    auto array = nlohmann::json::parse(payloads[0]);
+    ASSERT_TRUE(array.is_array());
+    ASSERT_EQ(array.size(), 5u);
+    EXPECT_EQ(array[0]["ts"].get<long long>(), 1000);
+    EXPECT_EQ(array[4]["ts"].get<long long>(), 5000);
+    EXPECT_DOUBLE_EQ(array[4]["values"]["temperature_spot_1"].get<double>(), 29.0);
+
+    EXPECT_TRUE(window.empty());
+    EXPECT_FALSE(window.due(start + std::chrono::seconds(120)));
+}
+
+// Test that the byte limit splits a window into several valid arrays
+TEST(TelemetryWindowTest, SplitsAtByteLimit) {
+    const std::string entry = makeEntry(1700000000000LL, 42.5);
+    const size_t limit = 1024;
+    TelemetryWindow window(std::chrono::seconds(60), limit);
+    auto now = TelemetryWindow::Clock::now();
+
+    const size_t per_payload = (limit - 1) / (entry.size() + 1);
+    const size_t total = per_payload * 2 + 1;
+    bool became_due = false;
+    for (size_t i = 0; i < total; ++i) {
+        became_due = window.add(entry, now) || became_due;
+    }
+    // A full payload makes the window due before it elapses
+    EXPECT_TRUE(became_due);
+
+    auto payloads = window.takePayloads();
+    ASSERT_EQ(payloads.size(), 3u);
+
+    size_t entries = 0;
+    for (const auto& payload : payloads) {
+        EXPECT_LE(payload.size(), limit);
+        auto array = nlohmann::json::parse(payload);
+        ASSERT_TRUE(array.is_array());
+        entries += array.size();
+    }
+    EXPECT_EQ(entries, total);
+}
+
+// Test that an entry larger than the limit is still sent, alone
+TEST(TelemetryWindowTest, OversizedEntryGetsOwnPayload) {
+    TelemetryWindow window(std::chrono::seconds(60), 32);
+    auto now = TelemetryWindow::Clock::now();
+
+    window.add(makeEntry(1, 20.0), now);
+    window.add(makeEntry(2, 21.0), now);
+
+    auto payloads = window.takePayloads();
+    ASSERT_EQ(payloads.size(), 2u);
+    EXPECT_EQ(nlohmann::json::parse(payloads[0]).size(), 1u);
+    EXPECT_EQ(nlohmann::json::parse(payloads[1]).size(), 1u);
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include "mqtt/topic_router.h"
+#include <string>
+#include <vector>
+
+using thermal::TopicRouter;
+
+// Test that the first matching prefix wins and receives the topic suffix
+TEST(TopicRouterTest, DispatchesByPrefixInOrder) {
+    TopicRouter router;
+    std::vector<std::string> calls;
+    router.add("v1/devices/me/rpc/request/", [&calls](std::string_view suffix, std::string_view payload) {
+        calls.push_back("rpc:" + std::string(suffix) + ":" + std::string(payload));
+    });
+    router.add("v1/devices/me/attributes", [&calls](std::string_view suffix, std::string_view) {
+        calls.push_back("attributes:" + std::string(suffix));
+    });
+    router.add("v1/devices/me/", [&calls](std::string_view suffix, std::string_view) {
+        calls.push_back("device:" + std::string(suffix));
+    });
+    EXPECT_EQ(router.size(), 3u);
+
+    EXPECT_TRUE(router.dispatch("v1/devices/me/rpc/request/42", "{\"method\":\"x\"}"));
+    EXPECT_TRUE(router.dispatch("v1/devices/me/attributes/response/7", ""));
+    EXPECT_TRUE(router.dispatch("v1/devices/me/attributes", ""));
+    EXPECT_TRUE(router.dispatch("v1/devices/me/rpc/response/1", ""));
+    EXPECT_FALSE(router.dispatch("v1/gateway/rpc", ""));
+    EXPECT_FALSE(router.dispatch("v1/devices", ""));  // Shorter than every prefix
+
+    std::vector<std::string> expected = {
+        "rpc:42:{\"method\":\"x\"}", "attributes:/response/7", "attributes:", "device:rpc/response/1"};
+    EXPECT_EQ(calls, expected);
+}
+
+// Test that payloads are passed as views, including embedded NUL bytes
+TEST(TopicRouterTest, PassesBinaryPayloadsIntact) {
+    TopicRouter router;
+    const char raw[] = {'a', '\0', 'b'};
+    std::string_view received;
+    router.add("", [&received](std::string_view, std::string_view payload) { received = payload; });
+
+    EXPECT_TRUE(router.dispatch("any/topic", std::string_view(raw, sizeof(raw))));
+    EXPECT_EQ(received.data(), raw);
+    EXPECT_EQ(received.size(), 3u);
+}